@@ -1307,6 +1307,59 @@ typedef uint32_t SlangSizeT;
                  //   debug information: using it with `-g0`, or without any `-g` option (both
                  //   resolve to no debug info), is an error. Only affects SPIR-V output.
 
+        CompilationCacheDirectory =
+            158, // stringValue0: directory of an on-disk, content-addressed cache of generated
+                 //   target code. When set, `getEntryPointCode`/`getTargetCode` key each request
+                 //   on the digest of `getEntryPointHash` (compiler version, session and target
+                 //   options, module contents, specialization arguments and entry-point names)
+                 //   and the options of the program, and return the cached code and warnings on
+                 //   a hit without running lowering, the IR pass pipeline or emit. Asking for
+                 //   the metadata of a cached result compiles it. Source modules found through
+                 //   `import` are also kept there once checked, and reused while the module and
+                 //   every file it depended on are unchanged. Products of command line C/C++
+                 //   compilers (gcc, clang, Visual Studio), including host callable code, are
+                 //   kept there too, keyed on the compiler, its options, the source and included
+                 //   headers. This option is cache policy only and is excluded from compiler
+                 //   cache keys.
+        CompilationCacheMaxEntryCount =
+            159, // intValue0: maximum number of entries kept in the compilation cache before
+                 //   least-recently-used entries are evicted. 0 (the default) means no limit.
+
+        PerfTraceOutput =
+            160, // stringValue0: path of a Chrome Trace Event / Perfetto JSON file recording
+                 //   every profiled compiler section and IR pass with its thread and the
+                 //   module, entry point and target it ran for. Written when the compile request
+                 //   finishes or the session is released.
+        ReportPassStatistics =
+            161, // bool: record instruction counts and memory-arena allocation for each IR pass
+                 //   run during code generation, available from the target's `IMetadata` through
+                 //   `IPassStatisticsMetadata`. Target code is not cached while this is set.
+        LazyIRDeserialization =
+            162, // bool: when loading a precompiled module, only deserialize the IR of a
+                 //   function, generic or witness table when the linker first needs it, instead
+                 //   of deserializing the whole module up front.
+        CodeGenThreadCount =
+            163, // intValue0: number of threads a compile request generates target code on,
+                 //   counting the calling thread. Each entry point of each target is generated
+                 //   as a separate task, and diagnostics are reported in the same order as a
+                 //   serial compile. 0 or 1 (the default) generates code on the calling thread.
+        DownstreamPrecompiledHeaderDirectory =
+            164, // stringValue0: directory where downstream C/C++ compilers (gcc, clang) and
+                 //   NVRTC 12.8 or later keep a precompiled header for the prelude of generated
+                 //   source. The prelude is precompiled the first time it is used with a given
+                 //   compiler version and set of arguments, and every later compile of generated
+                 //   source reuses it instead of parsing the prelude again. Nothing is ever
+                 //   removed from the directory unless DownstreamPrecompiledHeaderMaxEntryCount
+                 //   is set.
+        SimplifyRevisitAllFunctions =
+            165, // bool: have each round of the IR simplification passes run the function-local
+                 //   passes on every function, instead of only on the functions that changed, or
+                 //   depend on something that changed, since the previous round. For testing.
+        DownstreamPrecompiledHeaderMaxEntryCount =
+            166, // intValue0: maximum number of precompiled preludes kept in the
+                 //   DownstreamPrecompiledHeaderDirectory before least-recently-used ones are
+                 //   removed. 0 (the default) means no limit.
+
         // Do not assign an explicit value to CountOf. It must remain one past the last option,
         // which it derives implicitly from the preceding (highest-valued) enumerator.
         CountOf,
@@ -5273,6 +5326,46 @@ struct ICooperativeTypesMetadata : public ISlangCastable
 };
     #define SLANG_UUID_ICooperativeTypesMetadata ICooperativeTypesMetadata::getTypeGuid()
 
+/// Size and allocation counters for one run of an IR pass on a compiled target.
+struct PassStatistics
+{
+    // Name of the pass. The string has static storage duration.
+    const char* passName = nullptr;
+    // Number of instructions (including decorations) in the module before and after the pass.
+    uint64_t instCountBefore = 0;
+    uint64_t instCountAfter = 0;
+    // Number of instructions the pass created and removed.
+    uint64_t instsCreated = 0;
+    uint64_t instsRemoved = 0;
+    // Bytes the pass allocated from the module's memory arena. Removing instructions does not
+    // return memory to the arena, so this counts everything the pass allocated. For `emitSPIRV`
+    // this also includes the peak memory of the SPIR-V emitter and the size of its output.
+    uint64_t bytesAllocated = 0;
+};
+
+/** Per-pass IR statistics.
+
+Recorded when `CompilerOptionName::ReportPassStatistics` is set. The list holds one entry for each
+IR pass run while linking, optimizing and legalizing the program for the target, in the order the
+passes ran; a pass that runs several times has one entry per run. Direct SPIR-V output adds a final
+`emitSPIRV` entry for the emitter. Without the option the list is empty.
+
+Cast from an `IMetadata*` using `castAs()`.
+*/
+struct IPassStatisticsMetadata : public ISlangCastable
+{
+    SLANG_COM_INTERFACE(
+        0xbc09c4e8,
+        0x1de1,
+        0x4635,
+        {0xaa, 0x7b, 0x95, 0x8f, 0xb2, 0x29, 0x77, 0x99})
+
+    virtual SLANG_NO_THROW SlangUInt SLANG_MCALL getPassStatisticsCount() = 0;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    getPassStatisticsByIndex(SlangUInt index, PassStatistics* outStatistics) = 0;
+};
+    #define SLANG_UUID_IPassStatisticsMetadata IPassStatisticsMetadata::getTypeGuid()
+
 /** Compile result for storing and retrieving multiple output blobs.
     This is needed for features such as separate debug compilation which
     output both base and debug spirv.
@@ -5747,6 +5840,62 @@ struct SpecializationArg
         return rs;
     }
 };
+
+/** One variant to compile with `IBatchCompileService_Experimental::compileBatch`.
+ */
+struct BatchCompileItem
+{
+    /** The entry point to compile. The module that defines it is linked in automatically. */
+    IEntryPoint* entryPoint = nullptr;
+    /** Arguments for the specialization parameters of the entry point, if it has any. */
+    SpecializationArg const* specializationArgs = nullptr;
+    SlangInt specializationArgCount = 0;
+    /** Index of the session target to generate code for. */
+    SlangInt targetIndex = 0;
+};
+
+struct BatchCompileDesc
+{
+    BatchCompileItem const* items = nullptr;
+    SlangInt itemCount = 0;
+    /** The number of threads to generate code on, counting the calling thread. 0 uses one
+     * thread per hardware thread. */
+    SlangInt threadCount = 0;
+};
+
+/* Experimental interface for compiling many entry point variants in one call, queried from
+an `ISession`. */
+struct IBatchCompileService_Experimental : public ISlangUnknown
+{
+    SLANG_COM_INTERFACE(
+        0x3b6f1c2e,
+        0x94d7,
+        0x4a58,
+        {0x8e, 0x21, 0xc5, 0x7d, 0x0a, 0x63, 0xf4, 0x19})
+
+    /** Compile every item of `desc`.
+     *
+     * Items with the same entry point and specialization arguments share a single specialized
+     * and linked program, so only the code generation for each target is repeated. Specializing
+     * and linking happen on the calling thread; code generation for all items is then spread
+     * over `desc.threadCount` threads.
+     *
+     * `outCodes` and `outResults` must have room for `desc.itemCount` entries, and receive the
+     * code and result for each item in order. `outDiagnostics` may be null, or likewise receive
+     * the diagnostics for each item, if there are any. Returned blobs are owned by the caller.
+     *
+     * Returns SLANG_OK if every item compiled, and otherwise the result of the first that
+     * failed.
+     */
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL compileBatch(
+        BatchCompileDesc const& desc,
+        IBlob** outCodes,
+        SlangResult* outResults,
+        IBlob** outDiagnostics = nullptr) = 0;
+};
+
+    #define SLANG_UUID_IBatchCompileService_Experimental \
+        IBatchCompileService_Experimental::getTypeGuid()
 } // namespace slang
 
     // Passed into functions to create globalSession to identify the API version client code is
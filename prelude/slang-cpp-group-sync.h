@@ -0,0 +1,320 @@
+#ifndef SLANG_PRELUDE_CPP_GROUP_SYNC_H
+#define SLANG_PRELUDE_CPP_GROUP_SYNC_H
+
+// Group barriers and `groupshared` memory for compute kernels on the CPU targets.
+//
+// A kernel that uses a group barrier or `groupshared` memory runs the threads of a group with
+// `_slang_group_run`, which gives each thread of the group a fiber of its own on the calling
+// thread. The fibers take turns: each one runs until it reaches `_slang_group_barrier` or
+// returns, then the next one that hasn't returned runs. Once all of them have had a turn they
+// are all waiting at the same barrier (or have returned), so the next round runs them past it.
+// As on the GPU, this relies on every thread of a group reaching the same barriers.
+//
+// `_slang_group_shared` provides the storage for a `groupshared` variable. Every thread of a
+// group asks for its variables in the same order, so the nth request of each thread gets the same
+// zeroed storage, which stays in place until the group is done.
+//
+// The fibers and storage are kept by the thread that runs the groups, and reused by the next
+// group it runs, up to `SLANG_PRELUDE_GROUP_FIBER_CACHE_COUNT` fibers. They are freed when the
+// thread exits. Groups can run on several threads at once.
+//
+// Generated code JIT compiled by slang-llvm can't use the system headers the implementation
+// needs, so it only gets the declarations, and slang-llvm provides the functions.
+
+typedef void (*SlangGroupThreadFunc)(void* context, uint32_t threadIndex);
+
+#ifdef SLANG_LLVM
+
+extern "C"
+{
+    void _slang_group_run(uint32_t threadCount, SlangGroupThreadFunc func, void* context);
+    void _slang_group_barrier();
+    void* _slang_group_shared(size_t size);
+}
+
+#else // SLANG_LLVM
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#if defined(__APPLE__)
+// The ucontext functions still work on macOS, but are deprecated, and only declared if
+// `_XOPEN_SOURCE` was defined before the first system header was included. The preludes define
+// it before anything else when `SLANG_PRELUDE_GROUP_SYNC` is defined; defining it here would be
+// too late.
+#if !defined(_XOPEN_SOURCE)
+#error "slang-cpp-group-sync.h needs _XOPEN_SOURCE defined before any system header on macOS"
+#endif
+#if defined(__clang__)
+#define SLANG_PRELUDE_UCONTEXT_BEGIN                                  \
+    _Pragma("clang diagnostic push")                                  \
+    _Pragma("clang diagnostic ignored \"-Wdeprecated-declarations\"")
+#define SLANG_PRELUDE_UCONTEXT_END _Pragma("clang diagnostic pop")
+#endif
+#endif
+#include <ucontext.h>
+#endif
+
+// Brackets the uses of the ucontext functions, to silence their deprecation on macOS.
+#ifndef SLANG_PRELUDE_UCONTEXT_BEGIN
+#define SLANG_PRELUDE_UCONTEXT_BEGIN
+#define SLANG_PRELUDE_UCONTEXT_END
+#endif
+
+// The size of the stack of each fiber. Local variables of a kernel live on it.
+#ifndef SLANG_PRELUDE_GROUP_FIBER_STACK_SIZE
+#define SLANG_PRELUDE_GROUP_FIBER_STACK_SIZE (256 * 1024)
+#endif
+
+// The most fibers a thread keeps for the next group once a group is done. A group with more
+// threads makes the rest again each time it runs.
+#ifndef SLANG_PRELUDE_GROUP_FIBER_CACHE_COUNT
+#define SLANG_PRELUDE_GROUP_FIBER_CACHE_COUNT 64
+#endif
+
+struct SlangGroupFiber
+{
+#if defined(_WIN32)
+    void* fiber;
+#else
+    ucontext_t context;
+    void* stack;
+#endif
+};
+
+static inline void _slang_group_freeFiber(SlangGroupFiber* fiber)
+{
+#if defined(_WIN32)
+    DeleteFiber(fiber->fiber);
+#else
+    free(fiber->stack);
+#endif
+    free(fiber);
+}
+
+struct SlangGroupState
+{
+    // Run when the thread exits.
+    ~SlangGroupState()
+    {
+        for (uint32_t i = 0; i < fiberCount; ++i)
+            _slang_group_freeFiber(fibers[i]);
+        for (uint32_t i = 0; i < sharedCapacity; ++i)
+            free(sharedBlocks[i]);
+        free(fibers);
+        free(isFinished);
+        free(sharedCursors);
+        free(sharedBlocks);
+        free(sharedSizes);
+    }
+
+    // The group being run
+    SlangGroupThreadFunc func;
+    void* context;
+    uint32_t currentThread;
+    bool isInFiber;
+
+    // Per thread of the group
+    bool* isFinished;
+    uint32_t* sharedCursors;
+    uint32_t threadCapacity;
+
+    // The fiber for each thread index, created as needed
+#if defined(_WIN32)
+    void* scheduler;
+#else
+    ucontext_t scheduler;
+#endif
+    SlangGroupFiber** fibers;
+    uint32_t fiberCount;
+
+    // Storage for the `groupshared` variables of the group
+    void** sharedBlocks;
+    size_t* sharedSizes;
+    uint32_t sharedCount;
+    uint32_t sharedCapacity;
+};
+
+static inline SlangGroupState* _slang_group_getState()
+{
+    // Zero initialized before any use
+    static thread_local SlangGroupState state;
+    return &state;
+}
+
+static inline void _slang_group_yield(SlangGroupState* state)
+{
+    state->isInFiber = false;
+#if defined(_WIN32)
+    SwitchToFiber(state->scheduler);
+#else
+    SLANG_PRELUDE_UCONTEXT_BEGIN
+    swapcontext(&state->fibers[state->currentThread]->context, &state->scheduler);
+    SLANG_PRELUDE_UCONTEXT_END
+#endif
+}
+
+// Each fiber runs the thread with its index, for every group that has that many threads.
+static inline void _slang_group_fiberMain()
+{
+    SlangGroupState* state = _slang_group_getState();
+    for (;;)
+    {
+        state->func(state->context, state->currentThread);
+        state->isFinished[state->currentThread] = true;
+        _slang_group_yield(state);
+    }
+}
+
+#if defined(_WIN32)
+static VOID CALLBACK _slang_group_fiberProc(LPVOID)
+{
+    _slang_group_fiberMain();
+}
+#endif
+
+static inline void _slang_group_addFiber(SlangGroupState* state)
+{
+    SlangGroupFiber* fiber = (SlangGroupFiber*)malloc(sizeof(SlangGroupFiber));
+#if defined(_WIN32)
+    fiber->fiber =
+        CreateFiberEx(0, SLANG_PRELUDE_GROUP_FIBER_STACK_SIZE, 0, &_slang_group_fiberProc, nullptr);
+#else
+    // Fibers are never moved once made, as a context may point into itself.
+    fiber->stack = malloc(SLANG_PRELUDE_GROUP_FIBER_STACK_SIZE);
+    SLANG_PRELUDE_UCONTEXT_BEGIN
+    getcontext(&fiber->context);
+    fiber->context.uc_stack.ss_sp = fiber->stack;
+    fiber->context.uc_stack.ss_size = SLANG_PRELUDE_GROUP_FIBER_STACK_SIZE;
+    fiber->context.uc_link = nullptr;
+    makecontext(&fiber->context, &_slang_group_fiberMain, 0);
+    SLANG_PRELUDE_UCONTEXT_END
+#endif
+    state->fibers[state->fiberCount++] = fiber;
+}
+
+static inline void _slang_group_switchToThread(SlangGroupState* state, uint32_t threadIndex)
+{
+    state->currentThread = threadIndex;
+    state->isInFiber = true;
+#if defined(_WIN32)
+    SwitchToFiber(state->fibers[threadIndex]->fiber);
+#else
+    SLANG_PRELUDE_UCONTEXT_BEGIN
+    swapcontext(&state->scheduler, &state->fibers[threadIndex]->context);
+    SLANG_PRELUDE_UCONTEXT_END
+#endif
+}
+
+static inline void _slang_group_run(uint32_t threadCount, SlangGroupThreadFunc func, void* context)
+{
+    SlangGroupState* state = _slang_group_getState();
+    if (threadCount > state->threadCapacity)
+    {
+        state->isFinished = (bool*)realloc(state->isFinished, threadCount * sizeof(bool));
+        state->sharedCursors =
+            (uint32_t*)realloc(state->sharedCursors, threadCount * sizeof(uint32_t));
+        state->fibers = (SlangGroupFiber**)realloc(
+            state->fibers,
+            threadCount * sizeof(SlangGroupFiber*));
+        state->threadCapacity = threadCount;
+    }
+    memset(state->isFinished, 0, threadCount * sizeof(bool));
+    memset(state->sharedCursors, 0, threadCount * sizeof(uint32_t));
+
+    state->func = func;
+    state->context = context;
+    state->currentThread = 0;
+    state->sharedCount = 0;
+
+    if (threadCount == 1)
+    {
+        // A barrier has no other threads to wait for, so the thread runs on the caller's stack.
+        func(context, 0);
+    }
+    else
+    {
+        while (state->fiberCount < threadCount)
+            _slang_group_addFiber(state);
+
+#if defined(_WIN32)
+        const bool wasFiber = IsThreadAFiber() != FALSE;
+        state->scheduler = wasFiber ? GetCurrentFiber() : ConvertThreadToFiber(nullptr);
+#endif
+
+        // Run every thread up to its next barrier, until they have all returned.
+        uint32_t remainingCount = threadCount;
+        while (remainingCount > 0)
+        {
+            for (uint32_t i = 0; i < threadCount; ++i)
+            {
+                if (state->isFinished[i])
+                    continue;
+                _slang_group_switchToThread(state, i);
+                if (state->isFinished[i])
+                    --remainingCount;
+            }
+        }
+
+#if defined(_WIN32)
+        if (!wasFiber)
+            ConvertFiberToThread();
+#endif
+
+        // The fibers beyond the limit are waiting for a group to run, so they can go.
+        while (state->fiberCount > SLANG_PRELUDE_GROUP_FIBER_CACHE_COUNT)
+            _slang_group_freeFiber(state->fibers[--state->fiberCount]);
+    }
+}
+
+static inline void _slang_group_barrier()
+{
+    // Outside of a fiber there are no other threads of the group to wait for.
+    SlangGroupState* state = _slang_group_getState();
+    if (state->isInFiber)
+        _slang_group_yield(state);
+}
+
+// Only called by the threads of a group run by `_slang_group_run`.
+static inline void* _slang_group_shared(size_t size)
+{
+    SlangGroupState* state = _slang_group_getState();
+    uint32_t& cursor = state->sharedCursors[state->currentThread];
+    if (cursor == state->sharedCount)
+    {
+        // The first thread to ask for this variable sets up the storage for the group.
+        if (state->sharedCount == state->sharedCapacity)
+        {
+            const uint32_t capacity = state->sharedCapacity ? state->sharedCapacity * 2 : 4;
+            state->sharedBlocks =
+                (void**)realloc(state->sharedBlocks, capacity * sizeof(void*));
+            state->sharedSizes = (size_t*)realloc(state->sharedSizes, capacity * sizeof(size_t));
+            for (uint32_t i = state->sharedCapacity; i < capacity; ++i)
+            {
+                state->sharedBlocks[i] = nullptr;
+                state->sharedSizes[i] = 0;
+            }
+            state->sharedCapacity = capacity;
+        }
+
+        const uint32_t index = state->sharedCount++;
+        if (state->sharedSizes[index] < size)
+        {
+            free(state->sharedBlocks[index]);
+            state->sharedBlocks[index] = malloc(size);
+            state->sharedSizes[index] = size;
+        }
+        memset(state->sharedBlocks[index], 0, size);
+    }
+    return state->sharedBlocks[cursor++];
+}
+
+#endif // SLANG_LLVM
+
+#endif // SLANG_PRELUDE_CPP_GROUP_SYNC_H
@@ -1,6 +1,19 @@
 #ifndef SLANG_CPP_HOST_PRELUDE_H
 #define SLANG_CPP_HOST_PRELUDE_H
 
+// The C++ emitter defines `SLANG_PRELUDE_GROUP_SYNC` before the prelude for code that uses group
+// barriers or `groupshared` storage, which needs `slang-cpp-group-sync.h`. The ucontext functions
+// it uses are only declared on macOS if XSI extensions are asked for before the first system header
+// is included.
+#if defined(SLANG_PRELUDE_GROUP_SYNC) && defined(__APPLE__) && !defined(SLANG_LLVM)
+#ifndef _XOPEN_SOURCE
+#define _XOPEN_SOURCE 600
+#endif
+#ifndef _DARWIN_C_SOURCE
+#define _DARWIN_C_SOURCE
+#endif
+#endif
+
 #include <cmath>
 #include <cstdio>
 #include <cstring>
@@ -55,6 +68,9 @@
 #define SLANG_PRELUDE_EXTERN_C_END
 #endif
 
+#ifdef SLANG_PRELUDE_GROUP_SYNC
+#include "slang-cpp-group-sync.h"
+#endif
 #include "slang-cpp-scalar-intrinsics.h"
 
 using namespace Slang;
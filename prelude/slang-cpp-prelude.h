@@ -1,6 +1,19 @@
 #ifndef SLANG_CPP_PRELUDE_H
 #define SLANG_CPP_PRELUDE_H
 
+// The C++ emitter defines `SLANG_PRELUDE_GROUP_SYNC` before the prelude for code that uses group
+// barriers or `groupshared` storage, which needs `slang-cpp-group-sync.h`. The ucontext functions
+// it uses are only declared on macOS if XSI extensions are asked for before the first system header
+// is included.
+#if defined(SLANG_PRELUDE_GROUP_SYNC) && defined(__APPLE__) && !defined(SLANG_LLVM)
+#ifndef _XOPEN_SOURCE
+#define _XOPEN_SOURCE 600
+#endif
+#ifndef _DARWIN_C_SOURCE
+#define _DARWIN_C_SOURCE
+#endif
+#endif
+
 // Because the signature of isnan, isfinite, and is isinf changed in C++, we use the macro
 // to use the version in the std namespace.
 // https://stackoverflow.com/questions/39130040/cmath-hides-isnan-in-math-h-in-c14-c11
@@ -318,6 +331,9 @@ public:
 
 // Includes
 
+#ifdef SLANG_PRELUDE_GROUP_SYNC
+#include "slang-cpp-group-sync.h"
+#endif
 #include "slang-cpp-scalar-intrinsics.h"
 #include "slang-cpp-types.h"
 
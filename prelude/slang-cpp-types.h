@@ -1345,6 +1345,15 @@ struct ComputeVaryingInput
     uint3 endGroupID;   ///< Non inclusive end groupID
 };
 
+// Passed to the function that runs a thread of a group with `_slang_group_run`, which adds the
+// decomposed thread index to the `groupThreadID` of `threadInput`.
+struct ComputeGroupThreadContext
+{
+    ComputeThreadVaryingInput threadInput;
+    void* entryPointParams;
+    void* globalParams;
+};
+
 // The uniformEntryPointParams and uniformState must be set to structures that match layout that the
 // kernel expects. This can be determined via reflection for example.
 
@@ -301,6 +301,8 @@ void* ArtifactPostEmitMetadata::getInterface(const Guid& guid)
     }
     if (guid == slang::ICooperativeTypesMetadata::getTypeGuid())
         return static_cast<slang::ICooperativeTypesMetadata*>(this);
+    if (guid == slang::IPassStatisticsMetadata::getTypeGuid())
+        return static_cast<slang::IPassStatisticsMetadata*>(this);
     return nullptr;
 }
 
@@ -601,5 +603,24 @@ SlangResult ArtifactPostEmitMetadata::getCooperativeVectorCombinationByIndex(
     return SLANG_OK;
 }
 
+SlangUInt ArtifactPostEmitMetadata::getPassStatisticsCount()
+{
+    return SlangUInt(m_passStatistics.getCount());
+}
+
+SlangResult ArtifactPostEmitMetadata::getPassStatisticsByIndex(
+    SlangUInt index,
+    slang::PassStatistics* outStatistics)
+{
+    if (!outStatistics)
+        return SLANG_E_INVALID_ARG;
+
+    if (index >= SlangUInt(m_passStatistics.getCount()))
+        return SLANG_E_INVALID_ARG;
+
+    *outStatistics = m_passStatistics[Index(index)];
+    return SLANG_OK;
+}
+
 
 } // namespace Slang
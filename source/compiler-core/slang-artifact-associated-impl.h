@@ -223,7 +223,8 @@ class ArtifactPostEmitMetadata : public ComBaseObject,
                                  public slang::IBindlessResourceMetadata,
                                  public slang::ICoverageTracingMetadata,
                                  public slang::ISyntheticResourceMetadata,
-                                 public slang::ICooperativeTypesMetadata
+                                 public slang::ICooperativeTypesMetadata,
+                                 public slang::IPassStatisticsMetadata
 {
 public:
     typedef ArtifactPostEmitMetadata ThisType;
@@ -288,6 +289,11 @@ public:
         SlangUInt index,
         slang::CooperativeVectorCombination* outCombination) SLANG_OVERRIDE;
 
+    // IPassStatisticsMetadata
+    SLANG_NO_THROW virtual SlangUInt SLANG_MCALL getPassStatisticsCount() SLANG_OVERRIDE;
+    SLANG_NO_THROW virtual SlangResult SLANG_MCALL
+    getPassStatisticsByIndex(SlangUInt index, slang::PassStatistics* outStatistics) SLANG_OVERRIDE;
+
     void* getInterface(const Guid& uuid);
     void* getObject(const Guid& uuid);
 
@@ -302,6 +308,7 @@ public:
     List<slang::CooperativeMatrixCombination> m_cooperativeMatrixCombinations;
     List<slang::CooperativeVectorTypeUsageInfo> m_cooperativeVectorTypes;
     List<slang::CooperativeVectorCombination> m_cooperativeVectorCombinations;
+    List<slang::PassStatistics> m_passStatistics;
     String m_debugBuildIdentifier;
     bool m_usesBindlessResourceHeap = false;
 
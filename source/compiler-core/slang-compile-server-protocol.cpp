@@ -0,0 +1,109 @@
+#include "slang-compile-server-protocol.h"
+
+namespace CompileServerProtocol
+{
+
+static const StructRttiInfo _makeCompileArgsRtti()
+{
+    CompileArgs obj;
+    StructRttiBuilder builder(&obj, "CompileServerProtocol::CompileArgs", nullptr);
+    builder.addField("currentPath", &obj.currentPath);
+    builder.addField("args", &obj.args);
+    builder.addField("environment", &obj.environment);
+    builder.addField("stdOutIsConsole", &obj.stdOutIsConsole);
+    builder.addField("stdErrorIsConsole", &obj.stdErrorIsConsole);
+    return builder.make();
+}
+/* static */ const StructRttiInfo CompileArgs::g_rttiInfo = _makeCompileArgsRtti();
+/* static */ const UnownedStringSlice CompileArgs::g_methodName =
+    UnownedStringSlice::fromLiteral("compile");
+
+static const StructRttiInfo _makeCompileResultRtti()
+{
+    CompileResult obj;
+    StructRttiBuilder builder(&obj, "CompileServerProtocol::CompileResult", nullptr);
+    builder.addField("stdOut", &obj.stdOut);
+    builder.addField("stdError", &obj.stdError);
+    builder.addField("stdOutIsBinary", &obj.stdOutIsBinary);
+    builder.addField("result", &obj.result);
+    builder.addField("returnCode", &obj.returnCode);
+    return builder.make();
+}
+/* static */ const StructRttiInfo CompileResult::g_rttiInfo = _makeCompileResultRtti();
+
+static const char kBase64Chars[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+String encodeBase64(const void* data, size_t size)
+{
+    const auto bytes = (const uint8_t*)data;
+    StringBuilder builder;
+    for (size_t i = 0; i < size; i += 3)
+    {
+        const size_t count = (size - i < 3) ? size - i : 3;
+        uint32_t group = uint32_t(bytes[i]) << 16;
+        if (count > 1)
+            group |= uint32_t(bytes[i + 1]) << 8;
+        if (count > 2)
+            group |= uint32_t(bytes[i + 2]);
+
+        builder.appendChar(kBase64Chars[(group >> 18) & 0x3f]);
+        builder.appendChar(kBase64Chars[(group >> 12) & 0x3f]);
+        builder.appendChar(count > 1 ? kBase64Chars[(group >> 6) & 0x3f] : '=');
+        builder.appendChar(count > 2 ? kBase64Chars[group & 0x3f] : '=');
+    }
+    return builder.produceString();
+}
+
+static int _decodeBase64Char(char c)
+{
+    if (c >= 'A' && c <= 'Z')
+        return c - 'A';
+    if (c >= 'a' && c <= 'z')
+        return c - 'a' + 26;
+    if (c >= '0' && c <= '9')
+        return c - '0' + 52;
+    if (c == '+')
+        return 62;
+    if (c == '/')
+        return 63;
+    return -1;
+}
+
+SlangResult decodeBase64(const UnownedStringSlice& text, StringBuilder& out)
+{
+    const Index length = text.getLength();
+    if (length % 4 != 0)
+        return SLANG_FAIL;
+
+    for (Index i = 0; i < length; i += 4)
+    {
+        // Only the last group can be padded.
+        const bool isLast = (i + 4 == length);
+        const Index padCount = isLast ? (text[i + 3] == '=') + (text[i + 2] == '=') : 0;
+        if (padCount == 1 && text[i + 2] == '=')
+            return SLANG_FAIL;
+
+        uint32_t group = 0;
+        for (Index j = 0; j < 4; ++j)
+        {
+            int value = 0;
+            if (j < 4 - padCount)
+            {
+                value = _decodeBase64Char(text[i + j]);
+                if (value < 0)
+                    return SLANG_FAIL;
+            }
+            group = (group << 6) | uint32_t(value);
+        }
+
+        out.appendChar(char(group >> 16));
+        if (padCount < 2)
+            out.appendChar(char((group >> 8) & 0xff));
+        if (padCount < 1)
+            out.appendChar(char(group & 0xff));
+    }
+    return SLANG_OK;
+}
+
+} // namespace CompileServerProtocol
@@ -0,0 +1,53 @@
+#ifndef SLANG_COMPILER_CORE_COMPILE_SERVER_PROTOCOL_H
+#define SLANG_COMPILER_CORE_COMPILE_SERVER_PROTOCOL_H
+
+#include "core/slang-rtti-info.h"
+#include "slang-json-value.h"
+#include "slang.h"
+
+/* JSON-RPC methods used between `slangc -compile-server` and the slangc clients that submit
+command lines to it. A client connects, makes a single call and reads the reply. */
+namespace CompileServerProtocol
+{
+
+using namespace Slang;
+
+struct CompileArgs
+{
+    String currentPath; ///< The client's working directory. Relative paths in args are against it
+    List<String> args;  ///< The command line, without the executable name
+
+    /// The client's environment, each variable as "NAME=VALUE". The server compiles in it.
+    List<String> environment;
+
+    /// If the client's stdout and stderr are consoles, which changes how output is written to them.
+    bool stdOutIsConsole = false;
+    bool stdErrorIsConsole = false;
+
+    static const UnownedStringSlice g_methodName;
+    static const StructRttiInfo g_rttiInfo;
+};
+
+struct CompileResult
+{
+    /// Base64 encoded, as a kernel written to stdout may be binary.
+    String stdOut;
+    /// If the compile switched stdout to binary mode, which the client then does too.
+    bool stdOutIsBinary = false;
+
+    String stdError;
+    int32_t result = SLANG_OK;
+    int32_t returnCode = 0; ///< What slangc would return if the command line was run locally
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+/// Encode `size` bytes at `data` as base64.
+String encodeBase64(const void* data, size_t size);
+
+/// Decode base64 `text`, appending the bytes to `out`.
+SlangResult decodeBase64(const UnownedStringSlice& text, StringBuilder& out);
+
+} // namespace CompileServerProtocol
+
+#endif // SLANG_COMPILER_CORE_COMPILE_SERVER_PROTOCOL_H
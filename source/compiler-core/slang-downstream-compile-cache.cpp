@@ -0,0 +1,421 @@
+// slang-downstream-compile-cache.cpp
+#include "slang-downstream-compile-cache.h"
+
+#include "core/slang-blob.h"
+#include "core/slang-castable.h"
+#include "core/slang-char-util.h"
+#include "core/slang-dictionary.h"
+#include "core/slang-string-util.h"
+#include "slang-artifact-desc-util.h"
+#include "slang-artifact-representation.h"
+#include "slang-artifact-util.h"
+#include "slang-slice-allocator.h"
+
+namespace Slang
+{
+
+namespace
+{ // anonymous
+
+typedef DigestBuilder<SHA1> Builder;
+
+// Bump when the contents of a key or of an entry change, so that older entries are not used.
+static const uint32_t kCacheFormatVersion = 1;
+
+// Strings are appended with their length, so that consecutive strings can't run into each other.
+static void _append(Builder& builder, const UnownedStringSlice& slice)
+{
+    builder.append(uint64_t(slice.getLength()));
+    builder.append(slice);
+}
+
+static void _append(Builder& builder, const TerminatedCharSlice& slice)
+{
+    _append(builder, asStringSlice(slice));
+}
+
+static void _append(Builder& builder, const Slice<TerminatedCharSlice>& slices)
+{
+    builder.append(uint64_t(slices.count));
+    for (const auto& slice : slices)
+        _append(builder, slice);
+}
+
+static SlangResult _appendContents(Builder& builder, IArtifact* artifact)
+{
+    ComPtr<ISlangBlob> blob;
+    SLANG_RETURN_ON_FAIL(artifact->loadBlob(ArtifactKeep::Yes, blob.writeRef()));
+    builder.append(uint64_t(blob->getBufferSize()));
+    builder.append(blob);
+    return SLANG_OK;
+}
+
+/// An `#include` line.
+struct Include
+{
+    UnownedStringSlice name;
+    /// True for `#include "name"`, which is looked for next to the including file first.
+    bool isQuoted;
+};
+
+/// What is found while appending the headers that sources include.
+struct IncludeScan
+{
+    /// The paths of the headers appended so far.
+    HashSet<String> visitedPaths;
+    /// The names of the macros given to `#include`.
+    List<String> macroNames;
+    /// The names of the macros that the sources and headers `#define`.
+    HashSet<String> definedNames;
+};
+
+static UnownedStringSlice _getIdentifier(const UnownedStringSlice& text)
+{
+    Index length = 0;
+    while (length < text.getLength() &&
+           (CharUtil::isAlphaOrDigit(text[length]) || text[length] == '_'))
+        length++;
+    return text.head(length);
+}
+
+/// Find the headers included by `text`, and the macros it defines.
+///
+/// Every `#include` line is found, even those in blocks that the preprocessor would skip, which
+/// can only add to what the key depends on. Fails if an `#include` line names no header, as with
+/// `#include_next`, since which header it includes can't be told from the line.
+static SlangResult _findIncludes(
+    const UnownedStringSlice& text,
+    List<Include>& outIncludes,
+    IncludeScan& ioScan)
+{
+    for (auto line : LineParser(text))
+    {
+        line = line.trimStart();
+        if (!line.startsWith("#"))
+            continue;
+        line = line.tail(1).trimStart();
+
+        const auto directive = _getIdentifier(line);
+        line = line.tail(directive.getLength()).trimStart();
+        if (directive == "define")
+        {
+            ioScan.definedNames.add(String(_getIdentifier(line)));
+            continue;
+        }
+        if (!directive.startsWith("include"))
+            continue;
+        if (directive != "include")
+            return SLANG_E_NOT_AVAILABLE;
+
+        if (line.getLength() == 0)
+            return SLANG_E_NOT_AVAILABLE;
+        if (line[0] != '"' && line[0] != '<')
+        {
+            // `#include MACRO`, which is only cacheable if nothing defines the macro.
+            const auto macroName = _getIdentifier(line);
+            if (macroName.getLength() == 0)
+                return SLANG_E_NOT_AVAILABLE;
+            ioScan.macroNames.add(String(macroName));
+            continue;
+        }
+
+        const char close = (line[0] == '"') ? '"' : '>';
+        line = line.tail(1);
+        const Index end = line.indexOf(close);
+        if (end <= 0)
+            return SLANG_E_NOT_AVAILABLE;
+        outIncludes.add(Include{line.head(end), close == '"'});
+    }
+    return SLANG_OK;
+}
+
+/// Append the contents of the headers that `text` includes, and of the headers they include.
+///
+/// A header is looked for as the compiler does, in `directory` (the directory of the file that
+/// includes it) for a quoted name, and then on the include paths. A header that isn't found is
+/// taken to be a system header, which is identified by the compiler. That includes quoted names,
+/// as the compiler goes on to look for them where it looks for `<...>` headers, and system headers
+/// such as `"TargetConditionals.h"` are included that way.
+static SlangResult _appendIncludes(
+    Builder& builder,
+    const UnownedStringSlice& text,
+    const String& directory,
+    const Slice<TerminatedCharSlice>& includePaths,
+    IncludeScan& ioScan)
+{
+    List<Include> includes;
+    SLANG_RETURN_ON_FAIL(_findIncludes(text, includes, ioScan));
+
+    for (const auto& include : includes)
+    {
+        _append(builder, include.name);
+
+        List<String> candidatePaths;
+        if (include.isQuoted && directory.getLength())
+            candidatePaths.add(Path::combine(directory, String(include.name)));
+        for (const auto& includePath : includePaths)
+            candidatePaths.add(Path::combine(asString(includePath), String(include.name)));
+
+        String foundPath;
+        for (const auto& path : candidatePaths)
+        {
+            if (File::exists(path))
+            {
+                foundPath = path;
+                break;
+            }
+        }
+
+        if (foundPath.getLength() == 0)
+            continue;
+
+        // Which header was found is part of the key, as a header that was already seen is only
+        // identified by its path.
+        _append(builder, foundPath.getUnownedSlice());
+        if (!ioScan.visitedPaths.add(foundPath))
+            continue;
+
+        String contents;
+        SLANG_RETURN_ON_FAIL(File::readAllText(foundPath, contents));
+        _append(builder, contents.getUnownedSlice());
+        SLANG_RETURN_ON_FAIL(_appendIncludes(
+            builder,
+            contents.getUnownedSlice(),
+            Path::getParentDirectory(foundPath),
+            includePaths,
+            ioScan));
+    }
+    return SLANG_OK;
+}
+
+/// Get the directory of the file the compiler will be given for `artifact`, or an empty string if
+/// the source is only in memory and has to be written to a temporary file.
+static String _getSourceDirectory(IArtifact* artifact)
+{
+    for (auto rep : artifact->getRepresentations())
+    {
+        auto pathRep = as<IPathArtifactRepresentation>(rep);
+        if (pathRep && pathRep->getPathType() == SLANG_PATH_TYPE_FILE && pathRep->exists())
+            return Path::getParentDirectory(pathRep->getPath());
+    }
+    return String();
+}
+
+/// True if `name` is defined by the options or the command line, or is `#define`d by a source or
+/// header that was scanned.
+static bool _isDefined(
+    const UnownedStringSlice& name,
+    const CommandLine& cmdLine,
+    const DownstreamCompileOptions& options,
+    const IncludeScan& scan)
+{
+    if (scan.definedNames.contains(String(name)))
+        return true;
+    for (const auto& define : options.defines)
+    {
+        if (_getIdentifier(asStringSlice(define.nameWithSig)) == name)
+            return true;
+    }
+
+    // A `-D` (or `/D`) argument, as the compiler is given it or by the caller.
+    List<UnownedStringSlice> args;
+    for (const auto& arg : cmdLine.m_args)
+        args.add(arg.getUnownedSlice());
+    for (const auto& arg : options.compilerSpecificArguments)
+        args.add(asStringSlice(arg));
+    for (const auto& arg : args)
+    {
+        if (arg.getLength() > 2 && (arg[0] == '-' || arg[0] == '/') && arg[1] == 'D' &&
+            _getIdentifier(arg.tail(2)) == name)
+            return true;
+    }
+    return false;
+}
+
+/// The header an `#include MACRO` line includes can't be known without preprocessing. The line can
+/// only be ignored if nothing defines the macro, as in `#ifdef MACRO` blocks that are skipped.
+static SlangResult _checkMacroIncludes(
+    const CommandLine& cmdLine,
+    const DownstreamCompileOptions& options,
+    const IncludeScan& scan)
+{
+    for (const auto& macroName : scan.macroNames)
+    {
+        if (_isDefined(macroName.getUnownedSlice(), cmdLine, options, scan))
+            return SLANG_E_NOT_AVAILABLE;
+    }
+    return SLANG_OK;
+}
+
+} // namespace
+
+/* static */ bool DownstreamCompileCacheUtil::canCache(const CompileOptions& options)
+{
+    // Products written to a path given by the caller are expected to be found there. An
+    // executable taken from the cache would have to be given permission to run again.
+    if (options.modulePath.count)
+        return false;
+
+    const auto desc = ArtifactDescUtil::makeDescForCompileTarget(options.targetType);
+    return desc.kind != ArtifactKind::Executable;
+}
+
+/* static */ SlangResult DownstreamCompileCacheUtil::calcKey(
+    const DownstreamCompilerDesc& desc,
+    const CommandLine& cmdLine,
+    const CompileOptions& options,
+    Key& outKey)
+{
+    Builder builder;
+
+    _append(builder, toSlice("downstream-compile"));
+    builder.append(kCacheFormatVersion);
+
+    // The compiler
+    builder.append(desc.type);
+    builder.append(desc.version.m_major);
+    builder.append(desc.version.m_minor);
+    builder.append(desc.version.m_patch);
+    builder.append(cmdLine.m_executableLocation.m_type);
+    _append(builder, cmdLine.m_executableLocation.m_pathOrName.getUnownedSlice());
+    builder.append(uint64_t(cmdLine.m_args.getCount()));
+    for (const auto& arg : cmdLine.m_args)
+        _append(builder, arg.getUnownedSlice());
+
+    // The options, apart from the module path, which is not set for a compile that can be cached.
+    builder.append(options.optimizationLevel);
+    builder.append(options.debugInfoType);
+    builder.append(options.targetType);
+    builder.append(options.sourceLanguage);
+    builder.append(options.floatingPointMode);
+    builder.append(options.pipelineType);
+    builder.append(options.matrixLayout);
+    builder.append(options.flags);
+    builder.append(options.platform);
+    builder.append(options.enablePAQ);
+    builder.append(options.stage);
+    builder.append(options.metalLanguageVersion.m_major);
+    builder.append(options.metalLanguageVersion.m_minor);
+    builder.append(options.metalLanguageVersion.m_patch);
+    builder.append(options.m_debugInfoFormat);
+    builder.append(options.denormalModeFp16);
+    builder.append(options.denormalModeFp32);
+    builder.append(options.denormalModeFp64);
+
+    builder.append(uint64_t(options.defines.count));
+    for (const auto& define : options.defines)
+    {
+        _append(builder, define.nameWithSig);
+        _append(builder, define.value);
+    }
+
+    builder.append(uint64_t(options.requiredCapabilityVersions.count));
+    for (const auto& capabilityVersion : options.requiredCapabilityVersions)
+    {
+        builder.append(capabilityVersion.kind);
+        builder.append(capabilityVersion.version.m_major);
+        builder.append(capabilityVersion.version.m_minor);
+        builder.append(capabilityVersion.version.m_patch);
+    }
+
+    _append(builder, options.entryPointName);
+    _append(builder, options.profileName);
+    _append(builder, options.includePaths);
+    _append(builder, options.libraryPaths);
+    _append(builder, options.compilerSpecificArguments);
+
+    builder.append(uint64_t(options.libraries.count));
+    for (auto library : options.libraries)
+        SLANG_RETURN_ON_FAIL(_appendContents(builder, library));
+
+    // The source, which for C and C++ includes the prelude, and the headers it includes.
+    IncludeScan scan;
+    builder.append(uint64_t(options.sourceArtifacts.count));
+    for (auto sourceArtifact : options.sourceArtifacts)
+    {
+        ComPtr<ISlangBlob> blob;
+        SLANG_RETURN_ON_FAIL(sourceArtifact->loadBlob(ArtifactKeep::Yes, blob.writeRef()));
+        const auto text = StringUtil::getSlice(blob);
+        _append(builder, text);
+        SLANG_RETURN_ON_FAIL(_appendIncludes(
+            builder,
+            text,
+            _getSourceDirectory(sourceArtifact),
+            options.includePaths,
+            scan));
+    }
+    SLANG_RETURN_ON_FAIL(_checkMacroIncludes(cmdLine, options, scan));
+
+    outKey = builder.finalize();
+    return SLANG_OK;
+}
+
+/* static */ SlangResult DownstreamCompileCacheUtil::appendIncludes(
+    DigestBuilder<SHA1>& builder,
+    const UnownedStringSlice& text,
+    const String& directory,
+    const CommandLine& cmdLine,
+    const CompileOptions& options)
+{
+    IncludeScan scan;
+    SLANG_RETURN_ON_FAIL(_appendIncludes(builder, text, directory, options.includePaths, scan));
+    return _checkMacroIncludes(cmdLine, options, scan);
+}
+
+/* An entry holds the standard output and standard error of the compiler, each preceded by its size
+as a uint32_t, followed by the product. */
+
+/* static */ SlangResult DownstreamCompileCacheUtil::readEntry(
+    PersistentCache* cache,
+    const Key& key,
+    ExecuteResult& outExeResult,
+    ComPtr<ISlangBlob>& outProduct)
+{
+    ComPtr<ISlangBlob> blob;
+    SLANG_RETURN_ON_FAIL(cache->readEntry(key, blob.writeRef()));
+
+    const char* cur = (const char*)blob->getBufferPointer();
+    const char* end = cur + blob->getBufferSize();
+
+    String* outputs[] = {&outExeResult.standardOutput, &outExeResult.standardError};
+    for (auto output : outputs)
+    {
+        uint32_t size;
+        if (size_t(end - cur) < sizeof(size))
+            return SLANG_FAIL;
+        ::memcpy(&size, cur, sizeof(size));
+        cur += sizeof(size);
+
+        if (size_t(end - cur) < size)
+            return SLANG_FAIL;
+        *output = UnownedStringSlice(cur, size);
+        cur += size;
+    }
+    outExeResult.resultCode = 0;
+
+    outProduct = RawBlob::create(cur, size_t(end - cur));
+    return outProduct ? SLANG_OK : SLANG_E_OUT_OF_MEMORY;
+}
+
+/* static */ SlangResult DownstreamCompileCacheUtil::writeEntry(
+    PersistentCache* cache,
+    const Key& key,
+    const ExecuteResult& exeResult,
+    ISlangBlob* product)
+{
+    List<uint8_t> data;
+
+    const String* outputs[] = {&exeResult.standardOutput, &exeResult.standardError};
+    for (auto output : outputs)
+    {
+        const uint32_t size = uint32_t(output->getLength());
+        data.addRange((const uint8_t*)&size, sizeof(size));
+        data.addRange((const uint8_t*)output->getBuffer(), size);
+    }
+    data.addRange((const uint8_t*)product->getBufferPointer(), Index(product->getBufferSize()));
+
+    auto blob = ListBlob::moveCreate(data);
+    return cache->writeEntry(key, blob);
+}
+
+} // namespace Slang
@@ -0,0 +1,67 @@
+#ifndef SLANG_DOWNSTREAM_COMPILE_CACHE_H
+#define SLANG_DOWNSTREAM_COMPILE_CACHE_H
+
+#include "core/slang-persistent-cache.h"
+#include "core/slang-process-util.h"
+#include "slang-downstream-compiler.h"
+
+namespace Slang
+{
+
+/* Caches the products of command line downstream compilers (such as gcc, clang and visual studio)
+in a PersistentCache, in the manner of ccache.
+
+A compile is identified by the compiler (its type, version and executable), the options it is
+given, and the contents of its source and of the headers it includes. Headers are looked for as the
+compiler looks for them, next to the including file for `#include "..."` and then on the include
+paths. A header that isn't found there, quoted or not, is taken to be a system header, which is
+identified by the compiler. A compile that includes through a macro that may be defined can't be
+identified, and so isn't cached. The output of the
+compiler is kept with the product, so that its diagnostics can be reproduced when the product is
+taken from the cache. */
+struct DownstreamCompileCacheUtil
+{
+    typedef DownstreamCompileOptions CompileOptions;
+    typedef PersistentCache::Key Key;
+
+    /// True if the product of a compile with `options` can be taken from the cache.
+    static bool canCache(const CompileOptions& options);
+
+    /// Calculate the key for a compile with `options` by the compiler described by `desc` and run
+    /// with `cmdLine`. Fails if the contents of the source or libraries can't be found, or the
+    /// headers the source includes can't be told from its text.
+    static SlangResult calcKey(
+        const DownstreamCompilerDesc& desc,
+        const CommandLine& cmdLine,
+        const CompileOptions& options,
+        Key& outKey);
+
+    /// Append the contents of the headers that `text` includes, and of the headers they include,
+    /// to `builder`, as `calcKey` does for a source. Quoted headers are looked for in `directory`
+    /// first. Fails if the headers can't be told from `text`.
+    static SlangResult appendIncludes(
+        DigestBuilder<SHA1>& builder,
+        const UnownedStringSlice& text,
+        const String& directory,
+        const CommandLine& cmdLine,
+        const CompileOptions& options);
+
+    /// Read the product and the compiler output of a compile from the cache.
+    /// Returns SLANG_E_NOT_FOUND if the compile is not in the cache.
+    static SlangResult readEntry(
+        PersistentCache* cache,
+        const Key& key,
+        ExecuteResult& outExeResult,
+        ComPtr<ISlangBlob>& outProduct);
+
+    /// Write the product and the compiler output of a compile to the cache.
+    static SlangResult writeEntry(
+        PersistentCache* cache,
+        const Key& key,
+        const ExecuteResult& exeResult,
+        ISlangBlob* product);
+};
+
+} // namespace Slang
+
+#endif
@@ -16,6 +16,7 @@
 #include "slang-artifact-representation-impl.h"
 #include "slang-artifact-util.h"
 #include "slang-com-helper.h"
+#include "slang-downstream-compile-cache.h"
 
 namespace Slang
 {
@@ -80,6 +81,70 @@ SlangResult CommandLineDownstreamCompiler::compile(
     }
 
     CompileOptions options = getCompatibleVersion(&inOptions);
+
+    PersistentCache* cache = nullptr;
+    PersistentCache::Key cacheKey;
+    const SlangResult cacheRes = _findCachedProduct(options, cache, cacheKey, outArtifact);
+    if (cacheRes != SLANG_E_NOT_FOUND)
+        return cacheRes;
+
+    return _runCompiler(options, cache, cacheKey, outArtifact);
+}
+
+SlangResult CommandLineDownstreamCompiler::_findCachedProduct(
+    const CompileOptions& options,
+    PersistentCache*& outCache,
+    PersistentCache::Key& outCacheKey,
+    IArtifact** outArtifact)
+{
+    // If the same compile has been done before, its product can be taken from the cache without
+    // running the compiler.
+    outCache = DownstreamCompileCacheUtil::canCache(options) ? options.compileCache : nullptr;
+    if (outCache &&
+        SLANG_FAILED(DownstreamCompileCacheUtil::calcKey(m_desc, m_cmdLine, options, outCacheKey)))
+    {
+        outCache = nullptr;
+    }
+    if (!outCache)
+        return SLANG_E_NOT_FOUND;
+
+    ExecuteResult cachedExeRes;
+    ComPtr<ISlangBlob> cachedProduct;
+    if (SLANG_FAILED(DownstreamCompileCacheUtil::readEntry(
+            outCache,
+            outCacheKey,
+            cachedExeRes,
+            cachedProduct)))
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    const auto targetDesc = ArtifactDescUtil::makeDescForCompileTarget(options.targetType);
+    auto resultArtifact = ArtifactUtil::createArtifact(targetDesc);
+    auto diagnostics = ArtifactDiagnostics::create();
+    ArtifactUtil::addAssociated(resultArtifact, diagnostics);
+
+    // The compiler output is parsed again for the diagnostics.
+    SlangResult parseRes = parseOutput(cachedExeRes, diagnostics);
+    if (SLANG_FAILED(parseRes))
+    {
+        diagnostics->setResult(parseRes);
+        *outArtifact = resultArtifact.detach();
+        return parseRes;
+    }
+
+    resultArtifact->addRepresentationUnknown(cachedProduct);
+    *outArtifact = resultArtifact.detach();
+    return SLANG_OK;
+}
+
+SlangResult CommandLineDownstreamCompiler::_runCompiler(
+    const CompileOptions& inOptions,
+    PersistentCache* cache,
+    const PersistentCache::Key& cacheKey,
+    IArtifact** outArtifact)
+{
+    CompileOptions options = inOptions;
     const auto targetDesc = ArtifactDescUtil::makeDescForCompileTarget(options.targetType);
 
     // Create the result artifact and diagnostics early so every error path can return them.
@@ -269,6 +334,17 @@ SlangResult CommandLineDownstreamCompiler::compile(
         resultArtifact->addRepresentation(fileRep);
     }
 
+    // Only a product made without errors is added to the cache.
+    if (cache && productArtifact && exeRes.resultCode == 0 &&
+        SLANG_SUCCEEDED(diagnostics->getResult()))
+    {
+        ComPtr<ISlangBlob> product;
+        if (SLANG_SUCCEEDED(productArtifact->loadBlob(ArtifactKeep::Yes, product.writeRef())))
+        {
+            DownstreamCompileCacheUtil::writeEntry(cache, cacheKey, exeRes, product);
+        }
+    }
+
     // Add the artifact list if there is anything in it
     if (artifactList.getCount())
     {
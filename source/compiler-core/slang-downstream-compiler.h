@@ -3,6 +3,7 @@
 
 #include "core/slang-common.h"
 #include "core/slang-io.h"
+#include "core/slang-persistent-cache.h"
 #include "core/slang-platform.h"
 #include "core/slang-process-util.h"
 #include "core/slang-semantic-version.h"
@@ -298,6 +299,19 @@ struct DownstreamCompileOptions
     FloatingPointDenormalMode denormalModeFp16 = FloatingPointDenormalMode::Any;
     FloatingPointDenormalMode denormalModeFp32 = FloatingPointDenormalMode::Any;
     FloatingPointDenormalMode denormalModeFp64 = FloatingPointDenormalMode::Any;
+
+    /// If set, command line compilers take products from this cache instead of compiling again,
+    /// and add the products of their compiles to it. Other compilers ignore it.
+    PersistentCache* compileCache = nullptr;
+
+    /// The prelude that the source starts with. If `precompiledHeaderDirectory` is also set,
+    /// compilers that support precompiled headers precompile the prelude once into that directory,
+    /// and compile the rest of the source against it. If `precompiledHeaderMaxEntryCount` isn't 0,
+    /// the least recently used precompiled preludes are removed from the directory beyond that
+    /// many; otherwise nothing is ever removed from it.
+    TerminatedCharSlice prelude;
+    TerminatedCharSlice precompiledHeaderDirectory;
+    Count precompiledHeaderMaxEntryCount = 0;
 };
 static_assert(std::is_trivially_copyable_v<DownstreamCompileOptions>);
 
@@ -493,6 +507,25 @@ public:
     }
 
     CommandLine m_cmdLine;
+
+protected:
+    /// Take the product of a compile with `options` from its compile cache. Outputs the cache that
+    /// the product is to be added to once it is compiled, which is null if the compile can't be
+    /// cached, and the key to add it with. Returns SLANG_E_NOT_FOUND, without writing
+    /// `outArtifact`, if the product isn't in the cache.
+    SlangResult _findCachedProduct(
+        const CompileOptions& options,
+        PersistentCache*& outCache,
+        PersistentCache::Key& outCacheKey,
+        IArtifact** outArtifact);
+
+    /// Run the compiler for `options`, and add its product to `cache` under `cacheKey` if `cache`
+    /// is set.
+    SlangResult _runCompiler(
+        const CompileOptions& options,
+        PersistentCache* cache,
+        const PersistentCache::Key& cacheKey,
+        IArtifact** outArtifact);
 };
 
 /* Only purpose of having base-class here is to make all the DownstreamCompiler types available
@@ -12,6 +12,9 @@
 #include "slang-artifact-representation-impl.h"
 #include "slang-artifact-util.h"
 #include "slang-com-helper.h"
+#include "slang-downstream-compile-cache.h"
+#include "slang-precompiled-prelude-util.h"
+#include "slang-slice-allocator.h"
 
 #include <mutex>
 
@@ -1304,4 +1307,161 @@ static SlangResult _parseGCCFamilyLine(
     return SLANG_OK;
 }
 
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! GCCDownstreamCompiler !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+SlangResult GCCDownstreamCompiler::_requirePrecompiledPrelude(
+    const CompileOptions& options,
+    String& outHeaderPath)
+{
+    // Work out the arguments of the compile, leaving out the ones that are only about its inputs
+    // and outputs. gcc and clang only use a precompiled header in a compile with the same
+    // arguments as the one it was made with.
+    CompileOptions headerOptions = options;
+    headerOptions.sourceArtifacts = Slice<IArtifact*>();
+    headerOptions.libraries = Slice<IArtifact*>();
+    headerOptions.libraryPaths = Slice<TerminatedCharSlice>();
+    headerOptions.modulePath = TerminatedCharSlice("slang-prelude");
+
+    CommandLine headerArgs;
+    SLANG_RETURN_ON_FAIL(Util::calcArgs(headerOptions, headerArgs));
+
+    List<String> args;
+    for (Index i = 0; i < headerArgs.getArgCount(); ++i)
+    {
+        const auto arg = headerArgs.m_args[i].getUnownedSlice();
+        if (arg == toSlice("-o"))
+        {
+            ++i;
+            continue;
+        }
+        if (arg == toSlice("-shared") || arg == toSlice("-c") || arg == toSlice("-rdynamic") ||
+            arg.startsWith("-Wl,") || arg.startsWith("-l"))
+        {
+            continue;
+        }
+        args.add(arg);
+    }
+
+    // The header is named for everything the precompiled header depends on, so a header with a
+    // precompiled header next to it never needs to be made again.
+    DigestBuilder<SHA1> builder;
+    builder.append(m_desc.type);
+    builder.append(m_desc.version.m_major);
+    builder.append(m_desc.version.m_minor);
+    builder.append(m_desc.version.m_patch);
+    builder.append(m_cmdLine.m_executableLocation.m_pathOrName);
+    for (const auto& arg : m_cmdLine.m_args)
+    {
+        builder.append(arg.getLength());
+        builder.append(arg);
+    }
+    for (const auto& arg : args)
+    {
+        builder.append(arg.getLength());
+        builder.append(arg);
+    }
+    builder.append(asStringSlice(options.prelude));
+
+    // The headers the prelude includes are looked for next to the header first, and then on the
+    // include paths. If they can't be told from the prelude, it isn't precompiled.
+    SLANG_RETURN_ON_FAIL(DownstreamCompileCacheUtil::appendIncludes(
+        builder,
+        asStringSlice(options.prelude),
+        asString(options.precompiledHeaderDirectory),
+        m_cmdLine,
+        options));
+
+    const String headerPath = PrecompiledPreludeUtil::getPath(
+        options,
+        PrecompiledPreludeUtil::getHeaderName(builder.finalize()));
+
+    // gcc looks for a precompiled header with the `.gch` extension next to an included header,
+    // and clang looks for `.pch` first.
+    const String pchPath =
+        headerPath + ((m_desc.type == SLANG_PASS_THROUGH_CLANG) ? ".pch" : ".gch");
+
+    if (!File::exists(pchPath))
+    {
+        SLANG_RETURN_ON_FAIL(PrecompiledPreludeUtil::requireHeader(options, headerPath));
+
+        const String tempPath = PrecompiledPreludeUtil::getTemporaryPath(pchPath);
+
+        CommandLine cmdLine(m_cmdLine);
+        cmdLine.m_args.addRange(args);
+        cmdLine.addArg("-x");
+        cmdLine.addArg(
+            (options.sourceLanguage == SLANG_SOURCE_LANGUAGE_C) ? "c-header" : "c++-header");
+        cmdLine.addArg(headerPath);
+        cmdLine.addArg("-o");
+        cmdLine.addArg(tempPath);
+
+        ExecuteResult exeRes;
+        SlangResult res = ProcessUtil::execute(cmdLine, exeRes);
+        if (SLANG_FAILED(res) || exeRes.resultCode != 0)
+        {
+            File::remove(tempPath);
+            return SLANG_FAIL;
+        }
+        SLANG_RETURN_ON_FAIL(PrecompiledPreludeUtil::publishFile(tempPath, pchPath));
+    }
+
+    outHeaderPath = headerPath;
+    return SLANG_OK;
+}
+
+SlangResult GCCDownstreamCompiler::compile(const CompileOptions& inOptions, IArtifact** outArtifact)
+{
+    if (!isVersionCompatible(inOptions))
+    {
+        return Super::compile(inOptions, outArtifact);
+    }
+
+    CompileOptions options = getCompatibleVersion(&inOptions);
+
+    // The compile is looked for in the cache as it was asked for, before the precompiled header is
+    // made, and its product is added under that key.
+    PersistentCache* cache = nullptr;
+    PersistentCache::Key cacheKey;
+    const SlangResult cacheRes = _findCachedProduct(options, cache, cacheKey, outArtifact);
+    if (cacheRes != SLANG_E_NOT_FOUND)
+        return cacheRes;
+
+    // A source that starts with the prelude is compiled without it, with the header the prelude is
+    // precompiled from included first. If the precompiled header can't be made, the source is
+    // compiled as it is. The precompiled header directory stays locked until the compile is done,
+    // so that the files it uses aren't removed.
+    ComPtr<IArtifact> restArtifact;
+    String headerPath;
+    List<TerminatedCharSlice> args;
+    PrecompiledPreludeLock preludeLock;
+
+    ComPtr<ISlangBlob> sourceBlob;
+    UnownedStringSlice rest;
+    if (options.sourceArtifacts.count == 1 &&
+        (options.sourceLanguage == SLANG_SOURCE_LANGUAGE_C ||
+         options.sourceLanguage == SLANG_SOURCE_LANGUAGE_CPP) &&
+        SLANG_SUCCEEDED(
+            options.sourceArtifacts[0]->loadBlob(ArtifactKeep::Yes, sourceBlob.writeRef())) &&
+        PrecompiledPreludeUtil::splitSource(options, StringUtil::getSlice(sourceBlob), rest) &&
+        SLANG_SUCCEEDED(preludeLock.lock(options)) &&
+        SLANG_SUCCEEDED(_requirePrecompiledPrelude(options, headerPath)))
+    {
+        preludeLock.setHeaderName(Path::getFileName(headerPath));
+
+        restArtifact = ArtifactUtil::createArtifact(options.sourceArtifacts[0]->getDesc());
+        restArtifact->addRepresentationUnknown(StringBlob::create(rest));
+
+        args.addRange(
+            options.compilerSpecificArguments.begin(),
+            options.compilerSpecificArguments.count);
+        args.add(TerminatedCharSlice("-include"));
+        args.add(SliceUtil::asTerminatedCharSlice(headerPath));
+
+        options.sourceArtifacts = makeSlice(restArtifact.readRef(), 1);
+        options.compilerSpecificArguments = SliceUtil::asSlice(args);
+    }
+
+    return _runCompiler(options, cache, cacheKey, outArtifact);
+}
+
 } // namespace Slang
@@ -57,6 +57,10 @@ public:
     typedef CommandLineDownstreamCompiler Super;
     typedef GCCDownstreamCompilerUtil Util;
 
+    // IDownstreamCompiler
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    compile(const CompileOptions& options, IArtifact** outArtifact) SLANG_OVERRIDE;
+
     // CommandLineCPPCompiler impl  - just forwards to the Util
     virtual SlangResult calcArgs(const CompileOptions& options, CommandLine& cmdLine) SLANG_OVERRIDE
     {
@@ -81,6 +85,11 @@ public:
         : Super(desc)
     {
     }
+
+protected:
+    /// Make sure there is a precompiled header for the prelude of `options`, made with the same
+    /// arguments as a compile with `options`, and output the path of the header it is made from.
+    SlangResult _requirePrecompiledPrelude(const CompileOptions& options, String& outHeaderPath);
 };
 
 } // namespace Slang
@@ -19,6 +19,12 @@
 #include <cstdint>
 #include <limits>
 
+#if SLANG_PROCESSOR_X86_64
+#include <emmintrin.h>
+#elif SLANG_PROCESSOR_ARM_64
+#include <arm_neon.h>
+#endif
+
 namespace Slang
 {
 Token TokenReader::getEndOfFileToken()
@@ -402,10 +408,213 @@ static void _handleNewLine(Lexer* lexer)
     _handleNewLineInner(lexer, c);
 }
 
+// Comments, horizontal space and identifiers are mostly made of plain ASCII bytes, which
+// `_advance` steps over one at a time without doing anything else. `_skipPlainBytes` steps over
+// a run of them 16 bytes at a time (using SSE2 or NEON where available), and stops at the first
+// byte that the code point loops below need to see: one that ends the token, or one of the bytes
+// `_peek` and `_advance` treat specially (a backslash, a null byte or the start of a UTF-8
+// sequence).
+//
+// Each kind of run is described by a struct with `isStop`, which tests one byte, and
+// `findStops`, which marks the stopping bytes of a block.
+
+#if SLANG_PROCESSOR_X86_64
+
+typedef __m128i ByteBlock;
+
+static ByteBlock _loadByteBlock(char const* bytes)
+{
+    return _mm_loadu_si128((__m128i const*)bytes);
+}
+
+static ByteBlock _bytesEqual(ByteBlock block, char c)
+{
+    return _mm_cmpeq_epi8(block, _mm_set1_epi8(c));
+}
+
+// Bytes in the ASCII range [lo, hi]. The comparisons are signed, so bytes >= 0x80 never match.
+static ByteBlock _bytesInRange(ByteBlock block, char lo, char hi)
+{
+    return _mm_and_si128(
+        _mm_cmpgt_epi8(block, _mm_set1_epi8(lo - 1)),
+        _mm_cmplt_epi8(block, _mm_set1_epi8(hi + 1)));
+}
+
+// Null bytes and bytes >= 0x80, which are the only bytes that are <= 0 when signed.
+static ByteBlock _bytesNullOrNonAscii(ByteBlock block)
+{
+    return _mm_cmplt_epi8(block, _mm_set1_epi8(1));
+}
+
+static ByteBlock _orBytes(ByteBlock a, ByteBlock b)
+{
+    return _mm_or_si128(a, b);
+}
+
+static ByteBlock _notBytes(ByteBlock block)
+{
+    return _mm_xor_si128(block, _mm_set1_epi8(-1));
+}
+
+// The index of the first marked byte of `block`, or 16 if there is none.
+static int _findFirstMarkedByte(ByteBlock block)
+{
+    const uint32_t mask = uint32_t(_mm_movemask_epi8(block));
+    return mask ? std::countr_zero(mask) : 16;
+}
+
+#define SLANG_LEXER_HAS_BYTE_BLOCKS 1
+
+#elif SLANG_PROCESSOR_ARM_64
+
+typedef uint8x16_t ByteBlock;
+
+static ByteBlock _loadByteBlock(char const* bytes)
+{
+    return vld1q_u8((uint8_t const*)bytes);
+}
+
+static ByteBlock _bytesEqual(ByteBlock block, char c)
+{
+    return vceqq_u8(block, vdupq_n_u8(uint8_t(c)));
+}
+
+static ByteBlock _bytesInRange(ByteBlock block, char lo, char hi)
+{
+    return vandq_u8(
+        vcgeq_u8(block, vdupq_n_u8(uint8_t(lo))),
+        vcleq_u8(block, vdupq_n_u8(uint8_t(hi))));
+}
+
+static ByteBlock _bytesNullOrNonAscii(ByteBlock block)
+{
+    return vorrq_u8(vceqzq_u8(block), vcgeq_u8(block, vdupq_n_u8(0x80)));
+}
+
+static ByteBlock _orBytes(ByteBlock a, ByteBlock b)
+{
+    return vorrq_u8(a, b);
+}
+
+static ByteBlock _notBytes(ByteBlock block)
+{
+    return vmvnq_u8(block);
+}
+
+// The index of the first marked byte of `block`, or 16 if there is none.
+//
+// NEON has no equivalent of `movemask`, so narrow each byte to 4 bits of a 64-bit mask instead.
+static int _findFirstMarkedByte(ByteBlock block)
+{
+    const uint64_t mask =
+        vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(block), 4)), 0);
+    return mask ? std::countr_zero(mask) >> 2 : 16;
+}
+
+#define SLANG_LEXER_HAS_BYTE_BLOCKS 1
+
+#else
+
+#define SLANG_LEXER_HAS_BYTE_BLOCKS 0
+
+#endif
+
+static bool _isNullOrNonAscii(Byte c)
+{
+    return c == 0 || c >= 0x80;
+}
+
+static bool _isIdentifierByte(Byte c)
+{
+    return ('a' <= c) && (c <= 'z') || ('A' <= c) && (c <= 'Z') || ('0' <= c) && (c <= '9') ||
+           (c == '_');
+}
+
+struct LineCommentBytes
+{
+    static bool isStop(Byte c)
+    {
+        return _isNullOrNonAscii(c) || c == '\n' || c == '\r' || c == '\\';
+    }
+
+#if SLANG_LEXER_HAS_BYTE_BLOCKS
+    static ByteBlock findStops(ByteBlock block)
+    {
+        return _orBytes(
+            _orBytes(_bytesNullOrNonAscii(block), _bytesEqual(block, '\\')),
+            _orBytes(_bytesEqual(block, '\n'), _bytesEqual(block, '\r')));
+    }
+#endif
+};
+
+struct BlockCommentBytes
+{
+    static bool isStop(Byte c) { return LineCommentBytes::isStop(c) || c == '*'; }
+
+#if SLANG_LEXER_HAS_BYTE_BLOCKS
+    static ByteBlock findStops(ByteBlock block)
+    {
+        return _orBytes(LineCommentBytes::findStops(block), _bytesEqual(block, '*'));
+    }
+#endif
+};
+
+struct HorizontalSpaceBytes
+{
+    static bool isStop(Byte c) { return c != ' ' && c != '\t'; }
+
+#if SLANG_LEXER_HAS_BYTE_BLOCKS
+    static ByteBlock findStops(ByteBlock block)
+    {
+        return _notBytes(_orBytes(_bytesEqual(block, ' '), _bytesEqual(block, '\t')));
+    }
+#endif
+};
+
+struct IdentifierBytes
+{
+    static bool isStop(Byte c) { return !_isIdentifierByte(c); }
+
+#if SLANG_LEXER_HAS_BYTE_BLOCKS
+    static ByteBlock findStops(ByteBlock block)
+    {
+        return _notBytes(_orBytes(
+            _orBytes(_bytesInRange(block, 'a', 'z'), _bytesInRange(block, 'A', 'Z')),
+            _orBytes(_bytesInRange(block, '0', '9'), _bytesEqual(block, '_'))));
+    }
+#endif
+};
+
+template<typename Bytes>
+static void _skipPlainBytes(Lexer* lexer)
+{
+    char const* cursor = lexer->m_cursor;
+    char const* const end = lexer->m_end;
+
+#if SLANG_LEXER_HAS_BYTE_BLOCKS
+    while (end - cursor >= 16)
+    {
+        const int index = _findFirstMarkedByte(Bytes::findStops(_loadByteBlock(cursor)));
+        cursor += index;
+        if (index < 16)
+        {
+            lexer->m_cursor = cursor;
+            return;
+        }
+    }
+#endif
+
+    while (cursor < end && !Bytes::isStop(Byte(*cursor)))
+        cursor++;
+    lexer->m_cursor = cursor;
+}
+
 static void _lexLineComment(Lexer* lexer)
 {
     for (;;)
     {
+        _skipPlainBytes<LineCommentBytes>(lexer);
+
         switch (_peek(lexer))
         {
         case '\n':
@@ -424,6 +633,8 @@ static void _lexBlockComment(Lexer* lexer)
 {
     for (;;)
     {
+        _skipPlainBytes<BlockCommentBytes>(lexer);
+
         switch (_peek(lexer))
         {
         case kEOF:
@@ -458,6 +669,8 @@ static void _lexHorizontalSpace(Lexer* lexer)
 {
     for (;;)
     {
+        _skipPlainBytes<HorizontalSpaceBytes>(lexer);
+
         switch (_peek(lexer))
         {
         case ' ':
@@ -480,6 +693,8 @@ static void _lexIdentifier(Lexer* lexer)
 {
     for (;;)
     {
+        _skipPlainBytes<IdentifierBytes>(lexer);
+
         int c = _peek(lexer);
         if (('a' <= c) && (c <= 'z') || ('A' <= c) && (c <= 'Z') || ('0' <= c) && (c <= '9') ||
             (c == '_') || isNonAsciiCodePoint((unsigned int)c))
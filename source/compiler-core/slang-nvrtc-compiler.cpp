@@ -14,6 +14,8 @@
 #include "slang-artifact-diagnostic-util.h"
 #include "slang-artifact-util.h"
 #include "slang-com-helper.h"
+#include "slang-downstream-compile-cache.h"
+#include "slang-precompiled-prelude-util.h"
 
 namespace nvrtc
 {
@@ -1370,6 +1372,52 @@ SlangResult NVRTCDownstreamCompiler::compile(
     StringBuilder storage;
     auto sourceContents = SliceUtil::toTerminatedCharSlice(storage, sourceBlob);
 
+    // NVRTC 12.8 and later can precompile the headers a source starts with. A source that starts
+    // with the prelude includes a header holding the prelude instead, which NVRTC precompiles
+    // into the precompiled header directory the first time it is included.
+    StringBuilder sourceWithHeader;
+    UnownedStringSlice sourceRest;
+    PrecompiledPreludeLock preludeLock;
+    if (m_desc.version >= SemanticVersion(12, 8) &&
+        PrecompiledPreludeUtil::splitSource(
+            options,
+            StringUtil::getSlice(sourceBlob),
+            sourceRest) &&
+        SLANG_SUCCEEDED(preludeLock.lock(options)))
+    {
+        // The header is named for the prelude and the headers it includes, so that NVRTC makes a
+        // new precompiled header when any of them change.
+        DigestBuilder<SHA1> builder;
+        builder.append(asStringSlice(options.prelude));
+        const SlangResult includesRes = DownstreamCompileCacheUtil::appendIncludes(
+            builder,
+            asStringSlice(options.prelude),
+            asString(options.precompiledHeaderDirectory),
+            cmdLine,
+            options);
+        const String headerName = PrecompiledPreludeUtil::getHeaderName(builder.finalize());
+
+        if (SLANG_SUCCEEDED(includesRes) &&
+            SLANG_SUCCEEDED(PrecompiledPreludeUtil::requireHeader(
+                options,
+                PrecompiledPreludeUtil::getPath(options, headerName))))
+        {
+            sourceWithHeader << "#include \"" << headerName << "\"\n" << sourceRest;
+            sourceContents = SliceUtil::asTerminatedCharSlice(sourceWithHeader);
+            preludeLock.setHeaderName(headerName);
+
+            // NVRTC names the precompiled headers it makes itself, so each header gets a directory
+            // of them, named after the header so that they are removed with it.
+            const String pchDirectory =
+                PrecompiledPreludeUtil::getPath(options, headerName + ".pch-dir");
+            Path::createDirectory(pchDirectory);
+            cmdLine.addArg("-I");
+            cmdLine.addArg(asString(options.precompiledHeaderDirectory));
+            cmdLine.addArg("--pch");
+            cmdLine.addArg("--pch-dir=" + pchDirectory);
+        }
+    }
+
     nvrtcProgram program = nullptr;
     nvrtcResult res = m_nvrtcCreateProgram(
         &program,
@@ -0,0 +1,185 @@
+// slang-precompiled-prelude-util.cpp
+#include "slang-precompiled-prelude-util.h"
+
+#include "core/slang-dictionary.h"
+#include "core/slang-io.h"
+#include "core/slang-process.h"
+#include "core/slang-string-util.h"
+#include "slang-slice-allocator.h"
+
+#include <atomic>
+#include <stdio.h>
+
+namespace Slang
+{
+
+/* static */ bool PrecompiledPreludeUtil::splitSource(
+    const CompileOptions& options,
+    const UnownedStringSlice& source,
+    UnownedStringSlice& outRest)
+{
+    if (options.prelude.count == 0 || options.precompiledHeaderDirectory.count == 0)
+        return false;
+
+    const auto prelude = asStringSlice(options.prelude);
+    if (!source.startsWith(prelude))
+        return false;
+
+    outRest = source.tail(prelude.getLength());
+    return true;
+}
+
+/* static */ String PrecompiledPreludeUtil::getPath(
+    const CompileOptions& options,
+    const String& name)
+{
+    return Path::combine(asString(options.precompiledHeaderDirectory), name);
+}
+
+/* static */ String PrecompiledPreludeUtil::getHeaderName(const SHA1::Digest& key)
+{
+    return "slang-prelude-" + key.toString() + ".h";
+}
+
+/* static */ SlangResult PrecompiledPreludeUtil::requireHeader(
+    const CompileOptions& options,
+    const String& path)
+{
+    if (File::exists(path))
+        return SLANG_OK;
+
+    // The directory may not have been made yet. If it can't be made, writing the header fails.
+    Path::createDirectoryRecursive(asString(options.precompiledHeaderDirectory));
+
+    const String tempPath = getTemporaryPath(path);
+    SLANG_RETURN_ON_FAIL(
+        File::writeAllBytes(tempPath, options.prelude.begin(), size_t(options.prelude.count)));
+    return publishFile(tempPath, path);
+}
+
+/* static */ SlangResult PrecompiledPreludeUtil::publishFile(
+    const String& fromPath,
+    const String& toPath)
+{
+    // Another compile may have published the same file in the meantime, in which case it is kept.
+    if (File::exists(toPath) || ::rename(fromPath.getBuffer(), toPath.getBuffer()) != 0)
+    {
+        File::remove(fromPath);
+    }
+    return File::exists(toPath) ? SLANG_OK : SLANG_FAIL;
+}
+
+/* static */ String PrecompiledPreludeUtil::getTemporaryPath(const String& path)
+{
+    // Each call makes its own, so concurrent compiles never write the same file.
+    static std::atomic<uint32_t> s_counter;
+    StringBuilder builder;
+    builder << path << "." << Process::getId() << "." << s_counter++ << ".tmp";
+    return builder.produceString();
+}
+
+/* static */ SlangResult PrecompiledPreludeUtil::trimDirectory(
+    const String& directory,
+    const String& usedHeaderName,
+    Count maxEntryCount)
+{
+    struct Visitor : Path::Visitor
+    {
+        void accept(Path::Type type, const UnownedStringSlice& fileName) SLANG_OVERRIDE
+        {
+            SLANG_UNUSED(type);
+            fileNames.add(fileName);
+        }
+        List<String> fileNames;
+    };
+    Visitor visitor;
+    SLANG_RETURN_ON_FAIL(Path::find(directory, nullptr, &visitor));
+
+    // Each header is named by `getHeaderName`, and the files made from it, such as its precompiled
+    // header and temporary files, are named by adding to the name of the header.
+    HashSet<String> headerNames;
+    for (const auto& fileName : visitor.fileNames)
+    {
+        if (fileName.startsWith("slang-prelude-") && fileName.endsWith(".h"))
+            headerNames.add(fileName);
+    }
+
+    // The index lists the headers least recently used first. Headers that aren't in it were made
+    // by compiles that couldn't update it, so are taken to have been used recently.
+    const String indexPath = Path::combine(directory, "slang-prelude.index");
+    List<String> order;
+    HashSet<String> ordered;
+    String indexText;
+    if (SLANG_SUCCEEDED(File::readAllText(indexPath, indexText)))
+    {
+        List<UnownedStringSlice> lines;
+        StringUtil::calcLines(indexText.getUnownedSlice(), lines);
+        for (const auto& line : lines)
+        {
+            String headerName(line);
+            if (headerName != usedHeaderName && headerNames.contains(headerName) &&
+                ordered.add(headerName))
+                order.add(headerName);
+        }
+    }
+    for (const auto& fileName : visitor.fileNames)
+    {
+        if (fileName != usedHeaderName && headerNames.contains(fileName) && ordered.add(fileName))
+            order.add(fileName);
+    }
+    if (headerNames.contains(usedHeaderName))
+        order.add(usedHeaderName);
+
+    Index removeCount = maxEntryCount > 0 ? order.getCount() - maxEntryCount : 0;
+    for (Index i = 0; i < removeCount; ++i)
+    {
+        for (const auto& fileName : visitor.fileNames)
+        {
+            if (fileName.startsWith(order[i]))
+                Path::removeNonEmpty(Path::combine(directory, fileName));
+        }
+    }
+    if (removeCount > 0)
+        order.removeRange(0, removeCount);
+
+    StringBuilder builder;
+    for (const auto& headerName : order)
+        builder << headerName << "\n";
+    return File::writeAllText(indexPath, builder);
+}
+
+SlangResult PrecompiledPreludeLock::lock(const CompileOptions& options)
+{
+    unlock();
+
+    m_directory = asString(options.precompiledHeaderDirectory);
+    m_maxEntryCount = options.precompiledHeaderMaxEntryCount;
+    Path::createDirectoryRecursive(m_directory);
+    SLANG_RETURN_ON_FAIL(m_lockFile.open(Path::combine(m_directory, "slang-prelude.lock")));
+
+    const SlangResult res = m_lockFile.lock(LockFile::LockType::Shared);
+    if (SLANG_FAILED(res))
+        m_lockFile.close();
+    return res;
+}
+
+void PrecompiledPreludeLock::unlock()
+{
+    if (!m_lockFile.isOpen())
+        return;
+
+    m_lockFile.unlock();
+
+    // The shared lock is let go of first, as it can't be turned into an exclusive lock on every
+    // platform. Any files that another compile starts using in between are locked by it.
+    if (m_maxEntryCount > 0 && m_headerName.getLength() &&
+        SLANG_SUCCEEDED(m_lockFile.tryLock(LockFile::LockType::Exclusive)))
+    {
+        PrecompiledPreludeUtil::trimDirectory(m_directory, m_headerName, m_maxEntryCount);
+        m_lockFile.unlock();
+    }
+    m_lockFile.close();
+    m_headerName = String();
+}
+
+} // namespace Slang
@@ -0,0 +1,90 @@
+#ifndef SLANG_PRECOMPILED_PRELUDE_UTIL_H
+#define SLANG_PRECOMPILED_PRELUDE_UTIL_H
+
+#include "core/slang-crypto.h"
+#include "core/slang-io.h"
+#include "slang-downstream-compiler.h"
+
+namespace Slang
+{
+
+/* Helpers for downstream compilers that precompile the prelude at the start of a source.
+
+The prelude is written to a header in the precompiled header directory, which the compiler
+precompiles the first time it's needed. The rest of the source is compiled with that header
+included first. The directory can be shared by any number of compiles and processes at once, so
+files are only ever added to it whole, and are never changed once they are there.
+
+Each prelude, compiler and set of arguments adds a header and its precompiled header, which for
+gcc and clang can be tens of megabytes. Unless `precompiledHeaderMaxEntryCount` bounds the number
+of headers (see `PrecompiledPreludeLock`), nothing is ever removed from the directory, and one that
+is used for long should be emptied from time to time while nothing is compiling. */
+struct PrecompiledPreludeUtil
+{
+    typedef DownstreamCompileOptions CompileOptions;
+
+    /// If `options` asks for its prelude to be precompiled and `source` starts with that prelude,
+    /// outputs the rest of the source. Returns false otherwise.
+    static bool splitSource(
+        const CompileOptions& options,
+        const UnownedStringSlice& source,
+        UnownedStringSlice& outRest);
+
+    /// Get the path of the file `name` in the precompiled header directory of `options`.
+    static String getPath(const CompileOptions& options, const String& name);
+
+    /// Get the name of the header for the prelude of `options`, for a compile identified by `key`.
+    static String getHeaderName(const SHA1::Digest& key);
+
+    /// Write the prelude of `options` to the header at `path`, unless it's already there.
+    static SlangResult requireHeader(const CompileOptions& options, const String& path);
+
+    /// Move the file at `fromPath` to `toPath`, if there is no file at `toPath` already.
+    /// Succeeds if there is a file at `toPath` afterwards.
+    static SlangResult publishFile(const String& fromPath, const String& toPath);
+
+    /// Get a path that a file for `path` can be made at before it is published.
+    static String getTemporaryPath(const String& path);
+
+    /// Remove the least recently used headers of `directory`, and the files made from them, until
+    /// there are at most `maxEntryCount` left. `usedHeaderName` is the header that was used last.
+    /// The directory must be locked exclusively.
+    static SlangResult trimDirectory(
+        const String& directory,
+        const String& usedHeaderName,
+        Count maxEntryCount);
+};
+
+/* Keeps the files in the precompiled header directory from being removed while a compile uses
+them, and once it is done keeps the directory to `precompiledHeaderMaxEntryCount` headers.
+
+Every compile that uses the directory holds a shared lock on its lock file. Files are only removed
+with the exclusive lock, which is not waited for, so while other compiles are using the directory
+trimming is left to a later compile. Headers are removed least recently used first, in the order
+kept by the index file of the directory. */
+class PrecompiledPreludeLock
+{
+public:
+    typedef DownstreamCompileOptions CompileOptions;
+
+    /// Lock the precompiled header directory of `options`, making it if needed.
+    SlangResult lock(const CompileOptions& options);
+
+    /// Record that the compile uses the header `headerName` in the directory.
+    void setHeaderName(const String& headerName) { m_headerName = headerName; }
+
+    /// Unlock the directory, first trimming it if a header was used and the directory is bounded.
+    void unlock();
+
+    ~PrecompiledPreludeLock() { unlock(); }
+
+private:
+    LockFile m_lockFile;
+    String m_directory;
+    String m_headerName;
+    Count m_maxEntryCount = 0;
+};
+
+} // namespace Slang
+
+#endif
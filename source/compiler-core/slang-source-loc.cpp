@@ -1019,6 +1019,11 @@ void SourceManager::addSourceFileIfNotExist(const String& uniqueIdentity, Source
     m_sourceFileMap.addIfNotExists(uniqueIdentity, sourceFile);
 }
 
+void SourceManager::forgetSourceFile(SourceFile* sourceFile)
+{
+    m_sourceFileMap.removeIf([&](const auto& entry) { return entry.second == sourceFile; });
+}
+
 HumaneSourceLoc SourceManager::getHumaneLoc(SourceLoc loc, SourceLocType type)
 {
     SourceView* sourceView = findSourceViewRecursively(loc);
@@ -635,6 +635,11 @@ struct SourceManager
     void addSourceFile(const String& uniqueIdentity, SourceFile* sourceFile);
     void addSourceFileIfNotExist(const String& uniqueIdentity, SourceFile* sourceFile);
 
+    /// Stop finding `sourceFile` by unique identity, so the next load of the same file reads its
+    /// contents again. The source file is still owned by this manager, as locations may refer to
+    /// it.
+    void forgetSourceFile(SourceFile* sourceFile);
+
     // Maps a SourceLoc to an absolute location
     SourceLoc::RawValue getAbsoluteLocation(SourceLoc location) const;
 
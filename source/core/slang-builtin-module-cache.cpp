@@ -3,6 +3,9 @@
 #include "slang-builtin-module-cache.h"
 
 #include "slang-io.h"
+#include "slang-process.h"
+
+#include <atomic>
 
 namespace Slang
 {
@@ -31,6 +34,30 @@ SlangResult BuiltinModuleCache::read(
     return SLANG_OK;
 }
 
+SlangResult BuiltinModuleCache::map(
+    const String& cachePath,
+    uint64_t expectedLibraryTimestamp,
+    ComPtr<ISlangBlob>& outModuleBlob)
+{
+    outModuleBlob.setNull();
+
+    ComPtr<ISlangBlob> cacheBlob;
+    SLANG_RETURN_ON_FAIL(File::mapReadOnly(cachePath, cacheBlob));
+    if (cacheBlob->getBufferSize() < sizeof(uint64_t))
+        return SLANG_FAIL;
+
+    uint64_t cacheTimestamp = 0;
+    memcpy(&cacheTimestamp, cacheBlob->getBufferPointer(), sizeof(cacheTimestamp));
+    if (cacheTimestamp != expectedLibraryTimestamp)
+        return SLANG_FAIL;
+
+    auto moduleBlob = UnownedRawBlob::create(
+        (const uint8_t*)cacheBlob->getBufferPointer() + sizeof(cacheTimestamp),
+        cacheBlob->getBufferSize() - sizeof(cacheTimestamp));
+    outModuleBlob = ScopeBlob::create(moduleBlob, cacheBlob);
+    return SLANG_OK;
+}
+
 SlangResult BuiltinModuleCache::write(
     const String& cachePath,
     uint64_t libraryTimestamp,
@@ -40,11 +67,27 @@ SlangResult BuiltinModuleCache::write(
     if (libraryTimestamp == 0)
         return SLANG_FAIL;
 
-    FileStream fileStream;
-    SLANG_RETURN_ON_FAIL(fileStream.init(cachePath, FileMode::Create));
-    SLANG_RETURN_ON_FAIL(fileStream.write(&libraryTimestamp, sizeof(libraryTimestamp)));
-    SLANG_RETURN_ON_FAIL(fileStream.write(moduleData, moduleSize));
-    return SLANG_OK;
+    // The temporary file is unique to this process and call, and is in the same directory as the
+    // cache so that it can replace it in one step.
+    static std::atomic<uint32_t> s_counter;
+    StringBuilder tempPathBuilder;
+    tempPathBuilder << cachePath << "." << Process::getId() << "." << s_counter++ << ".tmp";
+    const String tempPath = tempPathBuilder.produceString();
+
+    SlangResult res = SLANG_OK;
+    {
+        FileStream fileStream;
+        res = fileStream.init(tempPath, FileMode::Create);
+        if (SLANG_SUCCEEDED(res))
+            res = fileStream.write(&libraryTimestamp, sizeof(libraryTimestamp));
+        if (SLANG_SUCCEEDED(res))
+            res = fileStream.write(moduleData, moduleSize);
+    }
+    if (SLANG_SUCCEEDED(res))
+        res = File::replace(tempPath, cachePath);
+    if (SLANG_FAILED(res))
+        File::remove(tempPath);
+    return res;
 }
 
 } // namespace Slang
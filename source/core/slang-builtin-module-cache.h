@@ -32,7 +32,20 @@ struct BuiltinModuleCache
         const void*& outModuleData,
         size_t& outModuleSize);
 
+    /// Maps a cache created for `expectedLibraryTimestamp` read-only and returns its module
+    /// payload as a blob that keeps the mapping alive.
+    ///
+    /// Processes mapping the same cache share its pages, and the payload starts 8 bytes into
+    /// the mapping, so a module image stored there can be used in place.
+    static SlangResult map(
+        const String& cachePath,
+        uint64_t expectedLibraryTimestamp,
+        ComPtr<ISlangBlob>& outModuleBlob);
+
     /// Writes `moduleData` with the library timestamp required by the runtime cache loader.
+    ///
+    /// The cache is written to a temporary file next to `cachePath`, which then replaces it,
+    /// so other processes that have the old cache mapped never see it change.
     static SlangResult write(
         const String& cachePath,
         uint64_t libraryTimestamp,
@@ -30,6 +30,7 @@
 #include <fnmatch.h>
 #include <ftw.h> // for nftw
 #include <sys/file.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #endif
 
@@ -65,6 +66,24 @@ namespace Slang
 #endif
 }
 
+/* static */ SlangResult File::replace(const String& fromPath, const String& toPath)
+{
+#ifdef _WIN32
+    // https://learn.microsoft.com/en-us/windows/win32/api/winbase/nf-winbase-movefileexw
+    if (MoveFileExW(fromPath.toWString(), toPath.toWString(), MOVEFILE_REPLACE_EXISTING))
+    {
+        return SLANG_OK;
+    }
+    return SLANG_FAIL;
+#else
+    // https://man7.org/linux/man-pages/man2/rename.2.html
+    if (::rename(fromPath.getBuffer(), toPath.getBuffer()) == 0)
+    {
+        return SLANG_OK;
+    }
+    return SLANG_FAIL;
+#endif
+}
 
 #ifdef _WIN32
 /* static */ SlangResult File::generateTemporary(
@@ -744,6 +763,13 @@ String Path::getCurrentPath()
     return path;
 }
 
+SlangResult Path::setCurrentPath(const String& path)
+{
+    std::error_code ec;
+    std::filesystem::current_path(std::filesystem::path(path.getBuffer()), ec);
+    return ec ? SLANG_FAIL : SLANG_OK;
+}
+
 String Path::getRelativePath(String base, String path)
 {
     std::filesystem::path p1(base.getBuffer());
@@ -1187,6 +1213,149 @@ SlangResult File::readAllBytes(const String& path, ScopedAllocation& out)
     return (sizeInBytes == readSizeInBytes) ? SLANG_OK : SLANG_FAIL;
 }
 
+namespace
+{ // anonymous
+
+/* A blob whose contents are a read-only mapping of a whole file. The mapping is shared
+with the OS page cache, so processes mapping the same file share its physical pages. */
+class MappedFileBlob : public BlobBase
+{
+public:
+    // ISlangBlob
+    SLANG_NO_THROW void const* SLANG_MCALL getBufferPointer() SLANG_OVERRIDE { return m_data; }
+    SLANG_NO_THROW size_t SLANG_MCALL getBufferSize() SLANG_OVERRIDE { return m_dataSizeInBytes; }
+
+    SlangResult init(const String& path);
+
+    ~MappedFileBlob();
+
+protected:
+    void* m_data = nullptr;
+    size_t m_dataSizeInBytes = 0;
+};
+
+#if SLANG_WINDOWS_FAMILY
+
+SlangResult MappedFileBlob::init(const String& path)
+{
+    HANDLE file = CreateFileW(
+        path.toWString(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return SLANG_FAIL;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0 ||
+        UInt64(fileSize.QuadPart) > UInt64(~size_t(0)))
+    {
+        CloseHandle(file);
+        return SLANG_FAIL;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    // The view keeps the file and mapping alive, so the handles aren't needed past here.
+    CloseHandle(file);
+    if (!mapping)
+    {
+        return SLANG_FAIL;
+    }
+    m_data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!m_data)
+    {
+        return SLANG_FAIL;
+    }
+
+    m_dataSizeInBytes = size_t(fileSize.QuadPart);
+    return SLANG_OK;
+}
+
+MappedFileBlob::~MappedFileBlob()
+{
+    if (m_data)
+    {
+        UnmapViewOfFile(m_data);
+    }
+}
+
+#elif defined(__linux__) || defined(__CYGWIN__) || SLANG_APPLE_FAMILY
+
+SlangResult MappedFileBlob::init(const String& path)
+{
+    int fd = ::open(path.getBuffer(), O_RDONLY);
+    if (fd < 0)
+    {
+        return SLANG_FAIL;
+    }
+
+    struct stat statBuffer;
+    if (::fstat(fd, &statBuffer) != 0 || statBuffer.st_size <= 0 ||
+        UInt64(statBuffer.st_size) > UInt64(~size_t(0)))
+    {
+        ::close(fd);
+        return SLANG_FAIL;
+    }
+
+    const size_t sizeInBytes = size_t(statBuffer.st_size);
+    void* data = ::mmap(nullptr, sizeInBytes, PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping holds its own reference to the file.
+    ::close(fd);
+    if (data == MAP_FAILED)
+    {
+        return SLANG_FAIL;
+    }
+
+    m_data = data;
+    m_dataSizeInBytes = sizeInBytes;
+    return SLANG_OK;
+}
+
+MappedFileBlob::~MappedFileBlob()
+{
+    if (m_data)
+    {
+        ::munmap(m_data, m_dataSizeInBytes);
+    }
+}
+
+#else
+
+SlangResult MappedFileBlob::init(const String& path)
+{
+    SLANG_UNUSED(path);
+    return SLANG_E_NOT_AVAILABLE;
+}
+
+MappedFileBlob::~MappedFileBlob() {}
+
+#endif
+
+} // namespace
+
+/* static */ SlangResult File::mapReadOnly(const String& fileName, ComPtr<ISlangBlob>& outBlob)
+{
+    auto mappedBlob = new MappedFileBlob;
+    ComPtr<ISlangBlob> blob(mappedBlob);
+    if (SLANG_SUCCEEDED(mappedBlob->init(fileName)))
+    {
+        outBlob = blob;
+        return SLANG_OK;
+    }
+
+    // Fall back to reading into memory where mapping isn't available.
+    ScopedAllocation contents;
+    SLANG_RETURN_ON_FAIL(readAllBytes(fileName, contents));
+    outBlob = RawBlob::moveCreate(contents);
+    return SLANG_OK;
+}
+
 SlangResult File::writeAllBytes(const String& path, const void* data, size_t size)
 {
     FileStream stream;
@@ -19,6 +19,10 @@ public:
     static SlangResult readAllBytes(const String& fileName, List<unsigned char>& out);
     static SlangResult readAllBytes(const String& fileName, ScopedAllocation& out);
 
+    /// Get the contents of a file as a read-only memory mapping, which processes mapping the
+    /// same file share. Falls back to reading the file where mapping isn't available.
+    static SlangResult mapReadOnly(const String& fileName, ComPtr<ISlangBlob>& outBlob);
+
     static SlangResult writeAllText(const String& fileName, const String& text);
 
     static SlangResult writeAllTextIfChanged(const String& fileName, UnownedStringSlice text);
@@ -30,6 +34,12 @@ public:
 
     static SlangResult remove(const String& fileName);
 
+    /// Move the file at `fromPath` to `toPath` in one step, replacing any file already there.
+    /// Processes that have the replaced file open or mapped keep seeing its old contents. On
+    /// Windows this fails while the replaced file is mapped. The paths should be on the same
+    /// volume.
+    static SlangResult replace(const String& fromPath, const String& toPath);
+
     static SlangResult makeExecutable(const String& fileName);
 
     /// Creates a temporary file typically in some way based on the prefix
@@ -228,6 +238,11 @@ public:
     /// @return The path in platform native format. Returns empty string if failed.
     static String getCurrentPath();
 
+    /// Changes the current working directory of the process
+    /// @param path The directory to make current
+    /// @return SLANG_OK on success
+    static SlangResult setCurrentPath(const String& path);
+
     /// Returns the executable path
     /// @return The path in platform native format. Returns empty string if failed.
     static String getExecutablePath();
@@ -0,0 +1,39 @@
+#ifndef SLANG_CORE_LOCAL_SOCKET_H
+#define SLANG_CORE_LOCAL_SOCKET_H
+
+#include "slang-stream.h"
+
+namespace Slang
+{
+
+/// Accepts connections made to a local socket.
+///
+/// The socket file is removed when the listener is destroyed.
+class LocalSocketListener : public RefObject
+{
+public:
+    /// Block until a client connects, and return a stream that reads from and writes to it.
+    ///
+    /// Reads from the stream don't block, so it can back a HTTPPacketConnection.
+    virtual SlangResult accept(RefPtr<Stream>& outStream) = 0;
+};
+
+/* Stream sockets between processes on the same machine, addressed by a path in the file system.
+
+Implemented with Unix domain sockets. On targets without them, every function returns
+SLANG_E_NOT_AVAILABLE. */
+struct LocalSocket
+{
+    /// Listen for connections at `path`.
+    ///
+    /// A socket file left at `path` by a listener that has gone away is replaced. Fails if another
+    /// listener is still accepting connections at `path`.
+    static SlangResult listen(const String& path, RefPtr<LocalSocketListener>& outListener);
+
+    /// Connect to the listener at `path`. Reads from the returned stream don't block.
+    static SlangResult connect(const String& path, RefPtr<Stream>& outStream);
+};
+
+} // namespace Slang
+
+#endif
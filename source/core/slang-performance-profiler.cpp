@@ -1,6 +1,8 @@
 #include "slang-performance-profiler.h"
 
 #include "slang-dictionary.h"
+#include "slang-io.h"
+#include "slang-string-escape-util.h"
 
 namespace Slang
 {
@@ -77,6 +79,144 @@ PerformanceProfiler* Slang::PerformanceProfiler::getProfiler()
     return &profiler;
 }
 
+static uint32_t _getTraceThreadId()
+{
+    // Small sequential ids keep the trace readable, and unlike `std::thread::id` are
+    // stable to print.
+    static std::atomic<uint32_t> nextThreadId{1};
+    thread_local uint32_t threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    return threadId;
+}
+
+static thread_local PerformanceTraceContextRAII* t_currentTraceContext = nullptr;
+
+PerformanceTracer* PerformanceTracer::getTracer()
+{
+    static PerformanceTracer tracer;
+    return &tracer;
+}
+
+void PerformanceTracer::acquire()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_enableCount.load(std::memory_order_relaxed) == 0)
+    {
+        m_events.clear();
+        m_epoch = std::chrono::high_resolution_clock::now();
+    }
+    m_enableCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PerformanceTracer::release()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    SLANG_ASSERT(m_enableCount.load(std::memory_order_relaxed) > 0);
+    m_enableCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void PerformanceTracer::addEvent(
+    const char* name,
+    std::chrono::high_resolution_clock::time_point startTime,
+    std::chrono::high_resolution_clock::time_point endTime)
+{
+    Event event;
+    event.name = name;
+    event.threadId = _getTraceThreadId();
+    event.startTime = startTime;
+    event.endTime = endTime;
+
+    StringBuilder args;
+    PerformanceTraceContextRAII::appendArgs(args);
+    event.args = args.produceString();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_events.add(_Move(event));
+}
+
+void PerformanceTracer::writeJSON(StringBuilder& out)
+{
+    auto handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Events are added when a section ends, so inner sections precede the sections that
+    // enclose them. Trace viewers rebuild the nesting from `ts`/`dur` on each `tid`.
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (Index i = 0; i < m_events.getCount(); ++i)
+    {
+        const auto& event = m_events[i];
+        auto startMicros =
+            std::chrono::duration_cast<std::chrono::microseconds>(event.startTime - m_epoch);
+        auto durationMicros =
+            std::chrono::duration_cast<std::chrono::microseconds>(event.endTime - event.startTime);
+
+        if (i != 0)
+            out << ",";
+        out << "\n{\"name\":";
+        StringEscapeUtil::appendQuoted(handler, UnownedStringSlice(event.name), out);
+        out << ",\"cat\":\"slang\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadId;
+        out << ",\"ts\":" << Int64(startMicros.count());
+        out << ",\"dur\":" << Int64(durationMicros.count());
+        out << ",\"args\":{" << event.args << "}}";
+    }
+    out << "\n]}\n";
+}
+
+SlangResult PerformanceTracer::writeToFile(const String& path)
+{
+    StringBuilder json;
+    writeJSON(json);
+    return File::writeAllText(path, json.produceString());
+}
+
+void PerformanceTracer::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_events.clear();
+}
+
+PerformanceTraceContextRAII::PerformanceTraceContextRAII(const char* key, const String& value)
+{
+    if (!PerformanceTracer::getTracer()->isEnabled())
+        return;
+
+    m_key = key;
+    m_value = value;
+    m_parent = t_currentTraceContext;
+    m_isActive = true;
+    t_currentTraceContext = this;
+}
+
+PerformanceTraceContextRAII::~PerformanceTraceContextRAII()
+{
+    if (m_isActive)
+        t_currentTraceContext = m_parent;
+}
+
+void PerformanceTraceContextRAII::appendArgs(StringBuilder& out)
+{
+    auto handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
+
+    // Walk from the innermost context outwards, skipping keys already set by an inner
+    // context so that the most specific value wins.
+    List<const char*> seenKeys;
+    for (auto context = t_currentTraceContext; context; context = context->m_parent)
+    {
+        bool isShadowed = false;
+        for (auto seenKey : seenKeys)
+            isShadowed = isShadowed || strcmp(seenKey, context->m_key) == 0;
+        if (isShadowed)
+            continue;
+        seenKeys.add(context->m_key);
+
+        if (seenKeys.getCount() > 1)
+            out << ",";
+        StringEscapeUtil::appendQuoted(handler, UnownedStringSlice(context->m_key), out);
+        out << ":";
+        StringEscapeUtil::appendQuoted(handler, context->m_value.getUnownedSlice(), out);
+    }
+}
+
 SlangProfiler::SlangProfiler(PerformanceProfiler* profiler)
 {
     PerformanceProfilerImpl* profilerImpl = static_cast<PerformanceProfilerImpl*>(profiler);
@@ -5,7 +5,9 @@
 #include "slang-com-helper.h"
 #include "slang-string.h"
 
+#include <atomic>
 #include <chrono>
+#include <mutex>
 #include <vector>
 
 namespace Slang
@@ -36,6 +38,74 @@ public:
     static PerformanceProfiler* getProfiler();
 };
 
+/// Records every profiled section as a timed event, tagged with the thread it ran on and the
+/// enclosing `PerformanceTraceContextRAII` values, and writes them in the Chrome Trace Event
+/// JSON format understood by `chrome://tracing` and Perfetto.
+///
+/// Unlike `PerformanceProfiler`, which keeps a flat per-thread total for each section, the
+/// tracer is shared by all threads so nested and concurrent sections can be told apart.
+/// Recording is off until some client calls `acquire`; each `acquire` must be paired with a
+/// `release`. Events recorded while several clients hold the tracer are visible to all of them.
+class PerformanceTracer
+{
+public:
+    struct Event
+    {
+        const char* name = nullptr;
+        String args;
+        uint32_t threadId = 0;
+        std::chrono::high_resolution_clock::time_point startTime;
+        std::chrono::high_resolution_clock::time_point endTime;
+    };
+
+    /// Start recording. The first acquire discards events left from an earlier recording.
+    void acquire();
+    /// Stop recording once every `acquire` has been matched.
+    void release();
+
+    bool isEnabled() const { return m_enableCount.load(std::memory_order_relaxed) != 0; }
+
+    /// Record a section that ran on the calling thread from `startTime` to `endTime`.
+    void addEvent(
+        const char* name,
+        std::chrono::high_resolution_clock::time_point startTime,
+        std::chrono::high_resolution_clock::time_point endTime);
+
+    /// Append all recorded events to `out` as a Chrome Trace Event JSON object.
+    void writeJSON(StringBuilder& out);
+
+    /// Write the recorded events as JSON to the file at `path`.
+    SlangResult writeToFile(const String& path);
+
+    void clear();
+
+    static PerformanceTracer* getTracer();
+
+private:
+    std::atomic<int> m_enableCount{0};
+    std::mutex m_mutex;
+    List<Event> m_events;
+    std::chrono::high_resolution_clock::time_point m_epoch;
+};
+
+/// Attaches a `key`/`value` pair (such as the module or entry point being processed) to every
+/// trace event recorded on this thread while the object is alive. Contexts nest; an inner
+/// context overrides an outer one with the same key. Does nothing unless the tracer is enabled.
+struct PerformanceTraceContextRAII
+{
+    PerformanceTraceContextRAII(const char* key, const String& value);
+    ~PerformanceTraceContextRAII();
+
+    /// Append the active contexts on this thread as the members of a JSON object.
+    static void appendArgs(StringBuilder& out);
+
+private:
+    const char* m_key = nullptr;
+    String m_value;
+    PerformanceTraceContextRAII* m_parent = nullptr;
+    bool m_isActive = false;
+};
+
 struct PerformanceProfilerFuncRAIIContext
 {
     FuncProfileContext context;
@@ -46,6 +116,15 @@ struct PerformanceProfilerFuncRAIIContext
     ~PerformanceProfilerFuncRAIIContext()
     {
         PerformanceProfiler::getProfiler()->exitFunction(context);
+
+        auto tracer = PerformanceTracer::getTracer();
+        if (tracer->isEnabled())
+        {
+            tracer->addEvent(
+                context.funcName,
+                context.startTime,
+                std::chrono::high_resolution_clock::now());
+        }
     }
 };
 
@@ -24,6 +24,12 @@
 #include <unistd.h>
 #endif
 
+#ifndef _WIN32
+#include <stdlib.h>
+
+extern char** environ;
+#endif
+
 namespace Slang
 {
 // SharedLibrary
@@ -400,6 +406,79 @@ SLANG_COMPILE_TIME_ASSERT(E_OUTOFMEMORY == SLANG_E_OUT_OF_MEMORY);
 #endif
 }
 
+/// Split an environment entry "NAME=VALUE". On Windows names can start with '=', so the first
+/// character is never taken as the separator.
+static void _splitEnvironmentEntry(const String& entry, String& outName, String& outValue)
+{
+    const auto slice = entry.getUnownedSlice();
+    const Index index = slice.getLength() > 0 ? slice.tail(1).indexOf('=') : -1;
+    if (index < 0)
+    {
+        outName = slice;
+        outValue = String();
+        return;
+    }
+    outName = slice.head(index + 1);
+    outValue = slice.tail(index + 2);
+}
+
+/* static */ SlangResult PlatformUtil::getEnvironment(List<String>& outEntries)
+{
+    outEntries.clear();
+#ifdef _WIN32
+    wchar_t* const block = ::GetEnvironmentStringsW();
+    if (!block)
+        return SLANG_FAIL;
+    // The block is a sequence of zero terminated entries, ended by an empty one.
+    for (const wchar_t* entry = block; *entry; entry += ::wcslen(entry) + 1)
+    {
+        outEntries.add(String::fromWString(entry));
+    }
+    ::FreeEnvironmentStringsW(block);
+#else
+    for (char** entry = environ; entry && *entry; ++entry)
+    {
+        outEntries.add(*entry);
+    }
+#endif
+    return SLANG_OK;
+}
+
+/* static */ SlangResult PlatformUtil::setEnvironment(const List<String>& entries)
+{
+    List<String> currentEntries;
+    SLANG_RETURN_ON_FAIL(getEnvironment(currentEntries));
+
+    // On Windows `_wputenv_s` keeps the CRT's copy of the environment, which `getenv` reads, in step
+    // with the process environment. Setting an empty value with it removes a variable.
+    SlangResult res = SLANG_OK;
+    String name;
+    String value;
+    for (const auto& entry : currentEntries)
+    {
+        _splitEnvironmentEntry(entry, name, value);
+#ifdef _WIN32
+        const bool removed = _wputenv_s(name.toWString().begin(), L"") == 0;
+#else
+        const bool removed = ::unsetenv(name.getBuffer()) == 0;
+#endif
+        if (!removed)
+            res = SLANG_FAIL;
+    }
+    for (const auto& entry : entries)
+    {
+        _splitEnvironmentEntry(entry, name, value);
+#ifdef _WIN32
+        const bool set = _wputenv_s(name.toWString().begin(), value.toWString().begin()) == 0;
+#else
+        const bool set = ::setenv(name.getBuffer(), value.getBuffer(), 1) == 0;
+#endif
+        if (!set)
+            res = SLANG_FAIL;
+    }
+    return res;
+}
+
 /* static */ PlatformKind PlatformUtil::getPlatformKind()
 {
 #if SLANG_WINRT
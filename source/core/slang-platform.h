@@ -2,6 +2,7 @@
 #ifndef SLANG_CORE_PLATFORM_H
 #define SLANG_CORE_PLATFORM_H
 
+#include "core/slang-list.h"
 #include "core/slang-string.h"
 #include "slang.h"
 
@@ -155,6 +156,13 @@ struct PlatformUtil
     /// Will return SLANG_E_NOT_FOUND if the variable is not set
     static SlangResult getEnvironmentVariable(const UnownedStringSlice& name, StringBuilder& out);
 
+    /// Get every variable in the environment of this process, each as "NAME=VALUE".
+    static SlangResult getEnvironment(List<String>& outEntries);
+
+    /// Replace the environment of this process with `entries`, each as "NAME=VALUE". Variables
+    /// that aren't in `entries` are removed.
+    static SlangResult setEnvironment(const List<String>& entries);
+
     /// Get the path to this instance (the path to the dll/executable/shared library the call is in)
     /// NOTE! This is not supported on all platforms, and will return SLANG_E_NOT_IMPLEMENTED in
     /// that scenario
@@ -102,6 +102,14 @@ public:
         Process::Flags flags,
         RefPtr<Process>& outProcess);
 
+    /// Start a copy of the current process, which carries on from this call with `outIsCopy`
+    /// set, while this process carries on with it clear. The copy is detached, so this process
+    /// never has to wait for it. The copy should end with `std::_Exit`, so it doesn't run
+    /// destructors for state it shares with this process, such as a socket listener.
+    /// Only call it while this process has a single thread.
+    /// Returns SLANG_E_NOT_AVAILABLE on targets that can't copy a process.
+    static SlangResult forkDetached(bool& outIsCopy);
+
     /// Sleep the current thread for time specified in milliseconds. 0 indicates to OS ok to yield
     /// this thread.
     static void sleepCurrentThread(Int timeInMs);
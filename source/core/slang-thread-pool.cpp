@@ -0,0 +1,140 @@
+#include "slang-thread-pool.h"
+
+#include "slang-math.h"
+
+namespace Slang
+{
+
+/* static */ Index ThreadPool::getHardwareThreadCount()
+{
+    const unsigned int count = std::thread::hardware_concurrency();
+    return count ? Index(count) : 1;
+}
+
+ThreadPool::ThreadPool(Index threadCount)
+{
+    if (threadCount <= 0)
+    {
+        threadCount = getHardwareThreadCount();
+    }
+
+    // The calling thread takes part in every loop, so it counts as one of the threads.
+    for (Index i = 1; i < threadCount; ++i)
+    {
+        const Index workerIndex = m_workers.getCount();
+        m_workers.add(std::thread([this, workerIndex] { _workerMain(workerIndex); }));
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShuttingDown = true;
+    }
+    m_loopStarted.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::_runIterations()
+{
+    const IterationFunc* func = m_func.load();
+    const Index count = m_count.load();
+    for (;;)
+    {
+        const Index index = m_nextIndex.fetch_add(1);
+        if (index >= count)
+        {
+            break;
+        }
+        (*func)(index);
+    }
+}
+
+void ThreadPool::_workerMain(Index workerIndex)
+{
+    uint64_t seenLoopGeneration = 0;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;)
+    {
+        m_loopStarted.wait(
+            lock,
+            [&] { return m_isShuttingDown || m_loopGeneration != seenLoopGeneration; });
+        if (m_isShuttingDown)
+        {
+            return;
+        }
+        seenLoopGeneration = m_loopGeneration;
+        if (workerIndex >= m_loopWorkerCount)
+        {
+            continue;
+        }
+
+        // A worker that wakes after the loop has already been finished by the other threads
+        // finds no iterations left, so it is harmless for it to join late.
+        m_busyWorkerCount++;
+        lock.unlock();
+
+        _runIterations();
+
+        lock.lock();
+        if (--m_busyWorkerCount == 0)
+        {
+            m_workersIdle.notify_all();
+        }
+    }
+}
+
+void ThreadPool::parallelFor(Index count, const IterationFunc& func, Index maxThreadCount)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    // Every iteration beyond the calling thread's first can go to a worker.
+    Index workerCount = Math::Min(m_workers.getCount(), count - 1);
+    if (maxThreadCount > 0)
+    {
+        workerCount = Math::Min(workerCount, maxThreadCount - 1);
+    }
+
+    // Waking workers isn't worth it if there is nothing to share.
+    if (workerCount <= 0)
+    {
+        for (Index i = 0; i < count; ++i)
+        {
+            func(i);
+        }
+        return;
+    }
+
+    // The workers and the state of the current loop are shared by all callers.
+    std::lock_guard<std::mutex> loopLock(m_loopMutex);
+
+    {
+        // A worker that joined the previous loop late may still be looking at its state.
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_workersIdle.wait(lock, [&] { return m_busyWorkerCount == 0; });
+
+        m_func = &func;
+        m_count = count;
+        m_nextIndex = 0;
+        m_loopWorkerCount = workerCount;
+        m_loopGeneration++;
+    }
+    m_loopStarted.notify_all();
+
+    _runIterations();
+
+    // All iterations have been claimed, but workers may still be running theirs.
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_workersIdle.wait(lock, [&] { return m_busyWorkerCount == 0; });
+}
+
+} // namespace Slang
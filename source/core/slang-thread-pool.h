@@ -0,0 +1,72 @@
+#ifndef SLANG_CORE_THREAD_POOL_H
+#define SLANG_CORE_THREAD_POOL_H
+
+#include "slang-list.h"
+#include "slang-smart-pointer.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Slang
+{
+
+/* A fixed set of worker threads that run the iterations of `parallelFor` loops.
+
+Iterations are claimed one at a time from a shared counter, so a thread that finishes
+cheap iterations goes on to take more instead of idling while another works through
+a long one. The calling thread runs iterations alongside the workers until the loop
+is done. */
+class ThreadPool : public RefObject
+{
+public:
+    typedef std::function<void(Index)> IterationFunc;
+
+    /// Run `func(i)` for every `i` in [0, count), returning once all have finished.
+    /// The pool runs one loop at a time, so calls from different threads take turns.
+    /// `func` must not throw, and must not call `parallelFor` on the same pool, which would
+    /// wait on itself. A `maxThreadCount` above 0 runs the loop on at most that many of the
+    /// pool's threads, counting the calling thread.
+    void parallelFor(Index count, const IterationFunc& func, Index maxThreadCount = 0);
+
+    /// The number of threads loops run on, including the calling thread.
+    Index getThreadCount() const { return m_workers.getCount() + 1; }
+
+    /// The number of threads the hardware can run concurrently, or 1 if unknown.
+    static Index getHardwareThreadCount();
+
+    /// Create a pool that runs loops on `threadCount` threads, counting the calling thread.
+    /// A `threadCount` of 0 or less uses `getHardwareThreadCount()`.
+    explicit ThreadPool(Index threadCount);
+    ~ThreadPool();
+
+private:
+    void _workerMain(Index workerIndex);
+    void _runIterations();
+
+    List<std::thread> m_workers;
+
+    // Held by the thread running a loop for the whole loop.
+    std::mutex m_loopMutex;
+
+    std::mutex m_mutex;
+    std::condition_variable m_loopStarted;
+    std::condition_variable m_workersIdle;
+
+    // The current loop. Set under `m_mutex` before `m_loopGeneration` is bumped.
+    std::atomic<const IterationFunc*> m_func{nullptr};
+    std::atomic<Index> m_count{0};
+    std::atomic<Index> m_nextIndex{0};
+
+    // Workers at or past this index sit the current loop out. Guarded by `m_mutex`.
+    Index m_loopWorkerCount = 0;
+    uint64_t m_loopGeneration = 0;
+    Index m_busyWorkerCount = 0;
+    bool m_isShuttingDown = false;
+};
+
+} // namespace Slang
+
+#endif
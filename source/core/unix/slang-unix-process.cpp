@@ -1,5 +1,6 @@
 // slang-unix-process.cpp
 #include "core/slang-common.h"
+#include "core/slang-local-socket.h"
 #include "core/slang-memory-arena.h"
 #include "core/slang-process.h"
 #include "core/slang-string-escape-util.h"
@@ -15,8 +16,10 @@
 #include <poll.h>
 #include <signal.h>
 #include <spawn.h>
+#include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/un.h>
 #include <sys/wait.h>
 #include <time.h>
 #include <unistd.h>
@@ -66,8 +69,8 @@ public:
     virtual void close() SLANG_OVERRIDE;
     virtual SlangResult flush() SLANG_OVERRIDE;
 
-    UnixPipeStream(int fd, FileAccess access, bool isOwned)
-        : m_fd(fd), m_access(access), m_isOwned(isOwned), m_isClosed(false)
+    UnixPipeStream(int fd, FileAccess access, bool isOwned, bool isSocket = false)
+        : m_fd(fd), m_access(access), m_isOwned(isOwned), m_isSocket(isSocket), m_isClosed(false)
     {
     }
 
@@ -90,6 +93,7 @@ protected:
 
     bool m_isClosed;     ///< If true this stream has been closed (ie cannot read/write to anymore)
     bool m_isOwned;      ///< True if m_fd is owned by this object.
+    bool m_isSocket;     ///< True if m_fd is a connected socket rather than a pipe.
     FileAccess m_access; ///< Access allowed to this stream - either Read or Write
     int m_fd;            /// The 'file descriptor' for the pipe
 };
@@ -370,6 +374,32 @@ SlangResult UnixPipeStream::write(const void* buffer, size_t length)
         return SLANG_FAIL;
     }
 
+    if (m_isSocket)
+    {
+        // A peer that has gone away must fail the write, rather than raise SIGPIPE and end the
+        // process. A socket write can also be cut short, so keep going until it's all sent.
+        const char* cur = (const char*)buffer;
+        while (length > 0)
+        {
+#ifdef MSG_NOSIGNAL
+            const ssize_t sendResult = ::send(m_fd, cur, length, MSG_NOSIGNAL);
+#else
+            const ssize_t sendResult = ::send(m_fd, cur, length, 0);
+#endif
+            if (sendResult < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return SLANG_FAIL;
+            }
+            cur += sendResult;
+            length -= size_t(sendResult);
+        }
+        return SLANG_OK;
+    }
+
     const ssize_t writeResult = ::write(m_fd, buffer, length);
 
     if (writeResult < 0 || size_t(writeResult) != length)
@@ -380,6 +410,133 @@ SlangResult UnixPipeStream::write(const void* buffer, size_t length)
     return SLANG_OK;
 }
 
+/* !!!!!!!!!!!!!!!!!!!!!! LocalSocket !!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+class UnixLocalSocketListener : public LocalSocketListener
+{
+public:
+    virtual SlangResult accept(RefPtr<Stream>& outStream) SLANG_OVERRIDE;
+
+    UnixLocalSocketListener(int fd, const String& path)
+        : m_fd(fd), m_path(path)
+    {
+    }
+
+    ~UnixLocalSocketListener() SLANG_OVERRIDE
+    {
+        ::close(m_fd);
+        ::unlink(m_path.getBuffer());
+    }
+
+protected:
+    int m_fd;      ///< The listening socket
+    String m_path; ///< Where the socket is bound in the file system
+};
+
+static SlangResult _initLocalSocketAddress(const String& path, sockaddr_un& outAddress)
+{
+    memset(&outAddress, 0, sizeof(outAddress));
+    outAddress.sun_family = AF_UNIX;
+
+    // The path has to fit, along with its terminating zero.
+    if (path.getLength() <= 0 || size_t(path.getLength()) >= sizeof(outAddress.sun_path))
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+    memcpy(outAddress.sun_path, path.getBuffer(), path.getLength());
+    return SLANG_OK;
+}
+
+static void _configureLocalSocket(int fd)
+{
+    // Don't leak the socket into processes launched while it is open.
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+#ifdef SO_NOSIGPIPE
+    // Where send() has no MSG_NOSIGNAL, the socket itself has to be told not to raise SIGPIPE.
+    const int noSigPipe = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+}
+
+static SlangResult _createLocalSocket(int& outFd)
+{
+    outFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (outFd < 0)
+    {
+        return SLANG_FAIL;
+    }
+    _configureLocalSocket(outFd);
+    return SLANG_OK;
+}
+
+SlangResult UnixLocalSocketListener::accept(RefPtr<Stream>& outStream)
+{
+    for (;;)
+    {
+        const int fd = ::accept(m_fd, nullptr, nullptr);
+        if (fd >= 0)
+        {
+            _configureLocalSocket(fd);
+            outStream = new UnixPipeStream(fd, FileAccess::ReadWrite, true, true);
+            return SLANG_OK;
+        }
+        if (errno != EINTR)
+        {
+            return SLANG_FAIL;
+        }
+    }
+}
+
+/* static */ SlangResult LocalSocket::listen(
+    const String& path,
+    RefPtr<LocalSocketListener>& outListener)
+{
+    sockaddr_un address;
+    SLANG_RETURN_ON_FAIL(_initLocalSocketAddress(path, address));
+
+    // If something is still accepting at the path, don't take it over.
+    {
+        RefPtr<Stream> stream;
+        if (SLANG_SUCCEEDED(connect(path, stream)))
+        {
+            return SLANG_FAIL;
+        }
+    }
+    // Any file left at the path is from a listener that has gone away.
+    ::unlink(path.getBuffer());
+
+    int fd = -1;
+    SLANG_RETURN_ON_FAIL(_createLocalSocket(fd));
+
+    if (::bind(fd, (const sockaddr*)&address, sizeof(address)) != 0 || ::listen(fd, SOMAXCONN) != 0)
+    {
+        ::close(fd);
+        return SLANG_FAIL;
+    }
+
+    outListener = new UnixLocalSocketListener(fd, path);
+    return SLANG_OK;
+}
+
+/* static */ SlangResult LocalSocket::connect(const String& path, RefPtr<Stream>& outStream)
+{
+    sockaddr_un address;
+    SLANG_RETURN_ON_FAIL(_initLocalSocketAddress(path, address));
+
+    int fd = -1;
+    SLANG_RETURN_ON_FAIL(_createLocalSocket(fd));
+
+    if (::connect(fd, (const sockaddr*)&address, sizeof(address)) != 0)
+    {
+        ::close(fd);
+        return SLANG_E_NOT_FOUND;
+    }
+
+    outStream = new UnixPipeStream(fd, FileAccess::ReadWrite, true, true);
+    return SLANG_OK;
+}
+
 /* !!!!!!!!!!!!!!!!!!!!!! Process !!!!!!!!!!!!!!!!!!!!!!!!!!!! */
 
 /* static */ UnownedStringSlice Process::getExecutableSuffix()
@@ -653,6 +810,39 @@ SlangResult UnixPipeStream::write(const void* buffer, size_t length)
     return uint64_t(now.tv_sec) * 1000000000 + now.tv_nsec;
 }
 
+/* static */ SlangResult Process::forkDetached(bool& outIsCopy)
+{
+    outIsCopy = false;
+
+    // The copy is forked from an intermediate process that exits straight away, so it is
+    // adopted by init, which waits for it. Only the intermediate needs waiting for here.
+    const pid_t intermediatePid = fork();
+    if (intermediatePid < 0)
+    {
+        return SLANG_FAIL;
+    }
+    if (intermediatePid == 0)
+    {
+        const pid_t copyPid = fork();
+        if (copyPid != 0)
+        {
+            _exit(copyPid < 0 ? 1 : 0);
+        }
+        outIsCopy = true;
+        return SLANG_OK;
+    }
+
+    int status = 0;
+    while (waitpid(intermediatePid, &status, 0) < 0)
+    {
+        if (errno != EINTR)
+        {
+            return SLANG_FAIL;
+        }
+    }
+    return (WIFEXITED(status) && WEXITSTATUS(status) == 0) ? SLANG_OK : SLANG_FAIL;
+}
+
 /* static */ void Process::sleepCurrentThread(Int timeInMs)
 {
     struct timespec timeSpec;
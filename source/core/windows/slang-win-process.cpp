@@ -1,4 +1,5 @@
 // slang-win-process-util.cpp
+#include "core/slang-local-socket.h"
 #include "core/slang-process-util.h"
 #include "core/slang-process.h"
 #include "core/slang-string-escape-util.h"
@@ -640,6 +641,12 @@ void WinProcess::kill(int32_t returnCode)
     return SLANG_OK;
 }
 
+/* static */ SlangResult Process::forkDetached(bool& outIsCopy)
+{
+    outIsCopy = false;
+    return SLANG_E_NOT_AVAILABLE;
+}
+
 /* static */ void Process::sleepCurrentThread(Int timeInMs)
 {
     ::Sleep(DWORD(timeInMs));
@@ -671,5 +678,23 @@ uint32_t Process::getId()
     return _getpid();
 }
 
+/* !!!!!!!!!!!!!!!!!!!!!! LocalSocket !!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+/* static */ SlangResult LocalSocket::listen(
+    const String& path,
+    RefPtr<LocalSocketListener>& outListener)
+{
+    SLANG_UNUSED(path);
+    SLANG_UNUSED(outListener);
+    return SLANG_E_NOT_AVAILABLE;
+}
+
+/* static */ SlangResult LocalSocket::connect(const String& path, RefPtr<Stream>& outStream)
+{
+    SLANG_UNUSED(path);
+    SLANG_UNUSED(outStream);
+    return SLANG_E_NOT_AVAILABLE;
+}
+
 
 } // namespace Slang
@@ -371,7 +371,8 @@ public:
         int zSize,
         int subgroupSize) = 0;
     // This generates a dispatching function for a given compute entry
-    // point. It runs workgroups serially.
+    // point. It runs workgroups serially, but like the C++ target's, it can be called on disjoint
+    // ranges of workgroups from several threads at once.
     virtual SLANG_NO_THROW LLVMInst* SLANG_MCALL
     emitComputeEntryPointDispatcher(LLVMInst* workGroupFunc, CharSlice name) = 0;
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL generateAssembly(IArtifact** outArtifact) = 0;
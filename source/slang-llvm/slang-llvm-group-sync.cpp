@@ -0,0 +1,35 @@
+// The ucontext functions are only declared on macOS if XSI extensions are asked for before the
+// first system header is included.
+#if defined(__APPLE__)
+#define _XOPEN_SOURCE 600
+#define _DARWIN_C_SOURCE
+#endif
+
+#include "slang-llvm-group-sync.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Kept apart from the rest of slang-llvm, as the implementation includes platform headers that
+// don't mix with the LLVM headers.
+#include "../../prelude/slang-cpp-group-sync.h"
+
+namespace slang_llvm
+{
+
+void groupRun(uint32_t threadCount, GroupThreadFunc func, void* context)
+{
+    _slang_group_run(threadCount, func, context);
+}
+
+void groupBarrier()
+{
+    _slang_group_barrier();
+}
+
+void* groupShared(size_t size)
+{
+    return _slang_group_shared(size);
+}
+
+} // namespace slang_llvm
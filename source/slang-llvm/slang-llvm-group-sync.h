@@ -0,0 +1,18 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace slang_llvm
+{
+
+typedef void (*GroupThreadFunc)(void* context, uint32_t threadIndex);
+
+/// The functions that generated code calls to run the threads of a compute group that uses
+/// barriers or `groupshared` memory (see `prelude/slang-cpp-group-sync.h`). JIT compiled code
+/// can't include the system headers they need, so they are provided to the JIT from here.
+void groupRun(uint32_t threadCount, GroupThreadFunc func, void* context);
+void groupBarrier();
+void* groupShared(size_t size);
+
+} // namespace slang_llvm
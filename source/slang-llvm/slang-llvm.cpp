@@ -50,6 +50,7 @@
 
 #include "slang-com-helper.h"
 #include "slang-com-ptr.h"
+#include "slang-llvm-group-sync.h"
 #include "slang-llvm-jit-shared-library.h"
 #include "slang.h"
 
@@ -433,6 +434,10 @@ static uint64_t __stdcall _aulldiv(uint64_t a, uint64_t b)
     \
     x(assertFailed, assertFailed, void, (const char*)) \
     \
+    x(_slang_group_run, groupRun, void, (uint32_t, GroupThreadFunc, void*)) \
+    x(_slang_group_barrier, groupBarrier, void, ()) \
+    x(_slang_group_shared, groupShared, void*, (size_t)) \
+    \
     x(memcpy, memcpy, void*, (void*, const void*, size_t)) \
     x(memmove, memmove, void*, (void*, const void*, size_t)) \
     x(memcmp, memcmp, int, (const void*, const void*, size_t)) \
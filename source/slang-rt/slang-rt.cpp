@@ -2,6 +2,7 @@
 
 #include "core/slang-basic.h"
 #include "core/slang-shared-library.h"
+#include "core/slang-thread-pool.h"
 
 #if SLANG_WINDOWS_FAMILY
 #include <windows.h>
@@ -10,6 +11,24 @@
 using namespace Slang;
 Dictionary<String, ComPtr<ISlangSharedLibrary>> slangRT_loadedLibraries;
 
+// The varying input of a compute entry point, laid out as `ComputeVaryingInput` in the prelude.
+struct SlangRTComputeVaryingInput
+{
+    uint32_t startGroupID[3];
+    uint32_t endGroupID[3];
+};
+
+// The number of pieces each thread's share of a dispatch is cut into, so that threads that finish
+// their pieces early go on to take pieces from the others.
+static const Index kSlangRTDispatchPiecesPerThread = 8;
+
+static ThreadPool* _getDispatchThreadPool()
+{
+    // Never destroyed: joining the workers while the library is being unloaded can deadlock.
+    static ThreadPool* threadPool = new ThreadPool(0);
+    return threadPool;
+}
+
 extern "C"
 {
     SLANG_RT_API void SLANG_MCALL _slang_rt_abort(Slang::String errorMessage)
@@ -59,4 +78,53 @@ extern "C"
         }
         return (void*)funcPtr;
     }
+
+    SLANG_RT_API void SLANG_MCALL _slang_rt_dispatch_compute(
+        SlangRTComputeFunc computeFunc,
+        const uint32_t* startGroupID,
+        const uint32_t* endGroupID,
+        void* entryPointParams,
+        void* globalParams)
+    {
+        uint64_t groupCount[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            if (endGroupID[i] <= startGroupID[i])
+                return;
+            groupCount[i] = endGroupID[i] - startGroupID[i];
+        }
+
+        // Dispatches from different threads take turns on the pool.
+        ThreadPool* threadPool = _getDispatchThreadPool();
+
+        // Each piece is a run of groups along x in one row of the grid. Rows are only cut up if
+        // there are too few of them to give every thread several pieces.
+        const uint64_t rowCount = groupCount[1] * groupCount[2];
+        const uint64_t wantedPieceCount =
+            uint64_t(threadPool->getThreadCount() * kSlangRTDispatchPiecesPerThread);
+        const uint64_t piecesPerRow = Math::Clamp(
+            (wantedPieceCount + rowCount - 1) / rowCount,
+            uint64_t(1),
+            groupCount[0]);
+
+        threadPool->parallelFor(
+            Index(rowCount * piecesPerRow),
+            [&](Index index)
+            {
+                const uint64_t row = uint64_t(index) / piecesPerRow;
+                const uint64_t piece = uint64_t(index) % piecesPerRow;
+
+                SlangRTComputeVaryingInput varyingInput;
+                varyingInput.startGroupID[0] =
+                    startGroupID[0] + uint32_t(groupCount[0] * piece / piecesPerRow);
+                varyingInput.endGroupID[0] =
+                    startGroupID[0] + uint32_t(groupCount[0] * (piece + 1) / piecesPerRow);
+                varyingInput.startGroupID[1] = startGroupID[1] + uint32_t(row % groupCount[1]);
+                varyingInput.startGroupID[2] = startGroupID[2] + uint32_t(row / groupCount[1]);
+                varyingInput.endGroupID[1] = varyingInput.startGroupID[1] + 1;
+                varyingInput.endGroupID[2] = varyingInput.startGroupID[2] + 1;
+
+                computeFunc(&varyingInput, entryPointParams, globalParams);
+            });
+    }
 }
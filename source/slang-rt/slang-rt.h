@@ -22,12 +22,28 @@
 
 #define SLANG_PRELUDE_EXPORT extern "C" SLANG_PRELUDE_SHARED_LIB_EXPORT
 
+// The exported function of a CPU compute entry point that runs a range of groups. It has the
+// signature of `ComputeFunc` in the prelude, with `varyingInput` pointing at a
+// `ComputeVaryingInput`.
+typedef void (*SlangRTComputeFunc)(void* varyingInput, void* entryPointParams, void* globalParams);
+
 extern "C"
 {
     SLANG_RT_API void SLANG_MCALL _slang_rt_abort(Slang::String errorMessage);
     SLANG_RT_API void* SLANG_MCALL _slang_rt_load_dll(Slang::String modulePath);
     SLANG_RT_API void* SLANG_MCALL
     _slang_rt_load_dll_func(void* moduleHandle, Slang::String modulePath, uint32_t argSize);
+
+    // Run the groups from `startGroupID` up to (but not including) `endGroupID` of a compute
+    // entry point, split across a pool of threads. The groups are handed to `computeFunc` as
+    // smaller ranges, so it must be safe to call on disjoint ranges at the same time, as the
+    // exported functions of entry points are. Dispatches from several threads run one at a time.
+    SLANG_RT_API void SLANG_MCALL _slang_rt_dispatch_compute(
+        SlangRTComputeFunc computeFunc,
+        const uint32_t* startGroupID,
+        const uint32_t* endGroupID,
+        void* entryPointParams,
+        void* globalParams);
 }
 
 #endif
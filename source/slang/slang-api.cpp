@@ -53,17 +53,13 @@ SlangResult tryLoadBuiltinModuleFromCache(
     {
         return SLANG_FAIL;
     }
-    Slang::ScopedAllocation cacheData;
-    const void* moduleData = nullptr;
-    size_t moduleSize = 0;
-    SLANG_RETURN_ON_FAIL(Slang::BuiltinModuleCache::read(
-        cacheFileName,
-        currentLibTimestamp,
-        cacheData,
-        moduleData,
-        moduleSize));
+    // The cache is mapped rather than read, so that processes loading the same cache share
+    // its pages, and a bare module image in it is used without being copied.
+    Slang::ComPtr<ISlangBlob> moduleBlob;
     SLANG_RETURN_ON_FAIL(
-        globalSession->loadBuiltinModule(builtinModuleName, moduleData, moduleSize));
+        Slang::BuiltinModuleCache::map(cacheFileName, currentLibTimestamp, moduleBlob));
+    SLANG_RETURN_ON_FAIL(
+        Slang::asInternal(globalSession)->loadBuiltinModuleImage(builtinModuleName, moduleBlob));
     return SLANG_OK;
 }
 
@@ -137,11 +133,12 @@ SlangResult trySaveBuiltinModuleToCache(
 {
     if (dllTimestamp != 0 && cacheFilename.getLength() != 0)
     {
+        // Store a bare, uncompressed module image, which can be loaded straight from a
+        // mapping of the cache.
+        auto session = Slang::asInternal(globalSession);
         Slang::ComPtr<ISlangBlob> coreModuleBlobPtr;
-        SLANG_RETURN_ON_FAIL(globalSession->saveBuiltinModule(
-            builtinModuleName,
-            SLANG_ARCHIVE_TYPE_RIFF_LZ4,
-            coreModuleBlobPtr.writeRef()));
+        SLANG_RETURN_ON_FAIL(
+            session->saveBuiltinModuleImage(builtinModuleName, coreModuleBlobPtr.writeRef()));
 
         SLANG_RETURN_ON_FAIL(Slang::BuiltinModuleCache::write(
             cacheFilename,
@@ -2,6 +2,7 @@
 #include "slang-code-gen.h"
 
 #include "compiler-core/slang-slice-allocator.h"
+#include "core/slang-performance-profiler.h"
 #include "core/slang-type-convert-util.h"
 #include "core/slang-type-text-util.h"
 #include "slang-compiler.h"
@@ -16,6 +17,8 @@
 #include "compiler-core/slang-artifact-util.h"
 #include "slang-artifact-output-util.h"
 
+#include <optional>
+
 namespace Slang
 {
 
@@ -373,6 +376,8 @@ SlangResult CodeGenContext::emitWithDownstreamForEntryPoints(ComPtr<IArtifact>&
 
     SliceAllocator allocator;
 
+    String prelude;
+
     if (auto endToEndReq = isPassThroughEnabled())
     {
         compilerType = endToEndReq->m_passThrough;
@@ -540,6 +545,9 @@ SlangResult CodeGenContext::emitWithDownstreamForEntryPoints(ComPtr<IArtifact>&
 
         sourceLanguage = (SourceLanguage)TypeConvertUtil::getSourceLanguageFromTarget(
             (SlangCompileTarget)sourceTarget);
+
+        // Emitted source starts with the prelude for its language.
+        prelude = session->getPreludeForLanguage(sourceLanguage);
     }
 
     if (sourceArtifact)
@@ -1038,6 +1046,22 @@ SlangResult CodeGenContext::emitWithDownstreamForEntryPoints(ComPtr<IArtifact>&
         options.enablePAQ = m_targetProfile.getVersion() >= ProfileVersion::DX_6_7;
     }
 
+    // Command line compilers keep their products in the compilation cache, if there is one. That
+    // includes host callable code, which is otherwise never cached.
+    options.compileCache = getLinkage()->getCompilationCache();
+
+    // Compilers that support precompiled headers can precompile the prelude once, and reuse it for
+    // every compile of emitted source.
+    const String precompiledHeaderDirectory = getTargetProgram()->getOptionSet().getStringOption(
+        CompilerOptionName::DownstreamPrecompiledHeaderDirectory);
+    if (prelude.getLength() && precompiledHeaderDirectory.getLength())
+    {
+        options.prelude = allocator.allocate(prelude);
+        options.precompiledHeaderDirectory = allocator.allocate(precompiledHeaderDirectory);
+        options.precompiledHeaderMaxEntryCount = getTargetProgram()->getOptionSet().getIntOption(
+            CompilerOptionName::DownstreamPrecompiledHeaderMaxEntryCount);
+    }
+
     // Compile
     ComPtr<IArtifact> artifact;
     auto downstreamStartTime = std::chrono::high_resolution_clock::now();
@@ -1250,6 +1274,26 @@ SlangResult CodeGenContext::emitEntryPoints(ComPtr<IArtifact>& outArtifact)
 
     auto target = getTargetFormat();
 
+    // Tag the passes run below with what they are being run for, so that a performance trace
+    // can attribute them to an entry point and backend.
+    std::optional<PerformanceTraceContextRAII> traceTargetContext;
+    std::optional<PerformanceTraceContextRAII> traceEntryPointContext;
+    if (PerformanceTracer::getTracer()->isEnabled())
+    {
+        traceTargetContext.emplace(
+            "target",
+            TypeTextUtil::getCompileTargetName(SlangCompileTarget(target)));
+
+        StringBuilder entryPointNames;
+        for (auto entryPointIndex : getEntryPointIndices())
+        {
+            if (entryPointNames.getLength())
+                entryPointNames << ",";
+            entryPointNames << getText(getEntryPoint(entryPointIndex)->getName());
+        }
+        traceEntryPointContext.emplace("entryPoint", entryPointNames.produceString());
+    }
+
     switch (target)
     {
     case CodeGenTarget::SPIRVAssembly:
@@ -221,6 +221,15 @@ public:
 
     RequiredLoweringPassSet& getRequiredLoweringPassSet() { return m_requiredLoweringPassSet; }
 
+    /// The list that `wrapPass` appends per-pass IR statistics to when
+    /// `CompilerOptionName::ReportPassStatistics` is set, or null if statistics are not
+    /// being collected for this context.
+    List<slang::PassStatistics>* getPassStatistics() { return m_passStatistics; }
+    void setPassStatistics(List<slang::PassStatistics>* passStatistics)
+    {
+        m_passStatistics = passStatistics;
+    }
+
 protected:
     CodeGenTarget m_targetFormat = CodeGenTarget::Unknown;
     Profile m_targetProfile;
@@ -237,6 +246,8 @@ protected:
     // can be expensive.
     RequiredLoweringPassSet m_requiredLoweringPassSet;
 
+    List<slang::PassStatistics>* m_passStatistics = nullptr;
+
     /// Will output assembly as well as the artifact if appropriate for the artifact type for
     /// assembly output and conversion is possible
     void _dumpIntermediateMaybeWithAssembly(IArtifact* artifact);
@@ -510,6 +510,9 @@ void FrontEndCompileRequest::checkAllTranslationUnits()
         if (translationUnit->isChecked)
             continue;
 
+        PerformanceTraceContextRAII traceModuleContext(
+            "module",
+            getText(translationUnit->moduleName));
         checkTranslationUnit(translationUnit.Ptr(), loadedModules);
 
         // Add the checked module to list of loadedModules so that they can be
@@ -547,6 +550,10 @@ void FrontEndCompileRequest::generateIR()
         // * it can dump ir
         // * it can generate diagnostics
 
+        PerformanceTraceContextRAII traceModuleContext(
+            "module",
+            getText(translationUnit->moduleName));
+
         /// Generate IR for translation unit.
         RefPtr<IRModule> irModule(
             generateIRForTranslationUnit(getLinkage()->getASTBuilder(), translationUnit));
@@ -576,6 +583,10 @@ SlangResult FrontEndCompileRequest::executeActionsInner()
     SLANG_PROFILE_SECTION(frontEndExecute);
     SLANG_AST_BUILDER_RAII(getLinkage()->getASTBuilder());
 
+    // Included files are lexed once for this compile, including the modules it imports.
+    LexedSourceFileCache::CompileScope lexedSourceFileCacheScope(
+        &getLinkage()->m_lexedSourceFileCache);
+
     for (TranslationUnitRequest* translationUnit : translationUnits)
     {
         // Make sure SourceFile representation is available for all translationUnits
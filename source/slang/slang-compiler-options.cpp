@@ -341,6 +341,7 @@ void CompilerOptionSet::writeCommandLineArgs(Session* globalSession, StringBuild
         case CompilerOptionName::PreserveParameters:
         case CompilerOptionName::Obfuscate:
         case CompilerOptionName::IncompleteLibrary:
+        case CompilerOptionName::LazyIRDeserialization:
         case CompilerOptionName::EnableExperimentalDynamicDispatch:
         case CompilerOptionName::GenerateWholeProgram:
         case CompilerOptionName::UseMSVCStyleBitfieldPacking:
@@ -408,6 +409,32 @@ void CompilerOptionSet::buildHash(DigestBuilder<SHA1>& builder)
         if (key == CompilerOptionName::UseUpToDateBinaryModule)
             continue;
 
+        // The compilation cache location and size only decide where generated code is looked up
+        // and stored. Hashing them would make the same program miss when the cache is moved or
+        // resized, and the cache key itself is built from this digest.
+        if (key == CompilerOptionName::CompilationCacheDirectory ||
+            key == CompilerOptionName::CompilationCacheMaxEntryCount)
+            continue;
+
+        // Where a performance trace is written has no effect on the generated code.
+        if (key == CompilerOptionName::PerfTraceOutput)
+            continue;
+
+        // Deserializing module IR on demand reads in exactly the same IR as loading it up
+        // front, and like `UseUpToDateBinaryModule` the option is set by the loader, so hashing
+        // it would keep precompiled modules from matching their baked digest.
+        if (key == CompilerOptionName::LazyIRDeserialization)
+            continue;
+
+        // Generating code on more threads produces the same code.
+        if (key == CompilerOptionName::CodeGenThreadCount)
+            continue;
+
+        // A precompiled prelude is compiled to the same code as the prelude it is made from.
+        if (key == CompilerOptionName::DownstreamPrecompiledHeaderDirectory ||
+            key == CompilerOptionName::DownstreamPrecompiledHeaderMaxEntryCount)
+            continue;
+
         auto values = options.tryGetValue(key);
         builder.append(key);
         builder.append(values->getCount());
@@ -108,6 +108,10 @@ Module::precompileForTarget(SlangCompileTarget target, slang::IBlob** outDiagnos
     auto linkage = getLinkage();
     auto builder = IRBuilder(module);
 
+    // The functions of the module are inspected and decorated below, so their bodies must
+    // all be present if the module was deserialized lazily.
+    module->materializeAll();
+
     DiagnosticSink sink(linkage->getSourceManager(), Lexer::sourceLocationLexer);
     applySettingsToDiagnosticSink(&sink, &sink, linkage->m_optionSet);
     applySettingsToDiagnosticSink(&sink, &sink, m_optionSet);
@@ -6,6 +6,7 @@
 #include "core/slang-type-text-util.h"
 #include "core/slang-writer.h"
 #include "slang-emit-source-writer.h"
+#include "slang-ir-call-graph.h"
 #include "slang-ir-clone.h"
 #include "slang-ir-util.h"
 #include "slang-rich-diagnostics.h"
@@ -1425,6 +1426,30 @@ bool CPPSourceEmitter::tryEmitInstStmtImpl(IRInst* inst)
             m_writer->emit(");\n");
             return true;
         }
+    case kIROp_Var:
+        {
+            // The storage of a `groupshared` variable is shared by the threads of a group, so it
+            // comes from `_slang_group_run` (see `slang-cpp-group-sync.h`) rather than the stack,
+            // and the variable is a reference to it.
+            auto var = cast<IRVar>(inst);
+            if (var->getDataType()->getAddressSpace() != AddressSpace::GroupShared)
+                return false;
+
+            auto valueType = var->getDataType()->getValueType();
+            const String name = getName(var);
+            StringSliceLoc nameAndLoc(name.getUnownedSlice());
+            NameDeclaratorInfo nameDeclarator(&nameAndLoc);
+            RefDeclaratorInfo refDeclarator(&nameDeclarator);
+            _emitType(valueType, &refDeclarator);
+
+            m_writer->emit(" = *(");
+            PtrDeclaratorInfo ptrDeclarator(nullptr);
+            _emitType(valueType, &ptrDeclarator);
+            m_writer->emit(")_slang_group_shared(sizeof(");
+            emitType(valueType);
+            m_writer->emit("));\n");
+            return true;
+        }
     default:
         return false;
     }
@@ -1897,6 +1922,18 @@ bool CPPSourceEmitter::tryEmitInstExprImpl(IRInst* inst, const EmitOpInfo& inOut
     }
 }
 
+void CPPSourceEmitter::emitFrontMatterImpl(TargetRequest* targetReq)
+{
+    Super::emitFrontMatterImpl(targetReq);
+
+    // The group sync support needs system headers, and on macOS it needs XSI extensions enabled
+    // before the first of them, so the prelude only brings it in for code that uses it.
+    if (m_usesGroupSync)
+    {
+        m_writer->emit("#define SLANG_PRELUDE_GROUP_SYNC 1\n\n");
+    }
+}
+
 void CPPSourceEmitter::emitPreModuleImpl()
 {
     if (m_target == CodeGenTarget::CPPSource || m_target == CodeGenTarget::CPPHeader)
@@ -2282,6 +2319,119 @@ void CPPSourceEmitter::_emitEntryPointGroupRange(
         m_writer->emit("}\n");
     }
 }
+
+void CPPSourceEmitter::_emitEntryPointGroupThread(
+    const Int sizeAlongAxis[kThreadGroupAxisCount],
+    const String& funcName)
+{
+    // Runs one thread of a group for `_slang_group_run`, which numbers the threads with x varying
+    // fastest.
+    StringBuilder builder;
+    builder << "static void " << funcName << "_GroupThread(void* context, uint32_t threadIndex)\n";
+    m_writer->emit(builder);
+    m_writer->emit("{\n");
+    m_writer->indent();
+
+    m_writer->emit(
+        "ComputeGroupThreadContext* groupContext = (ComputeGroupThreadContext*)context;\n");
+    m_writer->emit("ComputeThreadVaryingInput threadInput = groupContext->threadInput;\n");
+
+    Int threadCount = 1;
+    for (int i = 0; i < kThreadGroupAxisCount; ++i)
+    {
+        threadCount *= sizeAlongAxis[i];
+    }
+
+    Int stride = 1;
+    for (int i = 0; i < kThreadGroupAxisCount; ++i)
+    {
+        const Int size = sizeAlongAxis[i];
+        if (size <= 1)
+        {
+            continue;
+        }
+
+        const char elem[2] = {s_xyzwNames[i], 0};
+        builder.clear();
+        builder << "threadInput.groupThreadID." << elem << " += threadIndex";
+        if (stride > 1)
+        {
+            builder << " / " << stride;
+        }
+        if (stride * size < threadCount)
+        {
+            builder << " % " << size;
+        }
+        builder << ";\n";
+        m_writer->emit(builder);
+
+        stride *= size;
+    }
+
+    m_writer->emit("_");
+    m_writer->emit(funcName);
+    m_writer->emit(
+        "(&threadInput, groupContext->entryPointParams, groupContext->globalParams);\n");
+
+    m_writer->dedent();
+    m_writer->emit("}\n");
+}
+
+bool CPPSourceEmitter::_isGroupSyncFunc(IRFunc* func)
+{
+    UnownedStringSlice intrinsicDefinition;
+    IRInst* intrinsicInst = nullptr;
+    if (findTargetIntrinsicDefinition(func, intrinsicDefinition, intrinsicInst))
+    {
+        return intrinsicDefinition.indexOf(toSlice("_slang_group_barrier")) >= 0;
+    }
+
+    for (auto block : func->getBlocks())
+    {
+        for (auto inst : block->getChildren())
+        {
+            auto var = as<IRVar>(inst);
+            if (var && var->getDataType()->getAddressSpace() == AddressSpace::GroupShared)
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void CPPSourceEmitter::_findGroupSyncEntryPoints(
+    IRModule* module,
+    HashSet<IRFunc*>& outEntryPoints)
+{
+    Dictionary<IRInst*, HashSet<IRFunc*>> referencingEntryPoints;
+    bool hasReferenceGraph = false;
+
+    for (auto globalInst : module->getGlobalInsts())
+    {
+        auto func = as<IRFunc>(globalInst);
+        if (!func || !_isGroupSyncFunc(func))
+        {
+            continue;
+        }
+        m_usesGroupSync = true;
+
+        // Most modules have no barriers, so only work out what calls what when one is found.
+        if (!hasReferenceGraph)
+        {
+            buildEntryPointReferenceGraph(referencingEntryPoints, module);
+            hasReferenceGraph = true;
+        }
+        if (auto entryPoints = getReferencingEntryPoints(referencingEntryPoints, func))
+        {
+            for (auto entryPoint : *entryPoints)
+            {
+                outEntryPoints.add(entryPoint);
+            }
+        }
+    }
+}
+
 void CPPSourceEmitter::_emitInitAxisValues(
     const Int sizeAlongAxis[kThreadGroupAxisCount],
     const UnownedStringSlice& mulName,
@@ -2394,6 +2544,9 @@ void CPPSourceEmitter::emitModuleImpl(IRModule* module, DiagnosticSink* sink)
 
     // Finally we need to output dll entry points
 
+    HashSet<IRFunc*> groupSyncEntryPoints;
+    _findGroupSyncEntryPoints(module, groupSyncEntryPoints);
+
     for (auto action : actions)
     {
         if (action.level == EmitAction::Level::Definition && _isFunction(action.inst->getOp()))
@@ -2431,6 +2584,14 @@ void CPPSourceEmitter::emitModuleImpl(IRModule* module, DiagnosticSink* sink)
                     continue;
                 }
 
+                // The threads of a group that uses barriers or `groupshared` memory run together
+                // with `_slang_group_run`, which calls back into a function that runs one thread.
+                const bool isGroupSync = groupSyncEntryPoints.contains(func);
+                if (isGroupSync)
+                {
+                    _emitEntryPointGroupThread(groupThreadSize, funcName);
+                }
+
                 {
                     StringBuilder builder;
                     builder << funcName << "_Thread";
@@ -2442,9 +2603,23 @@ void CPPSourceEmitter::emitModuleImpl(IRModule* module, DiagnosticSink* sink)
                         threadFuncName,
                         UnownedStringSlice::fromLiteral("ComputeThreadVaryingInput"));
 
-                    m_writer->emit("_");
-                    m_writer->emit(funcName);
-                    m_writer->emit("(varyingInput, entryPointParams, globalParams);\n");
+                    if (isGroupSync)
+                    {
+                        // A group of just this thread, so it still has `groupshared` storage.
+                        m_writer->emit("ComputeGroupThreadContext groupContext = {};\n");
+                        m_writer->emit("groupContext.threadInput = *varyingInput;\n");
+                        m_writer->emit("groupContext.entryPointParams = entryPointParams;\n");
+                        m_writer->emit("groupContext.globalParams = globalParams;\n");
+                        m_writer->emit("_slang_group_run(1, &");
+                        m_writer->emit(funcName);
+                        m_writer->emit("_GroupThread, &groupContext);\n");
+                    }
+                    else
+                    {
+                        m_writer->emit("_");
+                        m_writer->emit(funcName);
+                        m_writer->emit("(varyingInput, entryPointParams, globalParams);\n");
+                    }
 
                     _emitEntryPointDefinitionEnd(func);
                 }
@@ -2462,14 +2637,41 @@ void CPPSourceEmitter::emitModuleImpl(IRModule* module, DiagnosticSink* sink)
                         groupFuncName,
                         UnownedStringSlice::fromLiteral("ComputeVaryingInput"));
 
-                    m_writer->emit("ComputeThreadVaryingInput threadInput = {};\n");
-                    m_writer->emit("threadInput.groupID = varyingInput->startGroupID;\n");
+                    if (isGroupSync)
+                    {
+                        Int threadCount = 1;
+                        for (auto size : groupThreadSize)
+                        {
+                            threadCount *= size;
+                        }
+
+                        m_writer->emit("ComputeGroupThreadContext groupContext = {};\n");
+                        m_writer->emit(
+                            "groupContext.threadInput.groupID = varyingInput->startGroupID;\n");
+                        m_writer->emit("groupContext.entryPointParams = entryPointParams;\n");
+                        m_writer->emit("groupContext.globalParams = globalParams;\n");
+
+                        StringBuilder runBuilder;
+                        runBuilder << "_slang_group_run(" << threadCount << ", &" << funcName
+                                   << "_GroupThread, &groupContext);\n";
+                        m_writer->emit(runBuilder);
+                    }
+                    else
+                    {
+                        m_writer->emit("ComputeThreadVaryingInput threadInput = {};\n");
+                        m_writer->emit("threadInput.groupID = varyingInput->startGroupID;\n");
 
-                    _emitEntryPointGroup(groupThreadSize, funcName);
+                        _emitEntryPointGroup(groupThreadSize, funcName);
+                    }
                     _emitEntryPointDefinitionEnd(func);
                 }
 
                 // Emit the main version - which takes a dispatch size
+                //
+                // The groups in the range run one after another. Every invocation sets up its own
+                // `KernelContext`, so calls on disjoint ranges share nothing but the resources
+                // they are passed, and a host can split a dispatch across threads by calling this
+                // on parts of the range at once (as `_slang_rt_dispatch_compute` does).
                 {
                     _emitEntryPointDefinitionStart(
                         func,
@@ -67,6 +67,7 @@ protected:
     virtual bool tryEmitInstStmtImpl(IRInst* inst) SLANG_OVERRIDE;
     virtual void emitTempModifiers(IRInst* temp) SLANG_OVERRIDE;
 
+    virtual void emitFrontMatterImpl(TargetRequest* targetReq) SLANG_OVERRIDE;
     virtual void emitPreModuleImpl() SLANG_OVERRIDE;
     virtual void emitSimpleValueImpl(IRInst* value) SLANG_OVERRIDE;
     virtual void emitSimpleFuncParamImpl(IRParam* param) SLANG_OVERRIDE;
@@ -134,6 +135,14 @@ protected:
     void _emitEntryPointGroupRange(
         const Int sizeAlongAxis[kThreadGroupAxisCount],
         const String& funcName);
+    void _emitEntryPointGroupThread(
+        const Int sizeAlongAxis[kThreadGroupAxisCount],
+        const String& funcName);
+
+    /// True if `func` is a group barrier, or has `groupshared` storage
+    bool _isGroupSyncFunc(IRFunc* func);
+    /// Find the entry points whose threads have to run together with `_slang_group_run`
+    void _findGroupSyncEntryPoints(IRModule* module, HashSet<IRFunc*>& outEntryPoints);
 
     void _emitInitAxisValues(
         const Int sizeAlongAxis[kThreadGroupAxisCount],
@@ -164,6 +173,10 @@ protected:
     List<IRWitnessTable*> pendingWitnessTableDefinitions;
 
     bool m_hasString = false;
+
+    // True if any function uses a group barrier or `groupshared` storage, in which case the
+    // prelude has to provide `slang-cpp-group-sync.h`.
+    bool m_usesGroupSync = false;
 };
 
 } // namespace Slang
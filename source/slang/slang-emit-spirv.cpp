@@ -14,9 +14,11 @@
 #include "slang-ir-util.h"
 #include "slang-ir.h"
 #include "slang-lookup-spirv.h"
+#include "slang-pass-wrapper.h"
 #include "slang-rich-diagnostics.h"
 #include "spirv/unified1/spirv.h"
 
+#include <optional>
 #include <type_traits>
 
 namespace Slang
@@ -136,8 +138,12 @@ public:
     /// Add an instruction to the end of the list of children
     void addInst(SpvInst* inst);
 
-    /// Dump all children, recursively, to a flattened list of SPIR-V words
-    void dumpTo(List<SpvWord>& ioWords);
+    /// The number of words that `writeTo` writes for all children, recursively
+    Index getWordCount();
+
+    /// Write all children, recursively, as flattened SPIR-V words starting at `ioCursor`,
+    /// which must have room for `getWordCount()` words. Advances `ioCursor` past them.
+    void writeTo(SpvWord*& ioCursor);
 
     /// The first child, if any.
     SpvInst* m_firstChild = nullptr;
@@ -211,8 +217,11 @@ struct SpvInst : SpvInstParent
     /// The result <id> produced by this instruction, or zero if it has no result.
     SpvWord id = 0;
 
-    /// Dump the instruction (and any children, recursively) into the flat array of SPIR-V words.
-    void dumpTo(List<SpvWord>& ioWords)
+    /// The number of words the instruction and its children, recursively, take.
+    Index getWordCount() { return 1 + Index(operandWordsCount) + SpvInstParent::getWordCount(); }
+
+    /// Write the instruction (and any children, recursively) as flat SPIR-V words.
+    void writeTo(SpvWord*& ioCursor)
     {
         // [2.2: Terms]
         //
@@ -227,11 +236,15 @@ struct SpvInst : SpvInstParent
         // > Opcode: The 16 high-order bits are the WordCount of the instruction.
         // >         The 16 low-order bits are the opcode enumerant.
         //
-        ioWords.add(wordCount << 16 | opcode);
+        *ioCursor++ = wordCount << 16 | opcode;
 
         // The operand words simply follow the opcode word.
         //
-        ioWords.addRange(operandWords, operandWordsCount);
+        if (operandWordsCount)
+        {
+            memcpy(ioCursor, operandWords, operandWordsCount * sizeof(SpvWord));
+            ioCursor += operandWordsCount;
+        }
 
         // In our representation choice, the children of a
         // parent instruction will always follow the encoded
@@ -240,7 +253,7 @@ struct SpvInst : SpvInstParent
         // * The instructions inside a function always follow the `OpFunction`
         // * The instructions inside a block always follow the `OpLabel`
         //
-        SpvInstParent::dumpTo(ioWords);
+        SpvInstParent::writeTo(ioCursor);
     }
 
     void removeFromParent()
@@ -310,11 +323,21 @@ void SpvInstParent::addInst(SpvInst* inst)
     m_lastChild = inst;
 }
 
-void SpvInstParent::dumpTo(List<SpvWord>& ioWords)
+Index SpvInstParent::getWordCount()
 {
+    Index wordCount = 0;
     for (auto child = m_firstChild; child; child = child->nextSibling)
     {
-        child->dumpTo(ioWords);
+        wordCount += child->getWordCount();
+    }
+    return wordCount;
+}
+
+void SpvInstParent::writeTo(SpvWord*& ioCursor)
+{
+    for (auto child = m_firstChild; child; child = child->nextSibling)
+    {
+        child->writeTo(ioCursor);
     }
 }
 
@@ -517,28 +540,38 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
     // so we will eventually flatten `m_sections` into a single array.
 
     /// The final array of SPIR-V words that defines the encoded module
-    List<SpvWord> m_words;
-
     /// Emit the concrete words that make up the binary SPIR-V module.
     ///
-    /// This function fills in `m_words` based on the data in `m_sections`.
+    /// This function fills in `outSpirv` based on the data in `m_sections`.
+    /// The size of the module is worked out first, so that the words can be written
+    /// in place without growing or copying an intermediate buffer.
     /// This function should only be called once.
     ///
-    void emitPhysicalLayout()
+    void emitPhysicalLayout(List<uint8_t>& outSpirv)
     {
+        const Index kHeaderWordCount = 5;
+        Index wordCount = kHeaderWordCount;
+        for (int ii = 0; ii < int(SpvLogicalSectionID::Count); ++ii)
+        {
+            wordCount += m_sections[ii].getWordCount();
+        }
+
+        outSpirv.setCount(wordCount * Index(sizeof(SpvWord)));
+        SpvWord* cursor = reinterpret_cast<SpvWord*>(outSpirv.getBuffer());
+
         // [2.3: Physical Layout of a SPIR-V Module and Instruction]
         //
         // > Magic Number
         //
-        m_words.add(SpvMagicNumber);
+        *cursor++ = SpvMagicNumber;
 
         // > Version nuumber
         //
-        m_words.add(m_spvVersion);
+        *cursor++ = m_spvVersion;
 
         // > Generator's magic number.
         //
-        m_words.add(kSPIRVSlangCompilerId);
+        *cursor++ = kSPIRVSlangCompilerId;
 
         // > Bound
         //
@@ -546,11 +579,11 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
         // <id>s, so its value when we are done emitting code
         // can serve as the bound.
         //
-        m_words.add(m_nextID);
+        *cursor++ = m_nextID;
 
         // > 0 (Reserved for instruction schema, if needed.)
         //
-        m_words.add(0);
+        *cursor++ = 0;
 
         // > First word of instruction stream
         // > All remaining words are a linear sequence of instructions.
@@ -560,8 +593,21 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
         //
         for (int ii = 0; ii < int(SpvLogicalSectionID::Count); ++ii)
         {
-            m_sections[ii].dumpTo(m_words);
+            m_sections[ii].writeTo(cursor);
         }
+        SLANG_ASSERT(cursor == reinterpret_cast<SpvWord*>(outSpirv.getBuffer()) + wordCount);
+    }
+
+    /// The memory the emitter holds on to for the instructions it has built: the instructions
+    /// and their operands, and the maps from IR instructions to them.
+    size_t calcMemoryUsed()
+    {
+        size_t bytes = m_memoryArena.calcTotalMemoryUsed();
+        bytes += size_t(m_mapIRInstToSpvInst.getCount()) * (sizeof(IRInst*) + sizeof(SpvInst*));
+        bytes += size_t(m_mapIRInstToSpvID.getCount()) * (sizeof(IRInst*) + sizeof(SpvWord));
+        bytes +=
+            size_t(m_mapIRInstToSpvDebugInst.getCount()) * (sizeof(IRInst*) + sizeof(SpvInst*));
+        return bytes;
     }
 
     // We will often need to refer to an instrcition by its
@@ -733,6 +779,9 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
     /// Holds memory for instructions and operands.
     MemoryArena m_memoryArena;
 
+    /// Block size for `m_memoryArena`, large enough that most modules only need a few blocks.
+    static const size_t kMemoryArenaBlockSize = 16 * 1024;
+
     /// Begin emitting an instruction with the given SPIR-V `opcode`.
     ///
     /// If `irInst` is non-null, then the resulting SPIR-V instruction
@@ -12107,7 +12156,9 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
     }
 
     SPIRVEmitContext(IRModule* module, TargetProgram* program, DiagnosticSink* sink)
-        : SPIRVEmitSharedContext(module, program, sink), m_irModule(module), m_memoryArena(2048)
+        : SPIRVEmitSharedContext(module, program, sink)
+        , m_irModule(module)
+        , m_memoryArena(kMemoryArenaBlockSize)
     {
     }
 };
@@ -12139,6 +12190,13 @@ SlangResult emitSPIRVFromIR(
     SPIRVEmitContext context(irModule, codeGenContext->getTargetProgram(), sink);
     legalizeIRForSPIRV(&context, irModule, irEntryPoints, codeGenContext);
 
+    std::optional<PassStatisticsSnapshot> statisticsSnapshot;
+    if (codeGenContext->getPassStatistics())
+    {
+        statisticsSnapshot.emplace();
+        beginPassStatistics(irModule, *statisticsSnapshot);
+    }
+
 #if 0
     {
         DiagnosticSinkWriter writer(codeGenContext->getSink());
@@ -12298,11 +12356,19 @@ SlangResult emitSPIRVFromIR(
 
     context.emitFrontMatter();
 
-    context.emitPhysicalLayout();
+    context.emitPhysicalLayout(spirvOut);
 
-    spirvOut.addRange(
-        (uint8_t const*)context.m_words.getBuffer(),
-        context.m_words.getCount() * Index(sizeof(context.m_words[0])));
+    if (statisticsSnapshot)
+    {
+        // The emitter's own memory is only released once it is done, so what it holds now
+        // together with the output is its peak.
+        endPassStatistics(
+            codeGenContext,
+            irModule,
+            "emitSPIRV",
+            *statisticsSnapshot,
+            context.calcMemoryUsed() + size_t(spirvOut.getCount()));
+    }
 
     return SLANG_OK;
 }
@@ -1018,6 +1018,9 @@ Result linkAndOptimizeIR(
     auto metadata = new ArtifactPostEmitMetadata;
     outLinkedIR.metadata = metadata;
 
+    if (targetCompilerOptions.getBoolOption(CompilerOptionName::ReportPassStatistics))
+        codeGenContext->setPassStatistics(&metadata->m_passStatistics);
+
     // For now, only emit the debug build identifier if separate debug info is enabled
     // and only if there are targets.
     // TODO: We will ultimately need to change this to always emit the instruction.
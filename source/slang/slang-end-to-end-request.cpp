@@ -4,6 +4,9 @@
 #include "compiler-core/slang-pretty-writer.h"
 #include "core/slang-memory-file-system.h"
 #include "core/slang-performance-profiler.h"
+#include "core/slang-string-escape-util.h"
+#include "core/slang-thread-pool.h"
+#include "core/slang-type-text-util.h"
 #include "slang-check-impl.h"
 #include "slang-compiler.h"
 #include "slang-emit-dependency-file.h"
@@ -606,6 +609,64 @@ SlangResult EndToEndCompileRequest::_maybeWriteCoverageManifest(
     return writeResult;
 }
 
+SlangResult EndToEndCompileRequest::_maybeWritePassStatistics()
+{
+    if (m_passStatisticsOutputPath.getLength() == 0)
+        return SLANG_OK;
+
+    auto handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
+
+    StringBuilder json;
+    json << "{\n  \"outputs\": [";
+
+    List<ExistingOutputArtifact> outputArtifacts;
+    _collectExistingOutputArtifacts(outputArtifacts);
+    bool isFirstOutput = true;
+    for (const auto& outputArtifact : outputArtifacts)
+    {
+        auto statistics =
+            findAssociatedRepresentation<slang::IPassStatisticsMetadata>(outputArtifact.artifact);
+        if (!statistics)
+            continue;
+
+        json << (isFirstOutput ? "\n" : ",\n");
+        isFirstOutput = false;
+
+        auto target = outputArtifact.targetProgram->getTargetReq()->getTarget();
+        json << "    {\n      \"path\": ";
+        StringEscapeUtil::appendQuoted(handler, outputArtifact.path.getUnownedSlice(), json);
+        json << ",\n      \"target\": ";
+        StringEscapeUtil::appendQuoted(
+            handler,
+            TypeTextUtil::getCompileTargetName(asExternal(target)),
+            json);
+        json << ",\n      \"passes\": [";
+
+        const SlangUInt passCount = statistics->getPassStatisticsCount();
+        for (SlangUInt i = 0; i < passCount; ++i)
+        {
+            slang::PassStatistics pass;
+            SLANG_RETURN_ON_FAIL(statistics->getPassStatisticsByIndex(i, &pass));
+
+            json << (i == 0 ? "\n" : ",\n");
+            json << "        {\"name\": ";
+            StringEscapeUtil::appendQuoted(handler, UnownedStringSlice(pass.passName), json);
+            json << ", \"instCountBefore\": " << pass.instCountBefore;
+            json << ", \"instCountAfter\": " << pass.instCountAfter;
+            json << ", \"instsCreated\": " << pass.instsCreated;
+            json << ", \"instsRemoved\": " << pass.instsRemoved;
+            json << ", \"bytesAllocated\": " << pass.bytesAllocated << "}";
+        }
+        json << "\n      ]\n    }";
+    }
+    json << "\n  ]\n}\n";
+
+    const SlangResult writeResult = File::writeAllText(m_passStatisticsOutputPath, json);
+    if (SLANG_FAILED(writeResult))
+        getSink()->diagnose(Diagnostics::UnableToWriteFile{.path = m_passStatisticsOutputPath});
+    return writeResult;
+}
+
 SlangResult EndToEndCompileRequest::_maybeWriteArtifact(const String& path, IArtifact* artifact)
 {
     // We don't have to do anything if there is no artifact
@@ -1151,16 +1212,119 @@ void EndToEndCompileRequest::generateOutput(ComponentType* program)
     // has specified, and generate code for each of them.
     //
     auto linkage = getLinkage();
+    List<TargetProgram*> targetPrograms;
     for (auto targetReq : linkage->targets)
     {
         if (targetReq->getOptionSet().getBoolOption(CompilerOptionName::EmbedDownstreamIR))
             continue;
 
-        auto targetProgram = program->getTargetProgram(targetReq);
+        targetPrograms.add(program->getTargetProgram(targetReq));
+    }
+
+    const Index threadCount = getOptionSet().getIntOption(CompilerOptionName::CodeGenThreadCount);
+    if (threadCount > 1)
+    {
+        _generateOutputInParallel(targetPrograms, threadCount);
+        return;
+    }
+
+    for (auto targetProgram : targetPrograms)
+    {
         generateOutput(targetProgram);
     }
 }
 
+void EndToEndCompileRequest::_generateOutputInParallel(
+    List<TargetProgram*> const& targetPrograms,
+    Index threadCount)
+{
+    auto sink = getSink();
+
+    // Each task generates the code for one entry point of one target, or
+    // for the whole program of a target that is compiled that way.
+    //
+    struct CodeGenTask
+    {
+        TargetProgram* targetProgram;
+        Index entryPointIndex; ///< -1 for the whole program
+    };
+    List<CodeGenTask> tasks;
+    for (auto targetProgram : targetPrograms)
+    {
+        // The layout of a target is shared by all of its tasks, and computing
+        // it is front-end work, so it is done here on the calling thread.
+        //
+        targetProgram->getOrCreateLayout(sink);
+
+        if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::GenerateWholeProgram))
+        {
+            tasks.add(CodeGenTask{targetProgram, -1});
+            continue;
+        }
+        auto entryPointCount = targetProgram->getProgram()->getEntryPointCount();
+        for (Index ii = 0; ii < entryPointCount; ++ii)
+        {
+            tasks.add(CodeGenTask{targetProgram, ii});
+        }
+    }
+    if (sink->getErrorCount() != 0)
+        return;
+
+    // Every task reports into a sink of its own. The sinks are forwarded in
+    // task order once all tasks are done, so diagnostics come out the same
+    // as for a serial compile, whichever thread ran each task.
+    //
+    List<String> taskDiagnostics;
+    List<bool> taskHasErrors;
+    taskDiagnostics.setCount(tasks.getCount());
+    taskHasErrors.setCount(tasks.getCount());
+
+    // The tasks share this request, but code generation only reads it: the pass-through
+    // mode, the translation units of a pass-through compile, the macro defines and the IR
+    // dump options. Nothing here may write to the request until all tasks are done.
+    //
+    RefPtr<ThreadPool> threadPool = getSession()->getCodeGenThreadPool(threadCount);
+    threadPool->parallelFor(
+        tasks.getCount(),
+        [&](Index taskIndex)
+        {
+            auto& task = tasks[taskIndex];
+            DiagnosticSink taskSink(sink->getSourceManager(), Lexer::sourceLocationLexer, sink);
+            try
+            {
+                if (task.entryPointIndex < 0)
+                    task.targetProgram->_createWholeProgramResult(&taskSink, this);
+                else
+                    task.targetProgram->_createEntryPointResult(
+                        task.entryPointIndex,
+                        &taskSink,
+                        this);
+            }
+            catch (const AbortCompilationException&)
+            {
+                // The fatal diagnostic has already been written to the task's sink.
+            }
+            catch (const Exception& e)
+            {
+                taskSink.diagnose(Diagnostics::CompilationAbortedDueToException{
+                    .exceptionType = typeid(e).name(),
+                    .exceptionMessage = e.Message});
+            }
+            taskDiagnostics[taskIndex] = taskSink.outputBuffer.produceString();
+            taskHasErrors[taskIndex] = taskSink.getErrorCount() != 0;
+        },
+        threadCount);
+
+    for (Index ii = 0; ii < tasks.getCount(); ++ii)
+    {
+        if (taskDiagnostics[ii].getLength() == 0)
+            continue;
+        sink->diagnoseRaw(
+            taskHasErrors[ii] ? Severity::Error : Severity::Warning,
+            taskDiagnostics[ii].getUnownedSlice());
+    }
+}
+
 void EndToEndCompileRequest::generateOutput()
 {
     SLANG_PROFILE;
@@ -1238,6 +1402,8 @@ void EndToEndCompileRequest::generateOutput()
         maybeWriteContainer(m_containerOutputPath);
 
         writeDependencyFile(this);
+
+        _maybeWritePassStatistics();
     }
 }
 
@@ -1908,6 +2074,12 @@ SlangResult EndToEndCompileRequest::compile()
         getSession()->getCompilerElapsedTime(&totalStartTime, &downstreamStartTime);
         PerformanceProfiler::getProfiler()->clear();
     }
+
+    const String perfTracePath =
+        getOptionSet().getStringOption(CompilerOptionName::PerfTraceOutput);
+    if (perfTracePath.getLength())
+        PerformanceTracer::getTracer()->acquire();
+
 #if !defined(SLANG_DEBUG_INTERNAL_ERROR)
     // By default we'd like to catch as many internal errors as possible,
     // and report them to the user nicely (rather than just crash their
@@ -1983,6 +2155,13 @@ SlangResult EndToEndCompileRequest::compile()
         getSink()->diagnose(
             Diagnostics::PerformanceBenchmarkResult{.benchmarkOutput = perfResult.produceString()});
     }
+    if (perfTracePath.getLength())
+    {
+        auto tracer = PerformanceTracer::getTracer();
+        if (SLANG_FAILED(tracer->writeToFile(perfTracePath)))
+            getSink()->diagnose(Diagnostics::UnableToWriteFile{.path = perfTracePath});
+        tracer->release();
+    }
 
     // Repro dump handling
     {
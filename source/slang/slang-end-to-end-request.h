@@ -321,6 +321,9 @@ public:
 
     String m_dependencyOutputPath;
 
+    /// Path to write the per-pass IR statistics report to (`-report-pass-statistics`).
+    String m_passStatisticsOutputPath;
+
     /// Writes the modules in a container to the stream
     SlangResult writeContainerToStream(Stream* stream);
 
@@ -423,6 +426,9 @@ private:
     /// `-coverage-manifest-output <path>` overrides that location and also works for stdout
     /// artifacts.
     SlangResult _maybeWriteCoverageManifest(const String& path, IArtifact* artifact);
+    /// Writes the `IPassStatisticsMetadata` of every output artifact as a JSON report to
+    /// `m_passStatisticsOutputPath`, if one was requested.
+    SlangResult _maybeWritePassStatistics();
     SlangResult _writeArtifact(const String& path, IArtifact* artifact);
 
     /// Adds any extra settings to complete a targetRequest
@@ -433,6 +439,11 @@ private:
     void generateOutput(ComponentType* program);
     void generateOutput(TargetProgram* targetProgram);
 
+    /// Generate code for each entry point of each of `targetPrograms` as a separate task,
+    /// on `threadCount` threads of the session's code generation thread pool. The tasks
+    /// read this request concurrently and must not modify it.
+    void _generateOutputInParallel(List<TargetProgram*> const& targetPrograms, Index threadCount);
+
     void init();
 
     Session* m_session = nullptr;
@@ -4,7 +4,9 @@
 #include "compiler-core/slang-artifact-desc-util.h"
 #include "core/slang-archive-file-system.h"
 #include "core/slang-performance-profiler.h"
+#include "core/slang-riff-file-system.h"
 #include "core/slang-type-convert-util.h"
+#include "core/slang-zip-file-system.h"
 #include "slang-check-impl.h"
 #include "slang-compiler.h"
 #include "slang-doc-ast.h"
@@ -358,6 +360,17 @@ TypeCheckingCache* Session::getTypeCheckingCache()
     return static_cast<TypeCheckingCache*>(m_typeCheckingCache.get());
 }
 
+RefPtr<ThreadPool> Session::getCodeGenThreadPool(Index threadCount)
+{
+    std::lock_guard<std::mutex> lock(m_codeGenThreadPoolMutex);
+
+    // A compile still running on a replaced pool holds a reference to it, so the old
+    // pool's threads are joined once that compile is done.
+    if (!m_codeGenThreadPool || m_codeGenThreadPool->getThreadCount() < threadCount)
+        m_codeGenThreadPool = new ThreadPool(threadCount);
+    return m_codeGenThreadPool;
+}
+
 Session::BuiltinModuleInfo Session::getBuiltinModuleInfo(slang::BuiltinModuleName name)
 {
     Session::BuiltinModuleInfo result;
@@ -475,10 +488,28 @@ SlangResult Session::loadCoreModule(const void* coreModule, size_t coreModuleSiz
     return loadBuiltinModule(slang::BuiltinModuleName::Core, coreModule, coreModuleSizeInBytes);
 }
 
+// A builtin module image is either an archive holding the serialized module, or
+// the serialized module itself.
+static bool _isArchiveImage(const void* data, size_t sizeInBytes)
+{
+    return RiffFileSystem::isArchive(data, sizeInBytes) ||
+           ZipFileSystem::isArchive(data, sizeInBytes);
+}
+
 SlangResult Session::loadBuiltinModule(
     slang::BuiltinModuleName moduleName,
     const void* moduleData,
     size_t sizeInBytes)
+{
+    // An archive is copied out of as it is read, but a bare module image is used in place, so
+    // it needs a copy that outlives the caller's memory.
+    ComPtr<ISlangBlob> image = _isArchiveImage(moduleData, sizeInBytes)
+                                   ? UnownedRawBlob::create(moduleData, sizeInBytes)
+                                   : RawBlob::create(moduleData, sizeInBytes);
+    return loadBuiltinModuleImage(moduleName, image);
+}
+
+SlangResult Session::loadBuiltinModuleImage(slang::BuiltinModuleName moduleName, ISlangBlob* image)
 {
     SLANG_PROFILE;
 
@@ -493,17 +524,29 @@ SlangResult Session::loadBuiltinModule(
         return SLANG_FAIL;
     }
 
-    // Make a file system to read it from
-    ComPtr<ISlangFileSystemExt> fileSystem;
-    SLANG_RETURN_ON_FAIL(loadArchiveFileSystem(moduleData, sizeInBytes, fileSystem));
-
     // Let's try loading serialized modules and adding them
     Module* module = nullptr;
-    SLANG_RETURN_ON_FAIL(_readBuiltinModule(
-        fileSystem,
-        builtinModuleInfo.languageScope,
-        builtinModuleInfo.name,
-        module));
+    const void* imageData = image->getBufferPointer();
+    const size_t imageSize = image->getBufferSize();
+    if (_isArchiveImage(imageData, imageSize))
+    {
+        // Make a file system to read it from
+        ComPtr<ISlangFileSystemExt> fileSystem;
+        SLANG_RETURN_ON_FAIL(loadArchiveFileSystem(imageData, imageSize, fileSystem));
+        SLANG_RETURN_ON_FAIL(_readBuiltinModule(
+            fileSystem,
+            builtinModuleInfo.languageScope,
+            builtinModuleInfo.name,
+            module));
+    }
+    else
+    {
+        SLANG_RETURN_ON_FAIL(_readBuiltinModuleFromBlob(
+            image,
+            builtinModuleInfo.languageScope,
+            builtinModuleInfo.name,
+            module));
+    }
 
     if (moduleName == slang::BuiltinModuleName::Core)
     {
@@ -524,6 +567,73 @@ SlangResult Session::saveBuiltinModule(
     slang::BuiltinModuleName moduleTag,
     SlangArchiveType archiveType,
     ISlangBlob** outBlob)
+{
+    List<uint8_t> contents;
+    SLANG_RETURN_ON_FAIL(_writeBuiltinModule(moduleTag, contents));
+
+    // The serialized module will be represented as a logical
+    // file in an archive, so we create a logical file system
+    // to represent that archive.
+    //
+    ComPtr<ISlangMutableFileSystem> fileSystem;
+    SLANG_RETURN_ON_FAIL(createArchiveFileSystem(archiveType, fileSystem));
+    //
+    // The created file system must support the `IArchiveFileSystem`
+    // interface (since we created it with `createArchiveFileSystem`).
+    //
+    auto archiveFileSystem = as<IArchiveFileSystem>(fileSystem);
+    if (!archiveFileSystem)
+    {
+        return SLANG_FAIL;
+    }
+
+    // The output file name that we'll write to in that file system
+    // is just the builtin module name with a `.slang-module` suffix.
+    //
+    StringBuilder moduleFileName;
+    moduleFileName << getBuiltinModuleInfo(moduleTag).name << ".slang-module";
+
+    // Once the module has been serialized, we can write it to a file
+    // in the logical file system.
+    //
+    // TODO(tfoley): why can't the file system let us open the file for output?
+    //
+    SLANG_RETURN_ON_FAIL(fileSystem->saveFile(
+        moduleFileName.getBuffer(),
+        contents.getBuffer(),
+        contents.getCount()));
+
+    // And finally, we can ask the archive file system to serialize itself
+    // out as a blob of bytes, which yields the final serialized representation
+    // of the module.
+    //
+    SLANG_RETURN_ON_FAIL(archiveFileSystem->storeArchive(
+        // The `true` here indicates that the blob that gets created should own
+        // its content, independent from the file system object itself; otherwise
+        // the file system might return a blob that shares storage with itself.
+        true,
+        outBlob));
+
+    return SLANG_OK;
+}
+
+SlangResult Session::saveBuiltinModuleImage(
+    slang::BuiltinModuleName moduleTag,
+    ISlangBlob** outBlob)
+{
+    // The image is the serialized module itself, with no archive around it, so that
+    // `loadBuiltinModuleImage` can read it in place.
+    //
+    List<uint8_t> contents;
+    SLANG_RETURN_ON_FAIL(_writeBuiltinModule(moduleTag, contents));
+
+    *outBlob = ListBlob::moveCreate(contents).detach();
+    return SLANG_OK;
+}
+
+SlangResult Session::_writeBuiltinModule(
+    slang::BuiltinModuleName moduleTag,
+    List<uint8_t>& outContents)
 {
     // If no builtin modules have been loaded, then there is
     // nothing to save, and we fail immediately.
@@ -558,28 +668,6 @@ SlangResult Session::saveBuiltinModule(
     //
     SLANG_AST_BUILDER_RAII(m_builtinLinkage->getASTBuilder());
 
-    // The serialized module will be represented as a logical
-    // file in an archive, so we create a logical file system
-    // to represent that archive.
-    //
-    ComPtr<ISlangMutableFileSystem> fileSystem;
-    SLANG_RETURN_ON_FAIL(createArchiveFileSystem(archiveType, fileSystem));
-    //
-    // The created file system must support the `IArchiveFileSystem`
-    // interface (since we created it with `createArchiveFileSystem`).
-    //
-    auto archiveFileSystem = as<IArchiveFileSystem>(fileSystem);
-    if (!archiveFileSystem)
-    {
-        return SLANG_FAIL;
-    }
-
-    // The output file name that we'll write to in that file system
-    // is just the builtin module name with a `.slang-module` suffix.
-    //
-    StringBuilder moduleFileName;
-    moduleFileName << moduleName << ".slang-module";
-
     // The module serialization step has some options that we need
     // to configure appropriately.
     //
@@ -600,29 +688,7 @@ SlangResult Session::saveBuiltinModule(
     //
     OwnedMemoryStream stream(FileAccess::Write);
     SLANG_RETURN_ON_FAIL(SerialContainerUtil::write(module, options, &stream));
-    auto contents = stream.getContents();
-
-    // Once the stream that represents the module has been written, we can
-    // write it to a file in the logical file system.
-    //
-    // TODO(tfoley): why can't the file system let us open the file for output?
-    //
-    SLANG_RETURN_ON_FAIL(fileSystem->saveFile(
-        moduleFileName.getBuffer(),
-        contents.getBuffer(),
-        contents.getCount()));
-
-    // And finally, we can ask the archive file system to serialize itself
-    // out as a blob of bytes, which yields the final serialized representation
-    // of the module.
-    //
-    SLANG_RETURN_ON_FAIL(archiveFileSystem->storeArchive(
-        // The `true` here indicates that the blob that gets created should own
-        // its content, independent from the file system object itself; otherwise
-        // the file system might return a blob that shares storage with itself.
-        true,
-        outBlob));
-
+    stream.swapContents(outContents);
     return SLANG_OK;
 }
 
@@ -640,6 +706,15 @@ SlangResult Session::_readBuiltinModule(
     ComPtr<ISlangBlob> fileContents;
     SLANG_RETURN_ON_FAIL(fileSystem->loadFile(moduleFilename.getBuffer(), fileContents.writeRef()));
 
+    return _readBuiltinModuleFromBlob(fileContents, scope, moduleName, outModule);
+}
+
+SlangResult Session::_readBuiltinModuleFromBlob(
+    ISlangBlob* fileContents,
+    Scope* scope,
+    String moduleName,
+    Module*& outModule)
+{
     RIFF::RootChunk const* rootChunk = RIFF::RootChunk::getFromBlob(fileContents);
     if (!rootChunk)
     {
@@ -708,6 +783,10 @@ SlangResult Session::_readBuiltinModule(
     // After the AST module has been read in, we next look
     // to deserialize the IR module.
     //
+    // Builtin modules are shared by every session, which may be linking against
+    // them on several threads at once, so their IR is read in eagerly rather than
+    // having bodies materialized (and use-lists changed) during those links.
+    //
     RefPtr<IRModule> irModule;
     SLANG_RETURN_ON_FAIL(readSerializedModuleIR(irChunk, this, sourceLocReader, irModule));
 
@@ -853,6 +932,7 @@ Session::createSession(slang::SessionDesc const& inDesc, slang::ISession** outSe
     }
 
     linkage->m_optionSet.load(desc.compilerOptionEntryCount, desc.compilerOptionEntries);
+    linkage->beginPerfTrace();
 
     if (!linkage->m_optionSet.hasOption(CompilerOptionName::MatrixLayoutColumn) &&
         !linkage->m_optionSet.hasOption(CompilerOptionName::MatrixLayoutRow))
@@ -17,6 +17,7 @@
 #include "compiler-core/slang-downstream-compiler.h"
 #include "compiler-core/slang-spirv-core-grammar.h"
 #include "core/slang-command-options.h"
+#include "core/slang-thread-pool.h"
 #include "slang-pass-through.h"
 #include "slang-target.h"
 
@@ -179,6 +180,14 @@ public:
         SlangArchiveType archiveType,
         ISlangBlob** outBlob) override;
 
+    /// Load a builtin module from an archive, or from a bare module image as produced by
+    /// `saveBuiltinModuleImage`. A bare image is read in place and retained by the module, so
+    /// it can be a read-only file mapping shared between processes.
+    SlangResult loadBuiltinModuleImage(slang::BuiltinModuleName moduleName, ISlangBlob* image);
+
+    /// Serialize a builtin module as a bare module image, without an archive around it.
+    SlangResult saveBuiltinModuleImage(slang::BuiltinModuleName moduleName, ISlangBlob** outBlob);
+
     SLANG_NO_THROW SlangCapabilityID SLANG_MCALL findCapability(char const* name) override;
 
     SLANG_NO_THROW void SLANG_MCALL setDownstreamCompilerForTransition(
@@ -331,6 +340,12 @@ public:
 
     ISlangSharedLibrary* getOrLoadSlangLLVM();
 
+    /// Get the thread pool that target code is generated on, with at least `threadCount`
+    /// threads. The pool is shared by every compile on the session, and is only replaced
+    /// by a larger one when a compile asks for more threads than it has. Callers pass
+    /// `threadCount` on to `parallelFor` to use no more threads than they asked for.
+    RefPtr<ThreadPool> getCodeGenThreadPool(Index threadCount);
+
     ComPtr<ISlangSharedLibraryLoader>
         m_sharedLibraryLoader; ///< The shared library loader (never null)
 
@@ -358,6 +373,9 @@ public:
     // Backend compilation threads update and read these aggregate timing counters concurrently.
     std::mutex m_compileTimeMutex;
 
+    RefPtr<ThreadPool> m_codeGenThreadPool;
+    std::mutex m_codeGenThreadPoolMutex;
+
 private:
     struct BuiltinModuleInfo
     {
@@ -374,6 +392,14 @@ private:
         Scope* scope,
         String moduleName,
         Module*& outModule);
+    SlangResult _readBuiltinModuleFromBlob(
+        ISlangBlob* fileContents,
+        Scope* scope,
+        String moduleName,
+        Module*& outModule);
+    SlangResult _writeBuiltinModule(
+        slang::BuiltinModuleName moduleName,
+        List<uint8_t>& outContents);
 
     SlangResult _loadRequest(EndToEndCompileRequest* request, const void* data, size_t size);
 
@@ -58,6 +58,10 @@ struct IRSharedSpecContext
 
     Dictionary<ImmutableHashedString, bool> isImportedSymbol;
 
+    // Symbol lookups and choices of the best definition for the target, shared with
+    // the other links of the same program. Only set for `linkIR`.
+    RefPtr<ProgramLinkingInfo> programLinkingInfo;
+
     bool useAutodiff = false;
 
     // True only for the final per-target code-generation link (`linkIR`). It is
@@ -122,11 +126,30 @@ struct IRSpecContextBase
         RefPtr<IRSpecSymbol> symbol;
         if (shared->symbols.tryGetValue(hashedName, symbol))
             return symbol;
-        for (auto m : irModules)
+
+        // Another link of the same program may have already searched the modules for this
+        // name. Inserting the values it found in the same order gives the same symbol list.
+        List<IRInst*> values;
+        auto programLinkingInfo = shared->programLinkingInfo.get();
+        if (programLinkingInfo && programLinkingInfo->tryGetSymbols(hashedName, values))
         {
-            for (auto inst : m->findSymbolByMangledName(hashedName))
+            for (auto inst : values)
                 insertGlobalValueSymbol(shared, inst);
         }
+        else
+        {
+            for (auto m : irModules)
+            {
+                for (auto inst : m->findSymbolByMangledName(hashedName))
+                {
+                    insertGlobalValueSymbol(shared, inst);
+                    values.add(inst);
+                }
+            }
+            if (programLinkingInfo)
+                programLinkingInfo->addSymbols(hashedName, values);
+        }
+
         if (shared->symbols.tryGetValue(hashedName, symbol))
             return symbol;
         shared->symbols[hashedName] = nullptr;
@@ -1535,11 +1558,21 @@ IRInst* cloneInst(
     return clonedInst;
 }
 
+// A module loaded with lazy IR deserialization only reads in the body of a global
+// value when it is first needed, so make sure it is present before the linker
+// inspects or clones it.
+static void materializeGlobalValue(IRInst* globalValue)
+{
+    if (auto module = globalValue->getModule())
+        module->materialize(globalValue);
+}
+
 IRInst* cloneGlobalValueImpl(
     IRSpecContext* context,
     IRInst* originalInst,
     IROriginalValuesForClone const& originalValues)
 {
+    materializeGlobalValue(originalInst);
     auto clonedValue =
         cloneInst(context, &context->shared->builderStorage, originalInst, originalValues);
     clonedValue->moveToEnd();
@@ -1606,12 +1639,22 @@ IRInst* cloneGlobalValueWithLinkage(
     // more specialized for the chosen target. Otherwise, we simply favor
     // definitions over declarations.
     //
+    // The choice only depends on the target and the values found for the name, so it can be
+    // shared with the other links of the same program.
+    //
     IRInst* bestVal = nullptr;
-    for (IRSpecSymbol* ss = sym; ss; ss = ss->nextWithSameName)
+    auto programLinkingInfo = context->getShared()->programLinkingInfo.get();
+    ImmutableHashedString hashedName(mangledName);
+    if (!programLinkingInfo || !programLinkingInfo->tryGetBestValue(hashedName, bestVal))
     {
-        IRInst* newVal = ss->irGlobalValue;
-        if (isBetterForTarget(context, newVal, bestVal))
-            bestVal = newVal;
+        for (IRSpecSymbol* ss = sym; ss; ss = ss->nextWithSameName)
+        {
+            IRInst* newVal = ss->irGlobalValue;
+            if (isBetterForTarget(context, newVal, bestVal))
+                bestVal = newVal;
+        }
+        if (programLinkingInfo)
+            programLinkingInfo->addBestValue(hashedName, bestVal);
     }
 
     if (!bestVal)
@@ -1678,6 +1721,9 @@ void insertGlobalValueSymbol(IRSharedSpecContext* sharedContext, IRInst* gv)
     if (!linkage)
         return;
 
+    // Choosing between candidates looks at whether each one has a body.
+    materializeGlobalValue(gv);
+
     auto mangledName = String(linkage->getMangledName());
 
     RefPtr<IRSpecSymbol> sym = new IRSpecSymbol();
@@ -2084,6 +2130,11 @@ bool isDiffPairType(IRInst* type)
     return as<IRDifferentialPairTypeBase>(type) != nullptr;
 }
 
+static bool isTranslateOp(IROp op)
+{
+    return IRTranslateBase::isaImpl(op);
+}
+
 // Returns true if `inst` or any inst nested under it is an `IRTranslateBase`
 // (`ForwardDifferentiate`, `BackwardDifferentiatePropagate`, ...) — the
 // representation of a `fwd_diff`/`bwd_diff` request before auto-diff
@@ -2116,9 +2167,15 @@ static bool containsTranslateInst(IRInst* inst)
 // load-bearing: replacing this walk with a module-scope-children-only scan
 // fails ~240 tests under tests/autodiff/, including an ICE in DiffPair
 // lowering on tests/autodiff/no-diff-interface-subscript.slang.
+//
+// A lazily deserialized module is asked about the bodies it has not read in yet
+// rather than reading them all in.
 bool doesModuleUseAutodiff(IRModule* module)
 {
-    return containsTranslateInst(module->getModuleInst());
+    if (containsTranslateInst(module->getModuleInst()))
+        return true;
+    auto lazyLoader = module->getLazyLoader();
+    return lazyLoader && lazyLoader->anyUnmaterializedInst(isTranslateOp);
 }
 
 void cloneUsedWitnessTableEntries(IRSpecContext* context)
@@ -2219,6 +2276,11 @@ LinkedIR linkIR(CodeGenContext* codeGenContext)
     for (auto irModule : irModules)
         irModule->_ensureLinkingInfo();
 
+    // Linking the same program for each of its entry points resolves the same symbols each
+    // time, so those resolutions are kept on the target program and shared between links.
+    sharedContext->programLinkingInfo =
+        targetProgram->getOrCreateLinkingInfo(irModules.getArrayView());
+
     // This is the final per-target code-generation link, so auto-diff artifacts
     // the program never uses may be pruned (see
     // `IRSharedSpecContext::canPruneAutodiffLinkArtifacts`).
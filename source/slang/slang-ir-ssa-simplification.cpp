@@ -14,6 +14,8 @@
 #include "slang-ir-util.h"
 #include "slang-ir.h"
 
+#include <optional>
+
 namespace Slang
 {
 IRSimplificationOptions IRSimplificationOptions::getDefault(TargetProgram* targetProgram)
@@ -30,6 +32,9 @@ IRSimplificationOptions IRSimplificationOptions::getDefault(TargetProgram* targe
         result.deadCodeElimOptions.keepGlobalParamsAlive =
             targetProgram->getOptionSet().getBoolOption(CompilerOptionName::PreserveParameters);
     result.deadCodeElimOptions.useFastAnalysis = result.minimalOptimization;
+    if (targetProgram)
+        result.revisitOnlyChangedFuncs = !targetProgram->getOptionSet().getBoolOption(
+            CompilerOptionName::SimplifyRevisitAllFunctions);
     return result;
 }
 
@@ -44,9 +49,140 @@ IRSimplificationOptions IRSimplificationOptions::getFast(TargetProgram* targetPr
         result.deadCodeElimOptions.keepGlobalParamsAlive =
             targetProgram->getOptionSet().getBoolOption(CompilerOptionName::PreserveParameters);
     result.deadCodeElimOptions.useFastAnalysis = result.minimalOptimization;
+    if (targetProgram)
+        result.revisitOnlyChangedFuncs = !targetProgram->getOptionSet().getBoolOption(
+            CompilerOptionName::SimplifyRevisitAllFunctions);
     return result;
 }
 
+// Tracks which functions `simplifyIR` has to simplify again in its next round.
+//
+// A function whose simplification reached a fixed point only changes again if something it
+// depends on changed. That is either its own body, a global value it uses, or a callee. Every
+// change to the IR made while the worklist exists is recorded against the global value it was
+// made in, and marks that value's users, looking through global values (such as
+// specializations) built out of it.
+struct SimplifyIRWorklist
+{
+    explicit SimplifyIRWorklist(IRModule* module)
+        : m_recorder(module)
+    {
+    }
+
+    bool shouldSimplify(IRGlobalValueWithCode* func)
+    {
+        _invalidateRecordedChanges(nullptr);
+        return m_dirtyFuncs.contains(func);
+    }
+
+    void onSimplified(IRGlobalValueWithCode* func, bool changed, bool reachedFixedPoint)
+    {
+        // The passes on `func` may have changed it and left it the same. What they did to `func`
+        // itself is summed up by `changed`.
+        _invalidateRecordedChanges(func);
+        m_dirtyFuncs.remove(func);
+
+        // Callers analyze calls based on what the callee does, so they need another look.
+        if (changed)
+        {
+            List<IRInst*> changedGlobals;
+            changedGlobals.add(func);
+            _invalidateUsers(changedGlobals);
+        }
+        if (!reachedFixedPoint)
+            m_dirtyFuncs.add(func);
+    }
+
+private:
+    // Mark the users of every global value changed since the last call, other than `ignored`.
+    void _invalidateRecordedChanges(IRInst* ignored)
+    {
+        List<IRInst*> changedGlobals;
+        m_recorder.takeChanges(changedGlobals);
+        if (ignored)
+            changedGlobals.remove(ignored);
+        _invalidateUsers(changedGlobals);
+    }
+
+    // Mark every function that is or uses any of `changedGlobals`, looking through global values
+    // (such as specializations) built out of them.
+    void _invalidateUsers(List<IRInst*>& changedGlobals)
+    {
+        HashSet<IRInst*> visited;
+        for (auto inst : changedGlobals)
+            visited.add(inst);
+
+        for (Index i = 0; i < changedGlobals.getCount(); i++)
+        {
+            auto changedGlobal = changedGlobals[i];
+            if (auto func = as<IRGlobalValueWithCode>(changedGlobal))
+                m_dirtyFuncs.add(func);
+
+            for (auto use = changedGlobal->firstUse; use; use = use->nextUse)
+            {
+                auto user = _getGlobalAncestor(use->getUser());
+                if (as<IRGlobalValueWithCode>(user))
+                    m_dirtyFuncs.add(user);
+                else if (visited.add(user))
+                    changedGlobals.add(user);
+            }
+        }
+    }
+
+    static IRInst* _getGlobalAncestor(IRInst* inst)
+    {
+        while (inst->getParent() && !as<IRModuleInst>(inst->getParent()))
+            inst = inst->getParent();
+        return inst;
+    }
+
+    IRGlobalChangeRecorder m_recorder;
+    HashSet<IRInst*> m_dirtyFuncs;
+};
+
+// Run the function-local passes on `func` until it stops changing, or for at most
+// `kMaxFuncIterations` iterations. Returns true if anything changed, and sets
+// `outReachedFixedPoint` to false if `func` was still changing when the limit was hit.
+static bool _simplifyFuncToFixedPoint(
+    IRGlobalValueWithCode* func,
+    TargetProgram* target,
+    const IRSimplificationOptions& options,
+    DiagnosticSink* sink,
+    bool& outReachedFixedPoint)
+{
+    SLANG_PROFILE;
+
+    const int kMaxFuncIterations = 16;
+
+    bool funcChanged = true;
+    bool anyFuncChange = false;
+    int funcIterationCount = 0;
+    while (funcChanged && funcIterationCount < kMaxFuncIterations)
+    {
+
+        eliminateDeadCode(func, options.deadCodeElimOptions);
+        funcChanged = false;
+        funcChanged |= applySparseConditionalConstantPropagation(func, target, sink);
+        funcChanged |= peepholeOptimize(target, func);
+        if (options.removeRedundancy)
+            funcChanged |= removeRedundancyInFunc(func, options.hoistLoopInvariantInsts);
+        funcChanged |= simplifyCFG(func, options.cfgOptions);
+        // Note: we disregard the `changed` state from dead code elimination pass since
+        // SCCP pass could be generating temporarily evaluated constant values and never
+        // actually use them. DCE will always remove those nearly generated consts and
+        // always returns true here. Run eliminate-dead-code twice to ensure optimizations
+        // are applied on the dce'd code.
+        //
+        eliminateDeadCode(func, options.deadCodeElimOptions);
+        if (funcIterationCount == 0)
+            funcChanged |= constructSSA(func);
+        anyFuncChange |= funcChanged;
+        funcIterationCount++;
+    }
+    outReachedFixedPoint = !funcChanged;
+    return anyFuncChange;
+}
+
 // Run a combination of SSA, SCCP, SimplifyCFG, and DeadCodeElimination pass
 // until no more changes are possible.
 void simplifyIR(
@@ -65,9 +201,13 @@ void simplifyIR(
     if (!options.deadCodeElimOptions.calleeSideEffectCache)
         options.deadCodeElimOptions.calleeSideEffectCache = &calleeSideEffectCache;
 
+    // Records changes to the IR for as long as it exists, so it's only made if it's used.
+    std::optional<SimplifyIRWorklist> worklist;
+    if (options.revisitOnlyChangedFuncs)
+        worklist.emplace(module);
+
     bool changed = true;
     const int kMaxIterations = 8;
-    const int kMaxFuncIterations = 16;
     int iterationCounter = 0;
 
     while (changed && iterationCounter < kMaxIterations)
@@ -85,36 +225,24 @@ void simplifyIR(
         changed |= peepholeOptimizeGlobalScope(target, module);
         changed |= trimOptimizableTypes(module);
 
+        const bool revisitAllFuncs = !worklist || iterationCounter == 0;
+
         for (auto inst : module->getGlobalInsts())
         {
             auto func = as<IRGlobalValueWithCode>(inst);
             if (!func)
                 continue;
-            bool funcChanged = true;
-            int funcIterationCount = 0;
-            while (funcChanged && funcIterationCount < kMaxFuncIterations)
-            {
+            if (!revisitAllFuncs && !worklist->shouldSimplify(func))
+                continue;
 
-                eliminateDeadCode(func, options.deadCodeElimOptions);
-                funcChanged = false;
-                funcChanged |= applySparseConditionalConstantPropagation(func, target, sink);
-                funcChanged |= peepholeOptimize(target, func);
-                if (options.removeRedundancy)
-                    funcChanged |= removeRedundancyInFunc(func, options.hoistLoopInvariantInsts);
-                funcChanged |= simplifyCFG(func, options.cfgOptions);
-                // Note: we disregard the `changed` state from dead code elimination pass since
-                // SCCP pass could be generating temporarily evaluated constant values and never
-                // actually use them. DCE will always remove those nearly generated consts and
-                // always returns true here. Run eliminate-dead-code twice to ensure optimizations
-                // are applied on the dce'd code.
-                //
-                eliminateDeadCode(func, options.deadCodeElimOptions);
-                if (funcIterationCount == 0)
-                    funcChanged |= constructSSA(func);
-                changed |= funcChanged;
-                funcIterationCount++;
-            }
+            bool reachedFixedPoint = true;
+            bool funcChanged =
+                _simplifyFuncToFixedPoint(func, target, options, sink, reachedFixedPoint);
+            changed |= funcChanged;
+            if (worklist)
+                worklist->onSimplified(func, funcChanged, reachedFixedPoint);
         }
+
         iterationCounter++;
     }
     eliminateDeadCode(module, options.deadCodeElimOptions);
@@ -22,6 +22,11 @@ struct IRSimplificationOptions
     bool removeRedundancy = false;
     bool hoistLoopInvariantInsts = false;
 
+    /// After its first round, have `simplifyIR` only simplify functions that changed in the
+    /// previous round, or whose callees or the global values they use changed since. Other
+    /// functions are already at a fixed point.
+    bool revisitOnlyChangedFuncs = true;
+
     static IRSimplificationOptions getDefault(TargetProgram* targetProgram);
 
     static IRSimplificationOptions getFast(TargetProgram* targetProgram);
@@ -131,6 +131,56 @@ IRInst* cloneGlobalValueWithLinkage(
     IRLinkageDecoration* originalLinkage);
 
 
+// The number of recorders on all modules. Changes are only traced to their module while it isn't
+// zero, so IR that isn't being recorded pays for one load per change.
+std::atomic<int> IRGlobalChangeRecorder::s_recorderCount{0};
+
+IRGlobalChangeRecorder::IRGlobalChangeRecorder(IRModule* module)
+    : m_module(module), m_previous(module->getChangeRecorder())
+{
+    module->_setChangeRecorder(this);
+    s_recorderCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+IRGlobalChangeRecorder::~IRGlobalChangeRecorder()
+{
+    s_recorderCount.fetch_sub(1, std::memory_order_relaxed);
+    m_module->_setChangeRecorder(m_previous);
+}
+
+void IRGlobalChangeRecorder::takeChanges(List<IRInst*>& outChanged)
+{
+    // Insts are never freed while their module is alive, so a global value that was removed
+    // after it changed can still be asked for its parent.
+    outChanged.clear();
+    for (auto inst : m_changed)
+    {
+        if (auto parent = inst->getParent(); parent && parent->getOp() == kIROp_ModuleInst)
+            outChanged.add(inst);
+    }
+    m_changed.clear();
+    m_changedSet.clear();
+}
+
+/* static */ void IRGlobalChangeRecorder::_recordChange(IRInst* inst)
+{
+    // Insts that aren't in a module yet have nothing depending on them.
+    for (auto parent = inst->getParent(); parent; parent = parent->getParent())
+    {
+        if (parent->getOp() == kIROp_ModuleInst)
+        {
+            auto module = static_cast<IRModuleInst*>(parent)->module;
+            if (auto recorder = module ? module->getChangeRecorder() : nullptr)
+            {
+                if (recorder->m_changedSet.add(inst))
+                    recorder->m_changed.add(inst);
+            }
+            return;
+        }
+        inst = parent;
+    }
+}
+
 //
 
 void IRUse::debugValidate()
@@ -157,6 +207,9 @@ void IRUse::debugValidate()
 
 void IRUse::init(IRInst* u, IRInst* v)
 {
+    if (IRGlobalChangeRecorder::_isAnyModuleRecorded() && (u != user || v != usedValue))
+        IRGlobalChangeRecorder::_recordChange(u);
+
     clear();
     user = u;
     usedValue = v;
@@ -195,6 +248,9 @@ void IRUse::clear()
 
     if (usedValue)
     {
+        if (IRGlobalChangeRecorder::_isAnyModuleRecorded())
+            IRGlobalChangeRecorder::_recordChange(user);
+
 #ifdef SLANG_ENABLE_FULL_IR_VALIDATION
         auto uv = usedValue;
 #endif
@@ -1696,6 +1752,8 @@ IRInst* IRModule::_allocateInst(IROp op, Int operandCount, size_t minSizeInBytes
     inst->operandCount = uint32_t(operandCount);
     inst->m_op = op;
 
+    m_allocatedInstCount++;
+
     return inst;
 }
 
@@ -5139,6 +5197,40 @@ ArrayView<IRAnnotation*> ModuleLinkingInfo::getAnnotationsForTarget(IRInst* targ
     return annotations->getArrayView();
 }
 
+ProgramLinkingInfo::ProgramLinkingInfo(ArrayView<IRModule*> modules)
+{
+    m_modules.addRange(modules);
+}
+
+bool ProgramLinkingInfo::isForModules(ArrayView<IRModule*> modules)
+{
+    return m_modules.getArrayView() == modules;
+}
+
+bool ProgramLinkingInfo::tryGetSymbols(ImmutableHashedString const& name, List<IRInst*>& outValues)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_symbols.tryGetValue(name, outValues);
+}
+
+void ProgramLinkingInfo::addSymbols(ImmutableHashedString const& name, List<IRInst*> const& values)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_symbols.addIfNotExists(name, values);
+}
+
+bool ProgramLinkingInfo::tryGetBestValue(ImmutableHashedString const& name, IRInst*& outValue)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_bestValues.tryGetValue(name, outValue);
+}
+
+void ProgramLinkingInfo::addBestValue(ImmutableHashedString const& name, IRInst* value)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_bestValues.addIfNotExists(name, value);
+}
+
 void IRModule::_ensureLinkingInfo()
 {
     std::lock_guard<std::mutex> lock(m_linkingInfoMutex);
@@ -9218,6 +9310,9 @@ void IRInst::_insertAt(IRInst* inPrev, IRInst* inNext, IRInst* inParent)
     // Make sure this instruction has been removed from any previous parent
     this->removeFromParent();
 
+    if (IRGlobalChangeRecorder::_isAnyModuleRecorded())
+        IRGlobalChangeRecorder::_recordChange(inParent);
+
     SLANG_ASSERT(inParent);
     SLANG_ASSERT(!inPrev || (inPrev->getNextInst() == inNext) && (inPrev->getParent() == inParent));
     SLANG_ASSERT(!inNext || (inNext->getPrevInst() == inPrev) && (inNext->getParent() == inParent));
@@ -9304,6 +9399,9 @@ void IRInst::removeFromParent()
     if (!oldParent)
         return;
 
+    if (IRGlobalChangeRecorder::_isAnyModuleRecorded())
+        IRGlobalChangeRecorder::_recordChange(oldParent);
+
     auto pp = getPrevInst();
     auto nn = getNextInst();
 
@@ -9372,6 +9470,7 @@ void IRInst::removeAndDeallocate()
         module->getDeduplicationContext()->getInstReplacementMap().remove(this);
         if (auto func = as<IRGlobalValueWithCode>(this))
             module->invalidateAnalysisForInst(func);
+        module->_noteInstRemoved();
     }
     removeArguments();
     removeFromParent();
@@ -15,6 +15,7 @@
 #include "slang-ir-insts-enum.h"
 #include "slang-type-system-shared.h"
 
+#include <atomic>
 #include <functional>
 #include <mutex>
 
@@ -2123,6 +2124,108 @@ private:
     IRGlobalHashedStringLiterals* m_globalHashedStringLiterals = nullptr;
 };
 
+/// Linker acceleration cache shared between the links of one program for one target.
+///
+/// Linking the same program for many entry points looks up the definitions of the same mangled
+/// names, and chooses the best of them for the target, in each link. This records the results of
+/// both so that later links can reuse them. It is only valid for the list of modules it was
+/// created for, and may be used by several links at once.
+struct ProgramLinkingInfo : RefObject
+{
+    ProgramLinkingInfo(ArrayView<IRModule*> modules);
+
+    /// Is this the cache for linking exactly `modules`, in that order?
+    bool isForModules(ArrayView<IRModule*> modules);
+
+    /// Get the global values with the linkage name `name`, in the order they were found.
+    bool tryGetSymbols(ImmutableHashedString const& name, List<IRInst*>& outValues);
+    void addSymbols(ImmutableHashedString const& name, List<IRInst*> const& values);
+
+    /// Get the global value chosen as the best definition of `name` for the target.
+    bool tryGetBestValue(ImmutableHashedString const& name, IRInst*& outValue);
+    void addBestValue(ImmutableHashedString const& name, IRInst* value);
+
+private:
+    List<IRModule*> m_modules;
+
+    std::mutex m_mutex;
+    Dictionary<ImmutableHashedString, List<IRInst*>> m_symbols;
+    Dictionary<ImmutableHashedString, IRInst*> m_bestValues;
+};
+
+/// Records which global values of a module are changed while it exists, so that a pass can
+/// revisit only what changed since it last looked.
+///
+/// Setting an operand of an inst, or inserting or removing a child of one, is recorded against the
+/// global value the inst is nested in. Adding or removing insts directly in the global scope isn't
+/// recorded, but replacing a global value changes the insts that use it, which is.
+///
+/// The recorder is found through the module the changed inst is in, so a module should only be
+/// changed by one thread while it is recorded. Recorders on the same module can nest, in which
+/// case only the innermost one records.
+struct IRGlobalChangeRecorder
+{
+    explicit IRGlobalChangeRecorder(IRModule* module);
+    ~IRGlobalChangeRecorder();
+
+    IRGlobalChangeRecorder(const IRGlobalChangeRecorder&) = delete;
+    IRGlobalChangeRecorder& operator=(const IRGlobalChangeRecorder&) = delete;
+
+    /// Output the global values that were changed since the last call and are still in their
+    /// module, in the order they were first changed.
+    void takeChanges(List<IRInst*>& outChanged);
+
+    /// Called by the IR when `inst` is changed, while any module has a recorder.
+    static void _recordChange(IRInst* inst);
+
+    /// True if any module has a recorder. Lets the IR skip looking for the module of a changed
+    /// inst when nothing is recording.
+    static bool _isAnyModuleRecorded()
+    {
+        return s_recorderCount.load(std::memory_order_relaxed) != 0;
+    }
+
+private:
+    static std::atomic<int> s_recorderCount;
+
+    IRModule* m_module;
+    IRGlobalChangeRecorder* m_previous;
+    List<IRInst*> m_changed;
+    HashSet<IRInst*> m_changedSet;
+};
+
+/// Supplies the bodies of global values for an `IRModule` that was deserialized lazily.
+///
+/// A lazily deserialized module starts out with all of its global values and their
+/// decorations, but the children of module-level functions, generics and witness tables
+/// are only read in when `IRModule::materialize` is first asked for them.
+///
+/// Reading in a body links new uses into the use-lists of instructions that are already
+/// present, such as the global values the body references. Materialization holds `getMutex()`,
+/// and code that walks the use-lists of a lazily deserialized module while another thread may
+/// be linking against it must hold it too, or call `IRModule::materializeAll` first.
+struct IRLazyModuleLoader : RefObject
+{
+    /// Read in the children of the module-level `globalValue`, if they have not been yet.
+    virtual void materialize(IRInst* globalValue) = 0;
+
+    /// Read in every body that has not been read in yet.
+    virtual void materializeAll() = 0;
+
+    /// Returns true if a body that has not been read in yet contains an instruction
+    /// whose opcode satisfies `predicate`.
+    virtual bool anyUnmaterializedInst(bool (*predicate)(IROp)) = 0;
+
+    /// Get the number of bodies that have not been read in yet.
+    virtual Index getUnmaterializedCount() = 0;
+
+    /// The lock held while a body is read in.
+    std::mutex& getMutex() { return m_mutex; }
+
+protected:
+    std::mutex m_mutex;
+};
+
 FIDDLE()
 struct IRModule : RefObject
 {
@@ -2157,6 +2260,29 @@ public:
 
     void buildMangledNameToGlobalInstMap();
 
+    /// Make sure the children of the module-level `globalValue` are present.
+    /// Only a lazily deserialized module (see `IRLazyModuleLoader`) can be missing any;
+    /// code that reads the body of a global value from such a module must call this first.
+    void materialize(IRInst* globalValue)
+    {
+        if (m_lazyLoader)
+            m_lazyLoader->materialize(globalValue);
+    }
+
+    /// Make sure the bodies of all global values are present.
+    void materializeAll()
+    {
+        if (m_lazyLoader)
+            m_lazyLoader->materializeAll();
+    }
+
+    IRLazyModuleLoader* getLazyLoader() const { return m_lazyLoader; }
+    void _setLazyLoader(IRLazyModuleLoader* loader) { m_lazyLoader = loader; }
+
+    /// The recorder that changes to this module are reported to, if any.
+    IRGlobalChangeRecorder* getChangeRecorder() const { return m_changeRecorder; }
+    void _setChangeRecorder(IRGlobalChangeRecorder* recorder) { m_changeRecorder = recorder; }
+
     IRDeduplicationContext* getDeduplicationContext() const { return &m_deduplicationContext; }
 
     Dictionary<IRInst*, UInt>* getUniqueIdMap() { return &m_mapInstToUniqueId; }
@@ -2236,6 +2362,12 @@ public:
         return (T*)_allocateInst(op, operandCount, sizeof(T));
     }
 
+    /// Running totals of the instructions allocated in, and removed from, this module.
+    /// Used to report per-pass IR statistics.
+    UInt64 getAllocatedInstCount() const { return m_allocatedInstCount; }
+    UInt64 getRemovedInstCount() const { return m_removedInstCount; }
+    void _noteInstRemoved() { m_removedInstCount++; }
+
     ContainerPool& getContainerPool() { return m_containerPool; }
 
     // TODO: Could be better...
@@ -2295,6 +2427,9 @@ private:
     /// are allocated.
     MemoryArena m_memoryArena;
 
+    UInt64 m_allocatedInstCount = 0;
+    UInt64 m_removedInstCount = 0;
+
     /// A pool to allow reuse of common types of containers to reduce memory allocations
     /// and rehashing.
     ContainerPool m_containerPool;
@@ -2325,6 +2460,12 @@ private:
     // Assumes the module will not change after the cache is built; rebuild manually if it does.
     RefPtr<ModuleLinkingInfo> m_linkingInfo;
     std::mutex m_linkingInfoMutex;
+
+    // Reads in the bodies of global values on demand, if the module was deserialized lazily.
+    RefPtr<IRLazyModuleLoader> m_lazyLoader;
+
+    // The innermost `IRGlobalChangeRecorder` recording changes to this module.
+    IRGlobalChangeRecorder* m_changeRecorder = nullptr;
 };
 
 
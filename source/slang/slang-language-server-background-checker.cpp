@@ -0,0 +1,204 @@
+#include "slang-language-server-background-checker.h"
+
+#include "slang-language-server-semantic-tokens.h"
+
+#include <chrono>
+
+namespace Slang
+{
+
+// How long the thread keeps its global session and workspace after the last check.
+static const std::chrono::seconds kIdleReleaseTime(60);
+
+LanguageServerBackgroundChecker::LanguageServerBackgroundChecker()
+{
+    m_thread = std::thread([this] { _threadMain(); });
+}
+
+LanguageServerBackgroundChecker::~LanguageServerBackgroundChecker()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShuttingDown = true;
+        m_generation++;
+    }
+    m_checkPosted.notify_all();
+    m_thread.join();
+}
+
+void LanguageServerBackgroundChecker::post(
+    RefPtr<WorkspaceSnapshot> snapshot,
+    List<String> const& paths)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_snapshot = snapshot;
+        for (auto& path : paths)
+            m_pathsToCheck.add(path);
+
+        // Whatever was computed from an older snapshot is out of date.
+        m_generation++;
+        m_hasResult = false;
+        m_result = BackgroundCheckResult();
+    }
+    m_checkPosted.notify_all();
+}
+
+bool LanguageServerBackgroundChecker::tryTakeResult(BackgroundCheckResult& outResult)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_hasResult)
+        return false;
+    outResult = _Move(m_result);
+    m_result = BackgroundCheckResult();
+    m_hasResult = false;
+    return true;
+}
+
+void LanguageServerBackgroundChecker::takeUncheckedPaths(List<String>& outPaths)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& path : m_pathsToCheck)
+        outPaths.add(path);
+    m_pathsToCheck.clear();
+}
+
+bool LanguageServerBackgroundChecker::isBusy()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_snapshot || m_isChecking || m_hasResult;
+}
+
+void LanguageServerBackgroundChecker::_threadMain()
+{
+    auto isPosted = [&] { return m_isShuttingDown || m_snapshot; };
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;)
+    {
+        if (!m_globalSession)
+        {
+            m_checkPosted.wait(lock, isPosted);
+        }
+        else if (!m_checkPosted.wait_for(lock, kIdleReleaseTime, isPosted))
+        {
+            // The workspace refers to the global session, so it goes first.
+            m_workspace = nullptr;
+            m_globalSession = nullptr;
+            continue;
+        }
+        if (m_isShuttingDown)
+            break;
+
+        if (!m_globalSession)
+        {
+            lock.unlock();
+            SlangGlobalSessionDesc desc = {};
+            desc.enableGLSL = true;
+            const SlangResult createResult =
+                slang_createGlobalSession2(&desc, m_globalSession.writeRef());
+            lock.lock();
+            if (SLANG_FAILED(createResult))
+            {
+                // The posted paths are kept for the server to check with `takeUncheckedPaths`.
+                m_snapshot = nullptr;
+                m_hasFailed = true;
+                break;
+            }
+            if (m_isShuttingDown)
+                break;
+        }
+
+        RefPtr<WorkspaceSnapshot> snapshot = _Move(m_snapshot);
+        List<String> paths;
+        for (auto& path : m_pathsToCheck)
+            paths.add(path);
+        const uint64_t generation = m_generation.load();
+        m_isChecking = true;
+        lock.unlock();
+
+        BackgroundCheckResult result;
+        bool hasResult = false;
+        for (int attempt = 0; attempt < 2; attempt++)
+        {
+            try
+            {
+                // A canceled check isn't tried again, as the snapshot that canceled it is next.
+                hasResult = _check(*snapshot, paths, generation, result);
+                break;
+            }
+            catch (...)
+            {
+                // An internal error leaves the workspace in an unknown state, and may have come
+                // from the modules it kept from earlier checks, so try once more with a new one.
+                m_workspace = nullptr;
+                result = BackgroundCheckResult();
+            }
+        }
+
+        lock.lock();
+        m_isChecking = false;
+
+        // A snapshot posted during the check replaces it, and has its paths added to these. The
+        // paths of a check that didn't finish stay, so they are checked with the next snapshot.
+        if (hasResult && generation == m_generation.load())
+        {
+            m_pathsToCheck.clear();
+            m_result = _Move(result);
+            m_hasResult = true;
+        }
+    }
+    lock.unlock();
+
+    m_workspace = nullptr;
+    m_globalSession = nullptr;
+}
+
+bool LanguageServerBackgroundChecker::_check(
+    WorkspaceSnapshot const& snapshot,
+    List<String> const& paths,
+    uint64_t generation,
+    BackgroundCheckResult& outResult)
+{
+    if (!m_workspace)
+    {
+        m_workspace = new Workspace();
+        m_workspace->slangGlobalSession = m_globalSession;
+    }
+    m_workspace->applySnapshot(snapshot);
+
+    auto version = m_workspace->getCurrentVersion();
+    SLANG_AST_BUILDER_RAII(version->linkage->getASTBuilder());
+
+    for (auto& path : paths)
+    {
+        if (_isCanceled(generation))
+            return false;
+        version->getOrLoadModule(path);
+    }
+
+    for (auto& path : paths)
+    {
+        if (_isCanceled(generation))
+            return false;
+        RefPtr<DocumentVersion> doc;
+        if (!m_workspace->openedDocuments.tryGetValue(path, doc))
+            continue;
+        Module* module = version->getOrLoadModule(path);
+        if (!module)
+            continue;
+        CheckedDocumentTokens checkedTokens;
+        checkedTokens.text = doc->getText();
+        checkedTokens.tokens = getDocumentSemanticTokens(
+            version->linkage,
+            module,
+            path.getUnownedSlice(),
+            doc.Ptr());
+        outResult.semanticTokens[path] = _Move(checkedTokens);
+    }
+
+    outResult.diagnostics = version->diagnostics;
+    return true;
+}
+
+} // namespace Slang
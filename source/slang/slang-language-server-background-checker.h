@@ -0,0 +1,91 @@
+#pragma once
+
+#include "core/slang-basic.h"
+#include "slang-com-ptr.h"
+#include "slang-workspace-version.h"
+#include "slang.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Slang
+{
+
+// The semantic tokens of a document, and the text they were computed from.
+struct CheckedDocumentTokens
+{
+    String text;
+    LanguageServerProtocol::SemanticTokens tokens;
+};
+
+struct BackgroundCheckResult
+{
+    // The diagnostics of every file the check saw, as in `WorkspaceVersion::diagnostics`.
+    Dictionary<String, DocumentDiagnostics> diagnostics;
+
+    // The semantic tokens of the open documents that were checked.
+    Dictionary<String, CheckedDocumentTokens> semanticTokens;
+};
+
+// Checks documents on a thread of its own, so that requests such as completion and hover don't
+// wait for diagnostics to be computed.
+//
+// The thread has its own global session and workspace, and is only given snapshots of the open
+// documents and settings, so it shares no compiler state with the server thread. Posting a new
+// snapshot cancels the check in progress: modules can't be interrupted part way through checking,
+// so the thread finishes the module it is on, then drops the old check and starts the new one.
+//
+// The global session and workspace of the thread take about as much memory as the server's own,
+// so they are only created when there is something to check, and released again once nothing has
+// been posted for a while.
+class LanguageServerBackgroundChecker : public RefObject
+{
+public:
+    LanguageServerBackgroundChecker();
+    ~LanguageServerBackgroundChecker();
+
+    // Check `paths` in `snapshot`, along with any paths whose check hasn't finished yet.
+    void post(RefPtr<WorkspaceSnapshot> snapshot, List<String> const& paths);
+
+    // Take the result of the last check, if it finished and nothing was posted since.
+    bool tryTakeResult(BackgroundCheckResult& outResult);
+
+    // True while a posted check hasn't been taken with `tryTakeResult`.
+    bool isBusy();
+
+    // True if the thread couldn't create its global session, and checks nothing.
+    bool hasFailed() { return m_hasFailed.load(); }
+
+    // Take the paths that were posted but not checked yet, such as after the thread failed.
+    void takeUncheckedPaths(List<String>& outPaths);
+
+private:
+    void _threadMain();
+    bool _check(
+        WorkspaceSnapshot const& snapshot,
+        List<String> const& paths,
+        uint64_t generation,
+        BackgroundCheckResult& outResult);
+    bool _isCanceled(uint64_t generation) { return m_generation.load() != generation; }
+
+    // Only used on the checking thread.
+    ComPtr<slang::IGlobalSession> m_globalSession;
+    RefPtr<Workspace> m_workspace;
+
+    std::mutex m_mutex;
+    std::condition_variable m_checkPosted;
+    RefPtr<WorkspaceSnapshot> m_snapshot;
+    OrderedHashSet<String> m_pathsToCheck;
+    std::atomic<uint64_t> m_generation{0};
+    bool m_isChecking = false;
+    bool m_hasResult = false;
+    BackgroundCheckResult m_result;
+    bool m_isShuttingDown = false;
+    std::atomic<bool> m_hasFailed{false};
+
+    std::thread m_thread;
+};
+
+} // namespace Slang
@@ -419,4 +419,31 @@ List<uint32_t> getEncodedTokens(List<SemanticToken>& tokens)
     return result;
 }
 
+LanguageServerProtocol::SemanticTokens getDocumentSemanticTokens(
+    Linkage* linkage,
+    Module* module,
+    UnownedStringSlice fileName,
+    DocumentVersion* doc)
+{
+    auto tokens = getSemanticTokens(linkage, module, fileName, doc);
+    for (auto& token : tokens)
+    {
+        Index line, col;
+        doc->oneBasedUTF8LocToZeroBasedUTF16Loc(token.line, token.col, line, col);
+        Index lineEnd, colEnd;
+        doc->oneBasedUTF8LocToZeroBasedUTF16Loc(
+            token.line,
+            token.col + token.length,
+            lineEnd,
+            colEnd);
+        token.line = (int)line;
+        token.col = (int)col;
+        token.length = (int)(colEnd - col);
+    }
+    LanguageServerProtocol::SemanticTokens response;
+    response.resultId = "";
+    response.data = getEncodedTokens(tokens);
+    return response;
+}
+
 } // namespace Slang
@@ -47,4 +47,11 @@ List<SemanticToken> getSemanticTokens(
     DocumentVersion* doc);
 List<uint32_t> getEncodedTokens(List<SemanticToken>& tokens);
 
+// Get the encoded semantic tokens of `doc`, with positions in the UTF-16 form that clients expect.
+LanguageServerProtocol::SemanticTokens getDocumentSemanticTokens(
+    Linkage* linkage,
+    Module* module,
+    UnownedStringSlice fileName,
+    DocumentVersion* doc);
+
 } // namespace Slang
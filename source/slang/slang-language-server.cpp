@@ -75,6 +75,9 @@ SlangResult LanguageServer::init(const InitializeParams& args)
 
     m_typeMap = JSONNativeUtil::getTypeFuncsMap();
 
+    if (m_core.m_options.periodicDiagnosticUpdate)
+        m_backgroundChecker = new LanguageServerBackgroundChecker();
+
     return m_core.init(args);
 }
 
@@ -99,6 +102,11 @@ void LanguageServer::resetDiagnosticUpdateTime()
     m_lastDiagnosticUpdateTime = std::chrono::system_clock::now();
 }
 
+bool LanguageServer::isCheckingInBackground()
+{
+    return m_backgroundChecker && !m_backgroundChecker->hasFailed();
+}
+
 String uriToCanonicalPath(const String& uri)
 {
     String canonnicalPath;
@@ -223,6 +231,7 @@ SlangResult LanguageServer::parseNextMessage()
                         updateWorkspaceFlavor(arr[12]);
                         updateTraceOptions(arr[13]);
                         updatePredefinedLanguageVersion(arr[14]);
+                        recheckOpenDocuments();
                     }
                 }
                 break;
@@ -580,6 +589,11 @@ HumaneSourceLoc getModuleLoc(SourceManager* manager, ContainerDecl* moduleDecl)
 
 void LanguageServer::removePendingModuleToUpdateDiagnostics(const String& uri)
 {
+    // A request only checks the document in the server's own workspace, and the background
+    // check still has to see it to report its diagnostics.
+    if (isCheckingInBackground())
+        return;
+
     String canonicalPath = uriToCanonicalPath(uri);
     m_pendingModulesToUpdateDiagnostics.remove(canonicalPath);
 }
@@ -1461,6 +1475,17 @@ SlangResult LanguageServer::semanticTokens(
     const LanguageServerProtocol::SemanticTokensParams& args,
     const JSONValue& responseId)
 {
+    // The tokens from the last background check are still valid if the document hasn't changed.
+    String canonicalPath = uriToCanonicalPath(args.textDocument.uri);
+    RefPtr<DocumentVersion> doc;
+    auto checkedTokens = m_checkedSemanticTokens.tryGetValue(canonicalPath);
+    if (checkedTokens && m_core.m_workspace->openedDocuments.tryGetValue(canonicalPath, doc) &&
+        doc->getText() == checkedTokens->text)
+    {
+        m_connection->sendResult(&checkedTokens->tokens, responseId);
+        return SLANG_OK;
+    }
+
     auto result = m_core.semanticTokens(args);
     removePendingModuleToUpdateDiagnostics(args.textDocument.uri);
 
@@ -1493,29 +1518,11 @@ LanguageServerResult<LanguageServerProtocol::SemanticTokens> LanguageServerCore:
         return std::nullopt;
     }
 
-    auto tokens = getSemanticTokens(
+    return getDocumentSemanticTokens(
         version->linkage,
         parsedModule,
         canonicalPath.getUnownedSlice(),
         doc.Ptr());
-    for (auto& token : tokens)
-    {
-        Index line, col;
-        doc->oneBasedUTF8LocToZeroBasedUTF16Loc(token.line, token.col, line, col);
-        Index lineEnd, colEnd;
-        doc->oneBasedUTF8LocToZeroBasedUTF16Loc(
-            token.line,
-            token.col + token.length,
-            lineEnd,
-            colEnd);
-        token.line = (int)line;
-        token.col = (int)col;
-        token.length = (int)(colEnd - col);
-    }
-    SemanticTokens response;
-    response.resultId = "";
-    response.data = getEncodedTokens(tokens);
-    return response;
 }
 
 String LanguageServerCore::getExprDeclSignature(
@@ -2281,11 +2288,16 @@ void LanguageServer::publishDiagnostics()
     }
     m_pendingModulesToUpdateDiagnostics.clear();
 
+    sendDiagnostics(version->diagnostics);
+}
+
+void LanguageServer::sendDiagnostics(const Dictionary<String, DocumentDiagnostics>& diagnostics)
+{
     // Send updates to clear diagnostics for files that no longer have any messages.
     List<String> filesToRemove;
     for (const auto& [filepath, _] : m_lastPublishedDiagnostics)
     {
-        if (!version->diagnostics.containsKey(filepath))
+        if (!diagnostics.containsKey(filepath))
         {
             PublishDiagnosticsParams args;
             args.uri = URI::fromLocalFilePath(filepath.getUnownedSlice()).uri;
@@ -2298,7 +2310,7 @@ void LanguageServer::publishDiagnostics()
         m_lastPublishedDiagnostics.remove(toRemove);
     }
     // Send updates for any files whose diagnostic messages has changed since last update.
-    for (const auto& [listKey, listValue] : version->diagnostics)
+    for (const auto& [listKey, listValue] : diagnostics)
     {
         auto lastPublished = m_lastPublishedDiagnostics.tryGetValue(listKey);
         if (!lastPublished || *lastPublished != listValue.originalOutput)
@@ -2982,6 +2994,9 @@ SlangResult LanguageServer::didCloseTextDocument(const DidCloseTextDocumentParam
     {
         publishDiagnostics();
     }
+
+    // Check the remaining documents again, so that the diagnostics of the closed one are cleared.
+    recheckOpenDocuments();
     return result;
 }
 
@@ -3030,6 +3045,7 @@ SlangResult LanguageServer::didChangeConfiguration(
     if (args.settings.isValid() && args.settings.type != JSONValue::Type::Null)
     {
         updateConfigFromJSON(args.settings);
+        recheckOpenDocuments();
     }
     else
     {
@@ -3042,8 +3058,52 @@ void LanguageServer::update()
 {
     if (!m_core.m_workspace)
         return;
-    if (m_core.m_options.periodicDiagnosticUpdate)
+    if (!m_core.m_options.periodicDiagnosticUpdate)
+        return;
+    if (m_backgroundChecker && m_backgroundChecker->hasFailed())
+    {
+        // Check on this thread from now on, including what was posted before the failure.
+        List<String> paths;
+        m_backgroundChecker->takeUncheckedPaths(paths);
+        for (auto& path : paths)
+            m_pendingModulesToUpdateDiagnostics.add(path);
+        m_backgroundChecker = nullptr;
+    }
+    if (!isCheckingInBackground())
+    {
         publishDiagnostics();
+        return;
+    }
+
+    // Hand the changed documents to the background checker right away. Posting cancels the
+    // check of any older snapshot, so only the newest one is finished. A change can affect the
+    // tokens of the documents that import the changed one, so none of the old tokens are kept.
+    if (m_pendingModulesToUpdateDiagnostics.getCount())
+    {
+        m_checkedSemanticTokens.clear();
+        List<String> paths;
+        for (auto& path : m_pendingModulesToUpdateDiagnostics)
+            paths.add(path);
+        m_pendingModulesToUpdateDiagnostics.clear();
+        m_backgroundChecker->post(m_core.m_workspace->takeSnapshot(), paths);
+    }
+
+    BackgroundCheckResult result;
+    if (m_backgroundChecker->tryTakeResult(result))
+    {
+        sendDiagnostics(result.diagnostics);
+        for (auto& [path, tokens] : result.semanticTokens)
+            m_checkedSemanticTokens[path] = tokens;
+    }
+}
+
+void LanguageServer::recheckOpenDocuments()
+{
+    if (!isCheckingInBackground() || !m_core.m_workspace)
+        return;
+
+    for (const auto& [path, _] : m_core.m_workspace->openedDocuments)
+        m_pendingModulesToUpdateDiagnostics.add(path);
 }
 
 void LanguageServer::updateConfigFromJSON(const JSONValue& jsonVal)
@@ -3186,7 +3246,9 @@ SlangResult LanguageServer::execute()
             logMessage(3, msgBuilder.produceString());
         }
 
-        m_connection->getUnderlyingConnection()->waitForResult(1000);
+        // Don't leave the result of a background check waiting long for the next message.
+        const bool isWaitingForCheck = isCheckingInBackground() && m_backgroundChecker->isBusy();
+        m_connection->getUnderlyingConnection()->waitForResult(isWaitingForCheck ? 50 : 1000);
     }
 
     return SLANG_OK;
@@ -3,6 +3,7 @@
 #include "compiler-core/slang-json-rpc.h"
 #include "core/slang-range.h"
 #include "slang-language-server-auto-format.h"
+#include "slang-language-server-background-checker.h"
 #include "slang-language-server-completion.h"
 #include "slang-language-server-inlay-hints.h"
 #include "slang-workspace-version.h"
@@ -196,6 +197,14 @@ public:
     Dictionary<String, String> m_lastPublishedDiagnostics;
     HashSet<String> m_pendingModulesToUpdateDiagnostics;
 
+    // Checks documents for diagnostics and semantic tokens off the server thread, when
+    // diagnostics are updated periodically.
+    RefPtr<LanguageServerBackgroundChecker> m_backgroundChecker;
+
+    // Semantic tokens from the last background check, used to answer requests for documents
+    // that haven't changed since.
+    Dictionary<String, CheckedDocumentTokens> m_checkedSemanticTokens;
+
     void removePendingModuleToUpdateDiagnostics(const String& uri);
 
     LanguageServer(LanguageServerStartupOptions options)
@@ -251,6 +260,9 @@ private:
     SlangResult parseNextMessage();
     void resetDiagnosticUpdateTime();
     void publishDiagnostics();
+    void sendDiagnostics(const Dictionary<String, DocumentDiagnostics>& diagnostics);
+    bool isCheckingInBackground();
+    void recheckOpenDocuments();
     void updatePredefinedMacros(const JSONValue& macros);
     void updateSearchPaths(const JSONValue& value);
     void updateSearchInWorkspace(const JSONValue& value);
@@ -595,14 +595,8 @@ RefPtr<ComponentType> SpecializedComponentType::getRequirement(Index index)
 
 String SpecializedComponentType::getEntryPointMangledName(Index index)
 {
-    if (auto specializationInfo =
-            as<EntryPoint::EntryPointSpecializationInfo>(m_specializationInfo))
-    {
-        auto specializedFuncDeclRef = specializationInfo->specializedFuncDeclRef;
-        if (specializedFuncDeclRef)
-            return getMangledName(getLinkage()->getASTBuilder(), specializedFuncDeclRef);
-    }
-
+    // The names were mangled from the specialized declarations when this type was created, so
+    // composing and linking can read them without touching the linkage's AST builder.
     return m_entryPointMangledNames[index];
 }
 
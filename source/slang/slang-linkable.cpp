@@ -4,6 +4,7 @@
 #include "compiler-core/slang-artifact-container-util.h"
 #include "compiler-core/slang-artifact-desc-util.h"
 #include "compiler-core/slang-artifact-impl.h"
+#include "compiler-core/slang-artifact-util.h"
 #include "core/slang-char-util.h"
 #include "core/slang-memory-file-system.h"
 #include "slang-check-impl.h"
@@ -339,7 +340,8 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointMetadata(
     applySettingsToDiagnosticSink(&sink, &sink, linkage->m_optionSet);
     applySettingsToDiagnosticSink(&sink, &sink, m_optionSet);
 
-    IArtifact* artifact = targetProgram->getOrCreateEntryPointResult(entryPointIndex, &sink);
+    IArtifact* artifact =
+        targetProgram->getOrCreateEntryPointResult(entryPointIndex, &sink, true);
     sink.getBlobIfNeeded(outDiagnostics);
 
     if (artifact == nullptr)
@@ -395,6 +397,14 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::specialize(
     slang::IComponentType** outSpecializedComponentType,
     ISlangBlob** outDiagnostics)
 {
+    // Specializing with no arguments yields the component type itself, which needs none of the
+    // shared front-end state below.
+    if (specializationArgCount == 0)
+    {
+        *outSpecializedComponentType = ComPtr<slang::IComponentType>(this).detach();
+        return SLANG_OK;
+    }
+
     // Specialization still walks and mutates linkage-owned front-end state, so keep it
     // serialized with other component-type front-end operations.
     std::lock_guard<std::recursive_mutex> lock(getLinkage()->getComponentTypeOperationMutex());
@@ -460,9 +470,9 @@ RefPtr<ComponentType> fillRequirements(ComponentType* inComponentType);
 SLANG_NO_THROW SlangResult SLANG_MCALL
 ComponentType::link(slang::IComponentType** outLinkedComponentType, ISlangBlob** outDiagnostics)
 {
-    // Linking mutates the same shared linkage state as specialization/layout and is not yet part
-    // of the parallel backend-only execution model.
-    std::lock_guard<std::recursive_mutex> lock(getLinkage()->getComponentTypeOperationMutex());
+    // Linking only composes component types, which reads state that is fixed by the time a
+    // component type is handed to API callers, so it doesn't wait on specialization or layout
+    // running on other threads.
 
     // TODO: It should be possible for `fillRequirements` to fail,
     // in cases where we have a dependency that can't be automatically
@@ -682,7 +692,34 @@ void ComponentType::enumerateIRModules(EnumerateIRModulesCallback callback, void
     acceptVisitor(&visitor, nullptr);
 }
 
-IArtifact* ComponentType::getTargetArtifact(Int targetIndex, slang::IBlob** outDiagnostics)
+IArtifact* ComponentType::_publishTargetArtifact(Int targetIndex, IArtifact* artifact)
+{
+    // Publish the whole-program artifact only once and avoid racing the cache map. Another thread
+    // may have published one while this one was compiled.
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    ComPtr<IArtifact> existingArtifact;
+    if (!m_targetArtifacts.tryGetValue(targetIndex, existingArtifact))
+    {
+        m_targetArtifacts[targetIndex] = ComPtr<IArtifact>(artifact);
+        return artifact;
+    }
+
+    // The published artifact may already be in use, so if it came from the compilation cache it
+    // is kept, and given the metadata of this one.
+    if (artifact && existingArtifact &&
+        !findAssociatedRepresentation<IArtifactPostEmitMetadata>(existingArtifact))
+    {
+        ArtifactUtil::addAssociated(
+            existingArtifact,
+            findAssociatedRepresentation<IArtifactPostEmitMetadata>(artifact));
+    }
+    return existingArtifact.get();
+}
+
+IArtifact* ComponentType::getTargetArtifact(
+    Int targetIndex,
+    slang::IBlob** outDiagnostics,
+    bool requireMetadata)
 {
     auto linkage = getLinkage();
     if (targetIndex < 0 || targetIndex >= linkage->targets.getCount())
@@ -691,7 +728,9 @@ IArtifact* ComponentType::getTargetArtifact(Int targetIndex, slang::IBlob** outD
     {
         // Parallel backend requests can race this lookup, so guard the shared artifact cache.
         std::lock_guard<std::mutex> lock(m_cacheMutex);
-        if (m_targetArtifacts.tryGetValue(targetIndex, artifact))
+        if (m_targetArtifacts.tryGetValue(targetIndex, artifact) &&
+            (!requireMetadata || !artifact ||
+             findAssociatedRepresentation<IArtifactPostEmitMetadata>(artifact)))
         {
             return artifact.get();
         }
@@ -727,18 +766,11 @@ IArtifact* ComponentType::getTargetArtifact(Int targetIndex, slang::IBlob** outD
                 ComPtr<IComponentType> linkedComponentType;
                 SLANG_RETURN_NULL_ON_FAIL(
                     composite->link(linkedComponentType.writeRef(), outDiagnostics));
-                auto targetArtifact = static_cast<ComponentType*>(linkedComponentType.get())
-                                          ->getTargetArtifact(targetIndex, outDiagnostics);
+                auto targetArtifact =
+                    static_cast<ComponentType*>(linkedComponentType.get())
+                        ->getTargetArtifact(targetIndex, outDiagnostics, requireMetadata);
                 if (targetArtifact)
-                {
-                    // Another thread may have published the artifact while we were doing the
-                    // link above, so only commit the first cache entry.
-                    std::lock_guard<std::mutex> lock(m_cacheMutex);
-                    ComPtr<IArtifact> existingArtifact;
-                    if (m_targetArtifacts.tryGetValue(targetIndex, existingArtifact))
-                        return existingArtifact.get();
-                    m_targetArtifacts[targetIndex] = targetArtifact;
-                }
+                    return _publishTargetArtifact(targetIndex, targetArtifact);
                 return targetArtifact;
             }
         }
@@ -750,18 +782,10 @@ IArtifact* ComponentType::getTargetArtifact(Int targetIndex, slang::IBlob** outD
         applySettingsToDiagnosticSink(&sink, &sink, linkage->m_optionSet);
         applySettingsToDiagnosticSink(&sink, &sink, m_optionSet);
 
-        IArtifact* targetArtifact = targetProgram->getOrCreateWholeProgramResult(&sink);
+        IArtifact* targetArtifact =
+            targetProgram->getOrCreateWholeProgramResult(&sink, requireMetadata);
         sink.getBlobIfNeeded(outDiagnostics);
-        artifact = ComPtr<IArtifact>(targetArtifact);
-        {
-            // Publish the whole-program artifact only once and avoid racing the cache map.
-            std::lock_guard<std::mutex> lock(m_cacheMutex);
-            ComPtr<IArtifact> existingArtifact;
-            if (m_targetArtifacts.tryGetValue(targetIndex, existingArtifact))
-                return existingArtifact.get();
-            m_targetArtifacts[targetIndex] = artifact;
-        }
-        return artifact.get();
+        return _publishTargetArtifact(targetIndex, targetArtifact);
     }
     catch (const Exception& e)
     {
@@ -795,7 +819,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getTargetMetadata(
     slang::IMetadata** outMetadata,
     slang::IBlob** outDiagnostics)
 {
-    IArtifact* artifact = getTargetArtifact(targetIndex, outDiagnostics);
+    IArtifact* artifact = getTargetArtifact(targetIndex, outDiagnostics, true);
 
     if (artifact == nullptr)
         return SLANG_FAIL;
@@ -1197,19 +1221,16 @@ TargetProgram* ComponentType::getTargetProgram(TargetRequest* target)
             return targetProgram;
     }
 
-    // Constructing a TargetProgram can cascade into shared front-end work, so serialize it with
-    // other component-type operations.
-    std::lock_guard<std::recursive_mutex> operationLock(
-        getLinkage()->getComponentTypeOperationMutex());
+    // A TargetProgram only copies options when it is made; its layout is built later, under the
+    // linkage's operation mutex.
+    RefPtr<TargetProgram> newTargetProgram = new TargetProgram(this, target);
 
+    // Re-check under the cache lock so only one TargetProgram is published per target.
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    if (!m_targetPrograms.tryGetValue(target, targetProgram))
     {
-        // Re-check under the cache lock so only one TargetProgram is published per target.
-        std::lock_guard<std::mutex> lock(m_cacheMutex);
-        if (!m_targetPrograms.tryGetValue(target, targetProgram))
-        {
-            targetProgram = new TargetProgram(this, target);
-            m_targetPrograms[target] = targetProgram;
-        }
+        targetProgram = newTargetProgram;
+        m_targetPrograms[target] = targetProgram;
     }
     return targetProgram;
 }
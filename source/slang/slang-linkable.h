@@ -121,7 +121,12 @@ public:
         slang::IBlob** outCode,
         slang::IBlob** outDiagnostics) SLANG_OVERRIDE;
 
-    IArtifact* getTargetArtifact(SlangInt targetIndex, slang::IBlob** outDiagnostics);
+    /// Get the compiled code for the whole program on a target. If `requireMetadata` is set, a
+    /// result taken from the compilation cache is given its post-emit metadata.
+    IArtifact* getTargetArtifact(
+        SlangInt targetIndex,
+        slang::IBlob** outDiagnostics,
+        bool requireMetadata = false);
 
     SLANG_NO_THROW SlangResult SLANG_MCALL getTargetCode(
         SlangInt targetIndex,
@@ -412,6 +417,10 @@ public:
 protected:
     ComponentType(Linkage* linkage);
 
+    /// Publish the whole-program `artifact` for a target, returning whichever artifact was
+    /// published first if another thread published one.
+    IArtifact* _publishTargetArtifact(Int targetIndex, IArtifact* artifact);
+
 protected:
     Linkage* m_linkage;
     // Parallel backend emission shares these lazily populated target caches.
@@ -22,6 +22,7 @@
 #include "core/slang-stream.h"
 #include "core/slang-string-slice-pool.h"
 #include "core/slang-string-util.h"
+#include "core/slang-thread-pool.h"
 #include "core/slang-type-text-util.h"
 #include "slang-compiler-options.h"
 #include "slang-compiler.h"
@@ -617,6 +618,17 @@ void initCommandOptions(CommandOptions& options)
          nullptr,
          "Reports compiler performance benchmark results for each intermediate pass (implies "
          "-report-perf-benchmark)."},
+        {OptionKind::PerfTraceOutput,
+         "-report-perf-trace",
+         "-report-perf-trace <path>",
+         "Writes a Chrome Trace Event / Perfetto JSON file to <path>, recording each compiler "
+         "section and IR pass with the thread, module, entry point and target it ran for."},
+        {OptionKind::ReportPassStatistics,
+         "-report-pass-statistics",
+         "-report-pass-statistics <path>",
+         "Writes a JSON report to <path> listing, for each IR pass run on each output, the "
+         "instruction count before and after the pass, the instructions it created and removed, "
+         "and the bytes it allocated."},
         {OptionKind::ReportCheckpointIntermediates,
          "-report-checkpoint-intermediates",
          nullptr,
@@ -922,6 +934,16 @@ void initCommandOptions(CommandOptions& options)
          "-incomplete-library",
          nullptr,
          "Allow generating code from incomplete libraries with unresolved external functions"},
+        {OptionKind::LazyIRDeserialization,
+         "-lazy-ir-deserialization",
+         nullptr,
+         "When loading a precompiled module, only deserialize the IR of a function, generic or "
+         "witness table when the linker first needs it."},
+        {OptionKind::CodeGenThreadCount,
+         "-codegen-threads",
+         "-codegen-threads <count>",
+         "Generate code for the entry points of each target on <count> threads, counting the "
+         "calling thread. 0 uses one thread per hardware thread."},
         {OptionKind::BindlessSpaceIndex,
          "-bindless-space-index",
          "-bindless-space-index <index>",
@@ -1055,6 +1077,20 @@ void initCommandOptions(CommandOptions& options)
          "Pass arguments to downstream <compiler>. Just -X<compiler> passes just the next argument "
          "to the downstream compiler. -X<compiler>... options -X. will pass *all* of the options "
          "inbetween the opening -X and -X. to the downstream compiler."},
+        {OptionKind::DownstreamPrecompiledHeaderDirectory,
+         "-downstream-pch-dir",
+         "-downstream-pch-dir <path>",
+         "Keep a precompiled header for the prelude of generated C, C++ and CUDA source in the "
+         "directory <path>, and have gcc, clang and NVRTC (12.8 or later) compile against it "
+         "instead of parsing the prelude in every compile. Unless -downstream-pch-max-entries is "
+         "given, files are only ever added to the directory; remove them when no compile is using "
+         "it to reclaim the space."},
+        {OptionKind::DownstreamPrecompiledHeaderMaxEntryCount,
+         "-downstream-pch-max-entries",
+         "-downstream-pch-max-entries <count>",
+         "Keep at most <count> precompiled preludes in the -downstream-pch-dir directory, removing "
+         "the least recently used ones when a compile finishes and no other compile is using the "
+         "directory. 0 (the default) means no limit."},
         {OptionKind::PassThrough,
          "-pass-through",
          "-pass-through <compiler>",
@@ -1289,6 +1325,11 @@ void initCommandOptions(CommandOptions& options)
          "-loop-inversion",
          nullptr,
          "Enable loop inversion in the code-gen optimization. Default is off"},
+        {OptionKind::SimplifyRevisitAllFunctions,
+         "-simplify-revisit-all-functions",
+         nullptr,
+         "Run the function-local IR simplification passes on every function in every round, "
+         "instead of only on functions that may have changed since the previous round."},
         {OptionKind::GenerateWholeProgram,
          "-whole-program",
          nullptr,
@@ -2814,9 +2855,11 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
         case OptionKind::PreprocessorOutput:
         case OptionKind::DumpAst:
         case OptionKind::IncompleteLibrary:
+        case OptionKind::LazyIRDeserialization:
         case OptionKind::NoHLSLBinding:
         case OptionKind::NoHLSLPackConstantBufferElements:
         case OptionKind::LoopInversion:
+        case OptionKind::SimplifyRevisitAllFunctions:
         case OptionKind::UnscopedEnum:
         case OptionKind::PreserveParameters:
         case OptionKind::UseMSVCStyleBitfieldPacking:
@@ -2940,6 +2983,40 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
                 linkage->m_optionSet.set(CompilerOptionName::Doc, true);
                 break;
             }
+        case OptionKind::CodeGenThreadCount:
+            {
+                Int threadCount = 0;
+                SLANG_RETURN_ON_FAIL(_expectUInt(arg, threadCount));
+                if (threadCount == 0)
+                    threadCount = ThreadPool::getHardwareThreadCount();
+                linkage->m_optionSet.set(OptionKind::CodeGenThreadCount, int(threadCount));
+                break;
+            }
+        case OptionKind::DownstreamPrecompiledHeaderDirectory:
+            {
+                CommandLineArg directory;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(directory));
+                linkage->m_optionSet.set(
+                    OptionKind::DownstreamPrecompiledHeaderDirectory,
+                    directory.value);
+                break;
+            }
+        case OptionKind::DownstreamPrecompiledHeaderMaxEntryCount:
+            {
+                Int entryCount = 0;
+                SLANG_RETURN_ON_FAIL(_expectUInt(arg, entryCount));
+                linkage->m_optionSet.set(
+                    OptionKind::DownstreamPrecompiledHeaderMaxEntryCount,
+                    int(entryCount));
+                break;
+            }
+        case OptionKind::PerfTraceOutput:
+            {
+                CommandLineArg tracePath;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(tracePath));
+                linkage->m_optionSet.set(OptionKind::PerfTraceOutput, tracePath.value);
+                break;
+            }
         case OptionKind::DumpRepro:
             {
                 CommandLineArg dumpRepro;
@@ -3546,6 +3623,14 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
                 linkage->m_optionSet.set(CompilerOptionName::EmitReflectionJSON, outputPath.value);
                 break;
             }
+        case OptionKind::ReportPassStatistics:
+            {
+                CommandLineArg statisticsPath;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(statisticsPath));
+                linkage->m_optionSet.set(OptionKind::ReportPassStatistics, true);
+                m_requestImpl->m_passStatisticsOutputPath = statisticsPath.value;
+                break;
+            }
         case OptionKind::DepFile:
             {
                 CommandLineArg dependencyPath;
@@ -4839,6 +4839,12 @@ RefPtr<ProgramLayout> generateParameterBindings(TargetProgram* targetProgram, Di
 
 ProgramLayout* TargetProgram::getOrCreateLayout(DiagnosticSink* sink)
 {
+    // Once the layout and its IR module have been published they never change, so later
+    // callers (e.g. repeated `getLayout` or code generation on other threads) can share them
+    // without waiting on unrelated front-end work elsewhere in the linkage.
+    if (m_isLayoutComplete.load(std::memory_order_acquire))
+        return m_layout;
+
     // Layout construction still walks shared linkage-owned front-end state, so serialize it with
     // other component-type front-end operations.
     std::lock_guard<std::recursive_mutex> lock(
@@ -4858,6 +4864,8 @@ ProgramLayout* TargetProgram::getOrCreateLayout(DiagnosticSink* sink)
     {
         m_irModuleForLayout = createIRModuleForLayout(sink);
     }
+    if (m_layout && m_irModuleForLayout)
+        m_isLayoutComplete.store(true, std::memory_order_release);
     return m_layout;
 }
 
@@ -52,6 +52,49 @@ static void dumpIRForPass(CodeGenContext* codeGenContext, IRModule* irModule, co
         &writer);
 }
 
+static UInt64 _countInsts(IRInst* root)
+{
+    UInt64 count = 0;
+    List<IRInst*> workList;
+    workList.add(root);
+    while (workList.getCount())
+    {
+        auto inst = workList.getLast();
+        workList.removeLast();
+        count++;
+        for (auto child : inst->getDecorationsAndChildren())
+            workList.add(child);
+    }
+    return count;
+}
+
+void beginPassStatistics(IRModule* irModule, PassStatisticsSnapshot& outSnapshot)
+{
+    outSnapshot.instCount = _countInsts(irModule->getModuleInst());
+    outSnapshot.allocatedInstCount = irModule->getAllocatedInstCount();
+    outSnapshot.removedInstCount = irModule->getRemovedInstCount();
+    outSnapshot.arenaBytesUsed = irModule->getMemoryArena().calcTotalMemoryUsed();
+}
+
+void endPassStatistics(
+    CodeGenContext* codeGenContext,
+    IRModule* irModule,
+    const char* passName,
+    PassStatisticsSnapshot const& snapshot,
+    size_t extraBytesAllocated)
+{
+    slang::PassStatistics statistics;
+    statistics.passName = passName;
+    statistics.instCountBefore = snapshot.instCount;
+    statistics.instCountAfter = _countInsts(irModule->getModuleInst());
+    statistics.instsCreated = irModule->getAllocatedInstCount() - snapshot.allocatedInstCount;
+    statistics.instsRemoved = irModule->getRemovedInstCount() - snapshot.removedInstCount;
+    statistics.bytesAllocated =
+        irModule->getMemoryArena().calcTotalMemoryUsed() - snapshot.arenaBytesUsed +
+        extraBytesAllocated;
+    codeGenContext->getPassStatistics()->add(statistics);
+}
+
 void prePassHooks(CodeGenContext* codeGenContext, IRModule* irModule, const char* passName)
 {
     auto targetRequest = codeGenContext->getTargetReq();
@@ -20,6 +20,27 @@ struct CodeGenContext;
 void prePassHooks(CodeGenContext* codeGenContext, IRModule* irModule, const char* passName);
 void postPassHooks(CodeGenContext* codeGenContext, IRModule* irModule, const char* passName);
 
+// Module counters captured before a pass runs, from which its `slang::PassStatistics`
+// are computed once it finishes.
+struct PassStatisticsSnapshot
+{
+    UInt64 instCount = 0;
+    UInt64 allocatedInstCount = 0;
+    UInt64 removedInstCount = 0;
+    size_t arenaBytesUsed = 0;
+};
+
+void beginPassStatistics(IRModule* irModule, PassStatisticsSnapshot& outSnapshot);
+
+// Record the statistics for a pass that started at `snapshot`. `extraBytesAllocated` is memory
+// the pass used outside of the module's arena, such as the buffers of an emitter.
+void endPassStatistics(
+    CodeGenContext* codeGenContext,
+    IRModule* irModule,
+    const char* passName,
+    PassStatisticsSnapshot const& snapshot,
+    size_t extraBytesAllocated = 0);
+
 // RAII helper for pass hooks and performance profiling
 struct PassHooksRAII
 {
@@ -27,6 +48,7 @@ struct PassHooksRAII
     IRModule* irModule;
     const char* passName;
     std::optional<PerformanceProfilerFuncRAIIContext> perfContext;
+    std::optional<PassStatisticsSnapshot> statisticsSnapshot;
 
     PassHooksRAII(CodeGenContext* ctx, IRModule* module, const char* name)
         : codeGenContext(ctx), irModule(module), passName(name)
@@ -35,15 +57,24 @@ struct PassHooksRAII
 
         auto targetRequest = codeGenContext->getTargetReq();
         auto targetCompilerOptions = targetRequest->getOptionSet();
-        if (targetCompilerOptions.getBoolOption(CompilerOptionName::ReportDetailedPerfBenchmark))
+        if (targetCompilerOptions.getBoolOption(CompilerOptionName::ReportDetailedPerfBenchmark) ||
+            PerformanceTracer::getTracer()->isEnabled())
         {
             perfContext.emplace(passName);
         }
+
+        if (codeGenContext->getPassStatistics() && irModule)
+        {
+            statisticsSnapshot.emplace();
+            beginPassStatistics(irModule, *statisticsSnapshot);
+        }
     }
 
     ~PassHooksRAII()
     {
         perfContext.reset(); // End profiler timing before post hooks
+        if (statisticsSnapshot)
+            endPassStatistics(codeGenContext, irModule, passName, *statisticsSnapshot);
         postPassHooks(codeGenContext, irModule, passName);
     }
 };
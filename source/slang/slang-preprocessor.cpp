@@ -519,7 +519,10 @@ struct LexerInputStream : InputStream
 {
     typedef InputStream Super;
 
-    LexerInputStream(Preprocessor* preprocessor, SourceView* sourceView);
+    LexerInputStream(
+        Preprocessor* preprocessor,
+        SourceView* sourceView,
+        LexedSourceFile* lexedFile = nullptr);
 
     Lexer* getLexer() { return &m_lexer; }
 
@@ -545,6 +548,15 @@ private:
     /// Read a token from the lexer, bypassing lookahead
     Token _readTokenImpl()
     {
+        if (m_lexedFile)
+        {
+            // Keep returning the end-of-file token once it has been reached, as the lexer does
+            const Index index = m_lexedTokenIndex;
+            if (index < m_lexedFile->tokens.getCount() - 1)
+                m_lexedTokenIndex++;
+            return m_lexedFile->getToken(index, m_lexer.m_sourceView);
+        }
+
         for (;;)
         {
             Token token = m_lexer.lexToken();
@@ -564,6 +576,10 @@ private:
     /// The lexer state that will provide input
     Lexer m_lexer;
 
+    /// Tokens lexed by an earlier include of the same file, read instead of running `m_lexer`
+    RefPtr<LexedSourceFile> m_lexedFile;
+    Index m_lexedTokenIndex = 0;
+
     /// One token of lookahead
     Token m_lookaheadToken;
 };
@@ -949,7 +965,10 @@ private:
 ///
 struct InputFile
 {
-    InputFile(Preprocessor* preprocessor, SourceView* sourceView);
+    InputFile(
+        Preprocessor* preprocessor,
+        SourceView* sourceView,
+        LexedSourceFile* lexedFile = nullptr);
 
     ~InputFile();
 
@@ -985,9 +1004,65 @@ struct InputFile
 
     bool isIncludedFile() { return m_parent != nullptr; }
 
+    /// Note a token or directive that isn't inside any conditional
+    void noteInputOutsideConditionals() { m_includeGuardState = IncludeGuardState::NotGuarded; }
+
+    /// Note an `#ifndef` for `macroName`, which may be the start of an include guard
+    void noteIfNDef(Name* macroName)
+    {
+        if (m_conditional->parent)
+            return;
+        if (m_includeGuardState == IncludeGuardState::Start)
+        {
+            m_includeGuardState = IncludeGuardState::InGuard;
+            m_includeGuardMacroName = macroName;
+        }
+        else
+        {
+            m_includeGuardState = IncludeGuardState::NotGuarded;
+        }
+    }
+
+    /// Note an `#else` or `#elif` that belongs to `conditional`
+    void noteElseBranch(Conditional* conditional)
+    {
+        if (!conditional->parent && m_includeGuardState == IncludeGuardState::InGuard)
+            m_includeGuardState = IncludeGuardState::NotGuarded;
+    }
+
+    /// Note the `#endif` that closes `conditional`
+    void noteEndIf(Conditional* conditional)
+    {
+        if (!conditional->parent && m_includeGuardState == IncludeGuardState::InGuard)
+            m_includeGuardState = IncludeGuardState::AfterGuard;
+    }
+
+    /// Get the macro of the include guard that wraps everything in the file, or null if there is
+    /// no such guard. Only meaningful once the whole file has been read.
+    Name* getIncludeGuardMacroName()
+    {
+        return m_includeGuardState == IncludeGuardState::AfterGuard ? m_includeGuardMacroName
+                                                                    : nullptr;
+    }
+
 private:
     friend struct Preprocessor;
 
+    /// How far through an include guard the file has been read.
+    ///
+    /// A file is guarded when everything in it is inside a single `#ifndef` conditional with no
+    /// `#else` or `#elif`. Including it again while the macro is defined produces nothing, so the
+    /// preprocessor can skip the file without reading it.
+    enum class IncludeGuardState
+    {
+        Start,
+        InGuard,
+        AfterGuard,
+        NotGuarded,
+    };
+    IncludeGuardState m_includeGuardState = IncludeGuardState::Start;
+    Name* m_includeGuardMacroName = nullptr;
+
     /// The parent preprocessor
     Preprocessor* m_preprocessor = nullptr;
 
@@ -1302,6 +1377,10 @@ struct Preprocessor
     /// stop them from being included again.
     HashSet<String> pragmaOnceUniqueIdentities;
 
+    /// The include guard macro of each file, by unique identity, that has been read and found to
+    /// be wrapped entirely in one. Such a file can be skipped while its macro is defined.
+    Dictionary<String, Name*> includeGuardMacroNames;
+
     /// The unique identities of any paths that have been included already.
     /// This is used to detect cycles in #includes.
     HashSet<String> includedFiles;
@@ -1328,6 +1407,9 @@ struct Preprocessor
     /// Stores macro definition and invocation info for language server.
     PreprocessorContentAssistInfo* contentAssistInfo = nullptr;
 
+    /// Tokens of `#include`d files lexed by earlier includes, if any
+    LexedSourceFileCache* lexedSourceFileCache = nullptr;
+
     NamePool* getNamePool() { return namePool; }
     SourceManager* getSourceManager() { return sourceManager; }
 
@@ -1404,19 +1486,26 @@ DiagnosticSink* InputStream::getSink()
 // Basic Input Handling
 //
 
-LexerInputStream::LexerInputStream(Preprocessor* preprocessor, SourceView* sourceView)
+LexerInputStream::LexerInputStream(
+    Preprocessor* preprocessor,
+    SourceView* sourceView,
+    LexedSourceFile* lexedFile)
     : Super(preprocessor)
+    , m_lexedFile(lexedFile)
 {
     MemoryArena* memoryArena = sourceView->getSourceManager()->getMemoryArena();
     m_lexer.initialize(sourceView, GetSink(preprocessor), preprocessor->getNamePool(), memoryArena);
     m_lookaheadToken = _readTokenImpl();
 }
 
-InputFile::InputFile(Preprocessor* preprocessor, SourceView* sourceView)
+InputFile::InputFile(
+    Preprocessor* preprocessor,
+    SourceView* sourceView,
+    LexedSourceFile* lexedFile)
 {
     m_preprocessor = preprocessor;
 
-    m_lexerStream = new LexerInputStream(preprocessor, sourceView);
+    m_lexerStream = new LexerInputStream(preprocessor, sourceView, lexedFile);
     m_expansionStream = new ExpansionInputStream(preprocessor, m_lexerStream);
 }
 
@@ -3396,6 +3485,7 @@ static void HandleIfNDefDirective(PreprocessorDirectiveContext* context)
 
     // Check if the name is defined.
     beginConditional(context, LookupMacro(context, name) == NULL);
+    getInputFile(context)->noteIfNDef(name);
 }
 
 // Handle a `#else` directive
@@ -3425,6 +3515,7 @@ static void HandleElseDirective(PreprocessorDirectiveContext* context)
         return;
     }
     conditional->elseToken = context->m_directiveToken;
+    inputFile->noteElseBranch(conditional);
 
     switch (conditional->state)
     {
@@ -3487,6 +3578,8 @@ static void HandleElifDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
+    inputFile->noteElseBranch(conditional);
+
     switch (conditional->state)
     {
     case Conditional::State::Before:
@@ -3533,6 +3626,7 @@ static void HandleEndIfDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
+    inputFile->noteEndIf(conditional);
     inputFile->popConditional();
 
     updateLexerFlagsForConditionals(inputFile);
@@ -3682,6 +3776,17 @@ static void HandleIncludeDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
+    // Check whether the file is wrapped in an include guard whose macro is still defined, in
+    // which case including it again would produce nothing
+    Name* includeGuardMacroName = nullptr;
+    if (context->m_preprocessor->includeGuardMacroNames.tryGetValue(
+            filePathInfo.uniqueIdentity,
+            includeGuardMacroName) &&
+        LookupMacro(context, includeGuardMacroName))
+    {
+        return;
+    }
+
     // Simplify the path
     filePathInfo.foundPath = includeSystem->simplifyPath(filePathInfo.foundPath);
 
@@ -3728,7 +3833,12 @@ static void HandleIncludeDirective(PreprocessorDirectiveContext* context)
     SourceView* sourceView =
         sourceManager->createSourceView(sourceFile, &filePathInfo, directiveLoc);
 
-    InputFile* inputFile = new InputFile(context->m_preprocessor, sourceView);
+    // Files included many times are only lexed once
+    RefPtr<LexedSourceFile> lexedFile;
+    if (auto lexedSourceFileCache = context->m_preprocessor->lexedSourceFileCache)
+        lexedFile = lexedSourceFileCache->getOrLex(sourceView, context->m_preprocessor->namePool);
+
+    InputFile* inputFile = new InputFile(context->m_preprocessor, sourceView, lexedFile);
 
     context->m_preprocessor->pushInputFile(inputFile, directiveLoc, fileIdentity);
 }
@@ -4729,6 +4839,14 @@ static void HandleDirective(PreprocessorDirectiveContext* context)
     // Look up the handler for the directive.
     PreprocessorDirective const* directive = FindDirective(GetDirectiveName(context));
 
+    // Only an `#ifndef` can start an include guard, so any other directive
+    // outside of a conditional means the file doesn't have one.
+    InputFile* inputFile = getInputFile(context);
+    if (!inputFile->getInnerMostConditional() && directive->callback != &HandleIfNDefDirective)
+    {
+        inputFile->noteInputOutsideConditionals();
+    }
+
     // If we are skipping disabled code, and the directive is not one
     // of the small number that need to run even in that case, skip it.
     if (isSkipping(context) && !(directive->flags & PreprocessorDirectiveFlag::ProcessWhenSkipping))
@@ -4781,7 +4899,14 @@ void Preprocessor::popInputFile()
         auto lastSegment = sourceView->getLastSegment();
         absoluteSourceLocCounter +=
             SourceRange(lastSegment.begin, sourceView->getRange().end).getSize();
-        includedFiles.remove(sourceView->getSourceFile()->getPathInfo().getMostUniqueIdentity());
+        auto& pathInfo = sourceView->getSourceFile()->getPathInfo();
+        includedFiles.remove(pathInfo.getMostUniqueIdentity());
+
+        if (auto includeGuardMacroName = inputFile->getIncludeGuardMacroName())
+        {
+            if (pathInfo.hasUniqueIdentity())
+                includeGuardMacroNames[pathInfo.uniqueIdentity] = includeGuardMacroName;
+        }
     }
 
     // We will update the current file to the parent of whatever
@@ -4847,6 +4972,10 @@ static Token ReadToken(Preprocessor* preprocessor)
             continue;
         }
 
+        // A token outside of any conditional means the file has no include guard
+        if (!inputFile->getInnerMostConditional())
+            inputFile->noteInputOutsideConditionals();
+
         // otherwise, if we are currently in a skipping mode, then skip tokens
         if (inputFile->isSkipping())
         {
@@ -5009,6 +5138,97 @@ Result findMacroValue(
     return SLANG_OK;
 }
 
+Token LexedSourceFile::getToken(Index index, SourceView* sourceView) const
+{
+    Token token = tokens[index];
+    token.loc = sourceView->getRange().begin + Int(token.loc.getRaw());
+    const Index contentOffset = contentOffsets[index];
+    if (contentOffset >= 0)
+        token.charsNameUnion.chars = sourceView->getContent().begin() + contentOffset;
+    return token;
+}
+
+RefPtr<LexedSourceFile> LexedSourceFileCache::getOrLex(SourceView* sourceView, NamePool* namePool)
+{
+    SourceFile* sourceFile = sourceView->getSourceFile();
+    const PathInfo& pathInfo = sourceFile->getPathInfo();
+    if (m_compileCount == 0 || !pathInfo.hasUniqueIdentity())
+        return nullptr;
+
+    const UnownedStringSlice content = sourceView->getContent();
+    const HashCode64 contentHash = getHashCode(content.begin(), content.getLength());
+
+    RefPtr<LexedSourceFile> lexedFile;
+    if (m_files.tryGetValue(pathInfo.uniqueIdentity, lexedFile) &&
+        lexedFile->contentHash == contentHash && lexedFile->contentLength == content.getLength())
+    {
+        if (!lexedFile->isCacheable)
+            return nullptr;
+        return lexedFile;
+    }
+
+    lexedFile = new LexedSourceFile();
+    lexedFile->contentHash = contentHash;
+    lexedFile->contentLength = content.getLength();
+
+    // Lex with a sink of our own, so that diagnostics can be detected without being reported.
+    // The include that uses the file lexes it again if there are any.
+    SourceManager* sourceManager = sourceView->getSourceManager();
+    DiagnosticSink sink(sourceManager, Lexer::sourceLocationLexer);
+    Lexer lexer;
+    lexer.initialize(sourceView, &sink, namePool, sourceManager->getMemoryArena());
+
+    const SourceLoc startLoc = sourceView->getRange().begin;
+    for (;;)
+    {
+        Token token = lexer.lexToken();
+        switch (token.type)
+        {
+        case TokenType::WhiteSpace:
+        case TokenType::BlockComment:
+        case TokenType::LineComment:
+            continue;
+        default:
+            break;
+        }
+
+        Index contentOffset = -1;
+        if (!(token.flags & TokenFlag::Name) && token.hasContent())
+        {
+            const char* chars = token.charsNameUnion.chars;
+            if (chars >= content.begin() && chars + token.charsCount <= content.end())
+            {
+                contentOffset = Index(chars - content.begin());
+            }
+            else
+            {
+                lexedFile->ownedContents.add(String(token.getContent()));
+                token.charsNameUnion.chars = lexedFile->ownedContents.getLast().getBuffer();
+            }
+        }
+        token.loc = SourceLoc::fromRaw(token.loc.getRaw() - startLoc.getRaw());
+
+        lexedFile->tokens.add(token);
+        lexedFile->contentOffsets.add(contentOffset);
+
+        if (token.type == TokenType::EndOfFile)
+            break;
+    }
+
+    if (sink.getErrorCount() != 0 || sink.outputBuffer.getLength() != 0)
+    {
+        lexedFile->isCacheable = false;
+        lexedFile->tokens = List<Token>();
+        lexedFile->contentOffsets = List<Index>();
+        lexedFile->ownedContents = List<String>();
+    }
+
+    m_files[pathInfo.uniqueIdentity] = lexedFile;
+    if (!lexedFile->isCacheable)
+        return nullptr;
+    return lexedFile;
+}
+
 TokenList preprocessSource(
     SourceFile* file,
     DiagnosticSink* sink,
@@ -5030,6 +5250,7 @@ TokenList preprocessSource(
     desc.fileSystem = linkage->getFileSystemExt();
     desc.namePool = linkage->getNamePool();
     desc.sourceManager = linkage->getSourceManager();
+    desc.lexedSourceFileCache = &linkage->m_lexedSourceFileCache;
 
     if (linkage->isInLanguageServer())
     {
@@ -5066,6 +5287,7 @@ TokenList preprocessSource(
     preprocessor.endOfFileToken.type = TokenType::EndOfFile;
     preprocessor.endOfFileToken.flags = TokenFlag::AtStartOfLine;
     preprocessor.contentAssistInfo = desc.contentAssistInfo;
+    preprocessor.lexedSourceFileCache = desc.lexedSourceFileCache;
 
     preprocessor.warningStateTracker =
         dynamicCast<preprocessor::WarningStateTracker>(desc.sink->getSourceWarningStateTracker());
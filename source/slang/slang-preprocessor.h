@@ -33,6 +33,76 @@ struct PreprocessorHandler
     virtual void handleFileDependency(SourceFile* sourceFile);
 };
 
+/// The tokens of a source file, lexed once so that later includes of the same content don't run
+/// the lexer again.
+///
+/// Token locations are stored as offsets from the start of the file, and token content as offsets
+/// into the file's content, so the tokens can be placed in any `SourceView` of a file with the
+/// same content.
+struct LexedSourceFile : RefObject
+{
+    /// Get token `index` as it would be lexed from `sourceView`
+    Token getToken(Index index, SourceView* sourceView) const;
+
+    /// The tokens, without whitespace and comments, ending with the end-of-file token
+    List<Token> tokens;
+
+    /// The offset of each token's content in the file, or -1 if the token holds its own content
+    List<Int> contentOffsets;
+
+    /// Content of tokens that isn't a slice of the file, such as text with escaped newlines
+    /// removed
+    List<String> ownedContents;
+
+    HashCode64 contentHash = 0;
+    Index contentLength = 0;
+
+    /// False if lexing the file reported diagnostics. Whether those are shown depends on where
+    /// the file is included, so such a file is always lexed again.
+    bool isCacheable = true;
+};
+
+/// A cache of lexed source files, keyed on the unique identity of each file.
+///
+/// Files are only cached while a compile is running, as marked by a `CompileScope`, and the cache
+/// is emptied when the outermost scope ends. Tokens are shared by the translation units and
+/// imported modules of one compile, but a later compile lexes files again, so it never sees tokens
+/// of a file that has since changed.
+class LexedSourceFileCache
+{
+public:
+    /// Marks a compile on the linkage that owns the cache as running.
+    class CompileScope
+    {
+    public:
+        explicit CompileScope(LexedSourceFileCache* cache)
+            : m_cache(cache)
+        {
+            m_cache->m_compileCount++;
+        }
+        ~CompileScope()
+        {
+            if (--m_cache->m_compileCount == 0)
+                m_cache->m_files.clear();
+        }
+
+        CompileScope(const CompileScope&) = delete;
+        CompileScope& operator=(const CompileScope&) = delete;
+
+    private:
+        LexedSourceFileCache* m_cache;
+    };
+
+    /// Get the tokens of the file shown by `sourceView`, lexing it if the cache doesn't have
+    /// tokens for its current content. Returns null if the file can't be cached, or if no compile
+    /// is running.
+    RefPtr<LexedSourceFile> getOrLex(SourceView* sourceView, NamePool* namePool);
+
+private:
+    Dictionary<String, RefPtr<LexedSourceFile>> m_files;
+    Index m_compileCount = 0;
+};
+
 /// Description of a preprocessor options/dependencies
 struct PreprocessorDesc
 {
@@ -59,6 +129,9 @@ struct PreprocessorDesc
 
     /// Optional: additional information for code assist.
     PreprocessorContentAssistInfo* contentAssistInfo = nullptr;
+
+    /// Optional: cache of lexed `#include`d files to reuse
+    LexedSourceFileCache* lexedSourceFileCache = nullptr;
 };
 
 /// Take a source `file` and preprocess it into a list of tokens.
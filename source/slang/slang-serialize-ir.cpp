@@ -15,6 +15,9 @@
 #include "slang-tag-version.h"
 #include "slang.h"
 
+#include <atomic>
+#include <mutex>
+
 //
 #include "slang-serialize-ir.cpp.fiddle"
 
@@ -280,8 +283,13 @@ struct IRSerialWriteContext : SourceLocSerialContext
 
 struct IRSerialReadContext : SourceLocSerialContext, RefObject
 {
-    IRSerialReadContext(Session* session, SerialSourceLocReader* sourceLocReader)
-        : _session(session), _sourceLocReader(sourceLocReader)
+    IRSerialReadContext(
+        Session* session,
+        SerialSourceLocReader* sourceLocReader,
+        bool deserializeLazily)
+        : _session(session)
+        , _sourceLocReader(sourceLocReader)
+        , _deserializeLazily(deserializeLazily)
     {
     }
     virtual void handleIRModule(IRReadSerializer const& serializer, IRModule*& value);
@@ -299,6 +307,9 @@ struct IRSerialReadContext : SourceLocSerialContext, RefObject
 
     //
     bool _foundUnrecognizedInstructions = false;
+
+    // Leave the bodies of global values to be read in on demand
+    bool _deserializeLazily = false;
 };
 
 SLANG_DECLARE_FOSSILIZED_AS(Name, String);
@@ -453,6 +464,8 @@ void serializeObject(S const& serializer, IRModule*& value, IRModule*)
 
 static void serializeAsFlatModule(const IRWriteSerializer& serializer, IRModuleInst* moduleInst)
 {
+    moduleInst->getModule()->materializeAll();
+
     FlatInstTable flat;
     Dictionary<IRInst*, Int64> instMap;
     instMap.add(nullptr, -1);
@@ -518,39 +531,245 @@ static void serializeAsFlatModule(const IRWriteSerializer& serializer, IRModuleI
     serialize(serializer, flat);
 }
 
-static IRModuleInst* deserializeFromFlatModule(const IRReadSerializer& serializer, IRModule* module)
+// Rebuilds IR instructions from a `FlatInstTable`.
+//
+// An eager read rebuilds the whole module at once. A lazy read leaves the non-decoration
+// children of module-level functions, generics and witness tables in the table as
+// "deferred bodies", and only rebuilds one of those when the linker asks for it through
+// `IRModule::materialize`. The decorations of those global values are always read, since
+// the linker inspects them to choose between candidate definitions of a symbol.
+//
+struct FlatModuleReader : IRLazyModuleLoader
 {
-    IRSerialReadContext& readContext = *serializer.getContext();
-    FlatInstTable flat;
-    serialize(serializer, flat);
-    const List<SourceLoc>& sourceLocs = flat.sourceLocs;
-    // dumpFlatInstTableStats(flat, "deserializing");
+    // Position of the reader in each of the parallel lists of a `FlatInstTable`.
+    struct Cursor
+    {
+        Int64 instIndex = 0;
+        Int64 operandIndex = 0;
+        Int64 literalIndex = 0;
+        Int64 stringLengthIndex = 0;
+        Int64 stringDataIndex = 0;
+    };
 
-    Int64 stringLengthIndex = 0;
-    List<IRInst*> instsList;
+    // The non-decoration children of one module-level global value. Instructions are
+    // stored in preorder, so these are a contiguous run ending where the owner's subtree
+    // ends.
+    struct DeferredBody
+    {
+        Int64 ownerIndex = 0;
+        Int64 childCount = 0;
+        Cursor begin;
+        Cursor end;
+        bool isMaterialized = false;
+    };
 
-    const auto numInsts = flat.instAllocInfo.getCount();
+    FlatModuleReader(IRModule* module)
+        : m_module(module)
+    {
+    }
 
-    const auto operandIndicesCount = flat.operandIndices.getCount();
+    IRModuleInst* read(bool deserializeLazily);
 
-    // These relationships are serialized IR invariants; stop before rebuilding pointers from
-    // inconsistent flat tables.
-    SLANG_RELEASE_ASSERT(flat.childCounts.getCount() == numInsts);
-    SLANG_RELEASE_ASSERT(sourceLocs.getCount() == numInsts);
+    void materialize(IRInst* globalValue) override;
+    void materializeAll() override;
+    bool anyUnmaterializedInst(bool (*predicate)(IROp)) override;
+    Index getUnmaterializedCount() override { return m_pendingBodyCount; }
 
-    instsList.setCount(numInsts + 1);
-    // nullptr instructions are represented as `-1`. We can save ourselves a
-    // branch by just making that index valid.
-    IRInst** const insts = &instsList[1];
-    insts[-1] = nullptr;
+    FlatInstTable m_flat;
+    IRModule* m_module = nullptr;
+    bool m_foundUnrecognizedInstructions = false;
+
+private:
+    static bool _canDeferBody(IROp op)
+    {
+        return op == kIROp_Func || op == kIROp_Generic || op == kIROp_WitnessTable;
+    }
+
+    Int64 _skipSubtree(Int64 instIndex);
+    void _advance(Cursor& cursor);
+    void _findDeferredBodies();
+    Int64 _allocateInsts(Int64 beginIndex, Int64 endIndex, Int64 stringLengthIndex);
+    IRInst* _readInstRef(Cursor& cursor);
+    IRInst* _readInst(Cursor& cursor, IRInst* parent, Int64 depth);
+    void _readChildren(Cursor& cursor, IRInst* parent, Int64 childCount, Int64 depth);
+    void _materializeBody(Index bodyIndex);
+    Index _findBodyContaining(Int64 instIndex);
+    void _releaseTableIfDone();
+
+    Int64 m_instCount = 0;
+    List<IRInst*> m_instsList;
+    // Points at `m_instsList[1]`, so that the null operand index `-1` maps to nullptr.
+    IRInst** m_insts = nullptr;
+
+    // Sorted by position in the table.
+    List<DeferredBody> m_deferredBodies;
+    Index m_nextDeferredBody = 0;
+    Dictionary<IRInst*, Index> m_deferredBodyForOwner;
+    // Only changed under `m_mutex`, but read without it to skip the lock once every body has
+    // been read in.
+    std::atomic<Index> m_pendingBodyCount = 0;
+};
+
+Int64 FlatModuleReader::_skipSubtree(Int64 instIndex)
+{
+    Int64 pending = 1;
+    while (pending != 0)
+    {
+        SLANG_RELEASE_ASSERT(instIndex < m_instCount);
+        const auto childCount = m_flat.childCounts[instIndex++];
+        SLANG_RELEASE_ASSERT(childCount >= 0);
+        pending += childCount - 1;
+    }
+    return instIndex;
+}
+
+void FlatModuleReader::_advance(Cursor& cursor)
+{
+    const auto& a = m_flat.instAllocInfo[cursor.instIndex++];
+    cursor.operandIndex += 1 + Int64(a.operandCount);
+    switch (a.op)
+    {
+    case kIROp_BoolLit:
+    case kIROp_IntLit:
+    case kIROp_FloatLit:
+    case kIROp_PtrLit:
+        cursor.literalIndex++;
+        break;
+    case kIROp_StringLit:
+    case kIROp_BlobLit:
+        SLANG_RELEASE_ASSERT(cursor.stringLengthIndex < m_flat.stringLengths.getCount());
+        cursor.stringDataIndex += m_flat.stringLengths[cursor.stringLengthIndex++];
+        break;
+    }
+}
+
+void FlatModuleReader::_findDeferredBodies()
+{
+    // We can't tell how much payload data an opcode we don't recognize consumes, so
+    // we can't find where a deferred body starts in the payload lists.
+    for (const auto& a : m_flat.instAllocInfo)
+    {
+        if (a.op == kIROp_Invalid)
+            return;
+    }
+    if (m_instCount == 0)
+        return;
+
+    Int64 instIndex = 1;
+    const auto moduleChildCount = m_flat.childCounts[0];
+    for (Int64 i = 0; i < moduleChildCount; ++i)
+    {
+        const auto ownerIndex = instIndex;
+        instIndex = _skipSubtree(ownerIndex);
+        if (!_canDeferBody(m_flat.instAllocInfo[ownerIndex].op))
+            continue;
+
+        // Decorations come before any other children.
+        Int64 bodyIndex = ownerIndex + 1;
+        Int64 bodyChildCount = m_flat.childCounts[ownerIndex];
+        while (bodyChildCount != 0 && IRDecoration::isaImpl(m_flat.instAllocInfo[bodyIndex].op))
+        {
+            bodyIndex = _skipSubtree(bodyIndex);
+            bodyChildCount--;
+        }
+        if (bodyChildCount == 0)
+            continue;
+
+        DeferredBody body;
+        body.ownerIndex = ownerIndex;
+        body.childCount = bodyChildCount;
+        body.begin.instIndex = bodyIndex;
+        body.end.instIndex = instIndex;
+        m_deferredBodies.add(body);
+    }
+
+    // Everything outside of a deferred body is read eagerly, so it must not reference
+    // anything inside one. Read any such body eagerly too, and repeat until no eager
+    // instruction references into a deferred body. The last pass also records where
+    // each remaining body starts and ends in the other lists of the table.
+    const Index kNotDeferred = -1;
+    List<Index> bodyForInst;
+    bodyForInst.setCount(m_instCount);
+    for (auto& b : bodyForInst)
+        b = kNotDeferred;
+    for (Index i = 0; i < m_deferredBodies.getCount(); ++i)
+    {
+        const auto& body = m_deferredBodies[i];
+        for (auto j = body.begin.instIndex; j < body.end.instIndex; ++j)
+            bodyForInst[j] = i;
+    }
+
+    List<bool> isBodyEager;
+    isBodyEager.setCount(m_deferredBodies.getCount());
+    for (auto& e : isBodyEager)
+        e = false;
+
+    const auto operandIndicesCount = m_flat.operandIndices.getCount();
+    for (bool changed = true; changed;)
+    {
+        changed = false;
+        Cursor cursor;
+        while (cursor.instIndex < m_instCount)
+        {
+            const auto instIndex = cursor.instIndex;
+            const auto bodyIndex = bodyForInst[instIndex];
+            if (bodyIndex != kNotDeferred &&
+                m_deferredBodies[bodyIndex].begin.instIndex == instIndex)
+                m_deferredBodies[bodyIndex].begin = cursor;
+
+            const auto refCount = 1 + Int64(m_flat.instAllocInfo[instIndex].operandCount);
+            SLANG_RELEASE_ASSERT(refCount <= operandIndicesCount - cursor.operandIndex);
+            if (bodyIndex == kNotDeferred)
+            {
+                for (Int64 r = 0; r < refCount; ++r)
+                {
+                    const auto refIndex = m_flat.operandIndices[cursor.operandIndex + r];
+                    SLANG_RELEASE_ASSERT(refIndex >= -1 && refIndex < m_instCount);
+                    if (refIndex < 0 || bodyForInst[refIndex] == kNotDeferred)
+                        continue;
+                    const auto refBodyIndex = bodyForInst[refIndex];
+                    if (!isBodyEager[refBodyIndex])
+                    {
+                        isBodyEager[refBodyIndex] = true;
+                        changed = true;
+                    }
+                }
+            }
 
-    for (Int64 instIndex = 0; instIndex < numInsts; ++instIndex)
+            _advance(cursor);
+            if (bodyIndex != kNotDeferred &&
+                m_deferredBodies[bodyIndex].end.instIndex == cursor.instIndex)
+                m_deferredBodies[bodyIndex].end = cursor;
+        }
+
+        for (Index i = 0; i < m_deferredBodies.getCount(); ++i)
+        {
+            if (!isBodyEager[i] || bodyForInst[m_deferredBodies[i].begin.instIndex] != i)
+                continue;
+            const auto& body = m_deferredBodies[i];
+            for (auto j = body.begin.instIndex; j < body.end.instIndex; ++j)
+                bodyForInst[j] = kNotDeferred;
+        }
+    }
+
+    List<DeferredBody> deferredBodies;
+    for (Index i = 0; i < m_deferredBodies.getCount(); ++i)
+    {
+        if (!isBodyEager[i])
+            deferredBodies.add(m_deferredBodies[i]);
+    }
+    m_deferredBodies = _Move(deferredBodies);
+}
+
+Int64 FlatModuleReader::_allocateInsts(Int64 beginIndex, Int64 endIndex, Int64 stringLengthIndex)
+{
+    for (Int64 instIndex = beginIndex; instIndex < endIndex; ++instIndex)
     {
-        const auto& a = flat.instAllocInfo[instIndex];
+        const auto& a = m_flat.instAllocInfo[instIndex];
         IROp op = a.op;
         if (op == kIROp_Invalid) [[unlikely]]
         {
-            readContext._foundUnrecognizedInstructions = true;
+            m_foundUnrecognizedInstructions = true;
             op = kIROp_Unrecognized;
         }
         size_t minSizeInBytes = 0;
@@ -571,8 +790,8 @@ static IRModuleInst* deserializeFromFlatModule(const IRReadSerializer& serialize
         case kIROp_StringLit:
         case kIROp_BlobLit:
             {
-                SLANG_RELEASE_ASSERT(stringLengthIndex < flat.stringLengths.getCount());
-                const auto len = flat.stringLengths[stringLengthIndex++];
+                SLANG_RELEASE_ASSERT(stringLengthIndex < m_flat.stringLengths.getCount());
+                const auto len = m_flat.stringLengths[stringLengthIndex++];
                 SLANG_RELEASE_ASSERT(len >= 0);
                 SLANG_RELEASE_ASSERT(uint64_t(len) <= uint64_t(UINT32_MAX));
 
@@ -584,126 +803,293 @@ static IRModuleInst* deserializeFromFlatModule(const IRReadSerializer& serialize
                 break;
             }
         }
-        insts[instIndex] = module->_allocateInst(op, a.operandCount, minSizeInBytes);
+        m_insts[instIndex] = m_module->_allocateInst(op, a.operandCount, minSizeInBytes);
     }
+    return stringLengthIndex;
+}
 
-    Int64 litIndex = 0;
-    Int64 operandIndex = 0;
-    Int64 instIndex = 0;
-    stringLengthIndex = 0;
-    Int64 stringDataIndex = 0;
-    auto readInstRef = [&]() -> IRInst*
-    {
-        SLANG_RELEASE_ASSERT(operandIndex < operandIndicesCount);
-        const auto index = flat.operandIndices[operandIndex++];
-        SLANG_RELEASE_ASSERT(index >= -1 && index < numInsts);
-        return insts[index];
-    };
-    const auto go = [&](auto& go, IRInst* parent, Int64 depth) -> IRInst*
+IRInst* FlatModuleReader::_readInstRef(Cursor& cursor)
+{
+    SLANG_RELEASE_ASSERT(cursor.operandIndex < m_flat.operandIndices.getCount());
+    const auto index = m_flat.operandIndices[cursor.operandIndex++];
+    SLANG_RELEASE_ASSERT(index >= -1 && index < m_instCount);
+    IRInst* inst = m_insts[index];
+    if (!inst && index >= 0) [[unlikely]]
     {
-        SLANG_RELEASE_ASSERT(depth < kMaxIRSerializationDepth);
-        SLANG_RELEASE_ASSERT(instIndex < numInsts);
+        // A reference from one deferred body into another.
+        _materializeBody(_findBodyContaining(index));
+        inst = m_insts[index];
+    }
+    return inst;
+}
 
-        const auto thisInstIndex = instIndex++;
-        IRInst* inst = insts[thisInstIndex];
+IRInst* FlatModuleReader::_readInst(Cursor& cursor, IRInst* parent, Int64 depth)
+{
+    SLANG_RELEASE_ASSERT(depth < kMaxIRSerializationDepth);
+    SLANG_RELEASE_ASSERT(cursor.instIndex < m_instCount);
+
+    const auto thisInstIndex = cursor.instIndex++;
+    IRInst* inst = m_insts[thisInstIndex];
 
-        // operands and sourcelocs
-        inst->sourceLoc = sourceLocs[thisInstIndex];
-        inst->typeUse.init(inst, readInstRef());
-        for (Int64 o = 0; o < inst->operandCount; ++o)
-            inst->getOperands()[o].init(inst, readInstRef());
+    // operands and sourcelocs
+    inst->sourceLoc = m_flat.sourceLocs[thisInstIndex];
+    inst->typeUse.init(inst, _readInstRef(cursor));
+    for (Int64 o = 0; o < inst->operandCount; ++o)
+        inst->getOperands()[o].init(inst, _readInstRef(cursor));
 
-        // Handle special instructions
-        switch (inst->m_op)
+    // Handle special instructions
+    switch (inst->m_op)
+    {
+    [[unlikely]] case kIROp_ModuleInst:
+        cast<IRModuleInst>(inst)->module = m_module;
+        break;
+    case kIROp_BoolLit:
+    case kIROp_IntLit:
         {
-        [[unlikely]] case kIROp_ModuleInst:
-            cast<IRModuleInst>(inst)->module = module;
+            SLANG_RELEASE_ASSERT(cursor.literalIndex < m_flat.literals.getCount());
+            const auto bits = m_flat.literals[cursor.literalIndex++];
+            cast<IRConstant>(inst)->value.intVal = bitCast<IRIntegerValue>(bits);
             break;
-        case kIROp_BoolLit:
-        case kIROp_IntLit:
-            {
-                SLANG_RELEASE_ASSERT(litIndex < flat.literals.getCount());
-                const auto bits = flat.literals[litIndex++];
-                cast<IRConstant>(inst)->value.intVal = bitCast<IRIntegerValue>(bits);
-                break;
-            }
-        case kIROp_FloatLit:
-            {
-                SLANG_RELEASE_ASSERT(litIndex < flat.literals.getCount());
-                const auto bits = flat.literals[litIndex++];
-                cast<IRConstant>(inst)->value.floatVal = bitCast<double>(bits);
-                break;
-            }
-        case kIROp_PtrLit:
-            {
-                SLANG_RELEASE_ASSERT(litIndex < flat.literals.getCount());
-                const auto bits = flat.literals[litIndex++];
-                // Keep the compiler happy on 32 bit builds
-                cast<IRConstant>(inst)->value.ptrVal = (void*)(uintptr_t(bits));
-                break;
-            }
-        case kIROp_StringLit:
-        case kIROp_BlobLit:
-            {
-                const auto c = cast<IRConstant>(inst);
-                SLANG_RELEASE_ASSERT(stringLengthIndex < flat.stringLengths.getCount());
-                const auto len = flat.stringLengths[stringLengthIndex++];
-                SLANG_RELEASE_ASSERT(len >= 0);
-                SLANG_RELEASE_ASSERT(uint64_t(len) <= uint64_t(UINT32_MAX));
+        }
+    case kIROp_FloatLit:
+        {
+            SLANG_RELEASE_ASSERT(cursor.literalIndex < m_flat.literals.getCount());
+            const auto bits = m_flat.literals[cursor.literalIndex++];
+            cast<IRConstant>(inst)->value.floatVal = bitCast<double>(bits);
+            break;
+        }
+    case kIROp_PtrLit:
+        {
+            SLANG_RELEASE_ASSERT(cursor.literalIndex < m_flat.literals.getCount());
+            const auto bits = m_flat.literals[cursor.literalIndex++];
+            // Keep the compiler happy on 32 bit builds
+            cast<IRConstant>(inst)->value.ptrVal = (void*)(uintptr_t(bits));
+            break;
+        }
+    case kIROp_StringLit:
+    case kIROp_BlobLit:
+        {
+            const auto c = cast<IRConstant>(inst);
+            SLANG_RELEASE_ASSERT(cursor.stringLengthIndex < m_flat.stringLengths.getCount());
+            const auto len = m_flat.stringLengths[cursor.stringLengthIndex++];
+            SLANG_RELEASE_ASSERT(len >= 0);
+            SLANG_RELEASE_ASSERT(uint64_t(len) <= uint64_t(UINT32_MAX));
+
+            const auto stringCharsCount = m_flat.stringChars.getCount();
+            SLANG_RELEASE_ASSERT(cursor.stringDataIndex <= stringCharsCount);
+            SLANG_RELEASE_ASSERT(len <= stringCharsCount - cursor.stringDataIndex);
+
+            char* const dstChars = c->value.stringVal.chars;
+            c->value.stringVal.numChars = uint32_t(len);
+            if (len != 0)
+                memcpy(dstChars, m_flat.stringChars.begin() + cursor.stringDataIndex, size_t(len));
+            cursor.stringDataIndex += len;
+            break;
+        }
+    }
 
-                const auto stringCharsCount = flat.stringChars.getCount();
-                SLANG_RELEASE_ASSERT(stringDataIndex <= stringCharsCount);
-                SLANG_RELEASE_ASSERT(len <= stringCharsCount - stringDataIndex);
+    // Read in children, and fix up pointers
+    inst->parent = parent;
+    auto childCount = m_flat.childCounts[thisInstIndex];
+    SLANG_RELEASE_ASSERT(childCount >= 0);
 
-                char* const dstChars = c->value.stringVal.chars;
-                c->value.stringVal.numChars = uint32_t(len);
-                if (len != 0)
-                    memcpy(dstChars, flat.stringChars.begin() + stringDataIndex, size_t(len));
-                stringDataIndex += len;
-                break;
-            }
-        }
+    // The body of a module-level global value may be left for later, in which case
+    // only its decorations are read now.
+    const DeferredBody* deferredBody = nullptr;
+    if (depth == 1 && m_nextDeferredBody < m_deferredBodies.getCount() &&
+        m_deferredBodies[m_nextDeferredBody].ownerIndex == thisInstIndex)
+    {
+        deferredBody = &m_deferredBodies[m_nextDeferredBody++];
+        childCount -= deferredBody->childCount;
+    }
 
-        // Read in children, and fix up pointers
-        inst->parent = parent;
-        IRInst* prev = nullptr;
-        IRInst* first = nullptr;
-        IRInst* last = nullptr;
-        const auto childCount = flat.childCounts[thisInstIndex];
-        SLANG_RELEASE_ASSERT(childCount >= 0);
-        for (Int64 i = 0; i < childCount; ++i)
+    _readChildren(cursor, inst, childCount, depth + 1);
+
+    if (deferredBody)
+    {
+        SLANG_RELEASE_ASSERT(cursor.instIndex == deferredBody->begin.instIndex);
+        cursor = deferredBody->end;
+    }
+    return inst;
+}
+
+void FlatModuleReader::_readChildren(Cursor& cursor, IRInst* parent, Int64 childCount, Int64 depth)
+{
+    IRInst* prev = parent->m_decorationsAndChildren.last;
+    for (Int64 i = 0; i < childCount; ++i)
+    {
+        auto c = _readInst(cursor, parent, depth);
+        c->prev = prev;
+        if (prev)
+            prev->next = c;
+        else
+            parent->m_decorationsAndChildren.first = c;
+        prev = c;
+    }
+    if (prev)
+    {
+        prev->next = nullptr;
+        parent->m_decorationsAndChildren.last = prev;
+    }
+}
+
+Index FlatModuleReader::_findBodyContaining(Int64 instIndex)
+{
+    Index lo = 0;
+    Index hi = m_deferredBodies.getCount();
+    while (lo < hi)
+    {
+        const Index mid = lo + (hi - lo) / 2;
+        if (m_deferredBodies[mid].end.instIndex <= instIndex)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    SLANG_RELEASE_ASSERT(lo < m_deferredBodies.getCount());
+    SLANG_RELEASE_ASSERT(m_deferredBodies[lo].begin.instIndex <= instIndex);
+    return lo;
+}
+
+void FlatModuleReader::_materializeBody(Index bodyIndex)
+{
+    auto& body = m_deferredBodies[bodyIndex];
+    if (body.isMaterialized)
+        return;
+    body.isMaterialized = true;
+    m_pendingBodyCount--;
+
+    // Allocate every instruction of the body before wiring any of them up, so that a
+    // reference back into this body from another deferred body it pulls in resolves.
+    _allocateInsts(body.begin.instIndex, body.end.instIndex, body.begin.stringLengthIndex);
+
+    Cursor cursor = body.begin;
+    _readChildren(cursor, m_insts[body.ownerIndex], body.childCount, 2);
+    SLANG_RELEASE_ASSERT(cursor.instIndex == body.end.instIndex);
+    SLANG_RELEASE_ASSERT(cursor.operandIndex == body.end.operandIndex);
+}
+
+void FlatModuleReader::_releaseTableIfDone()
+{
+    // Once every body has been read in, the table is no longer needed.
+    if (m_pendingBodyCount == 0 && m_instCount != 0)
+    {
+        m_flat = FlatInstTable();
+        m_instsList = List<IRInst*>();
+        m_insts = nullptr;
+        m_instCount = 0;
+        m_deferredBodyForOwner = Dictionary<IRInst*, Index>();
+    }
+}
+
+void FlatModuleReader::materialize(IRInst* globalValue)
+{
+    if (m_pendingBodyCount == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (auto bodyIndex = m_deferredBodyForOwner.tryGetValue(globalValue))
+    {
+        _materializeBody(*bodyIndex);
+        _releaseTableIfDone();
+    }
+}
+
+void FlatModuleReader::materializeAll()
+{
+    if (m_pendingBodyCount == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (Index i = 0; i < m_deferredBodies.getCount(); ++i)
+        _materializeBody(i);
+    _releaseTableIfDone();
+}
+
+bool FlatModuleReader::anyUnmaterializedInst(bool (*predicate)(IROp))
+{
+    if (m_pendingBodyCount == 0)
+        return false;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& body : m_deferredBodies)
+    {
+        if (body.isMaterialized)
+            continue;
+        for (auto i = body.begin.instIndex; i < body.end.instIndex; ++i)
         {
-            auto c = go(go, inst, depth + 1);
-            if (i == 0)
-                first = c;
-            last = c;
-            c->prev = prev;
-            if (prev)
-                prev->next = c;
-            prev = c;
+            if (predicate(m_flat.instAllocInfo[i].op))
+                return true;
         }
-        if (last)
-            last->next = nullptr;
-        inst->m_decorationsAndChildren.first = first;
-        inst->m_decorationsAndChildren.last = last;
+    }
+    return false;
+}
 
-        return inst;
-    };
-    const auto moduleInst = go(go, nullptr, 0);
-    SLANG_RELEASE_ASSERT(instIndex == numInsts);
-    SLANG_RELEASE_ASSERT(operandIndex == operandIndicesCount);
+IRModuleInst* FlatModuleReader::read(bool deserializeLazily)
+{
+    // dumpFlatInstTableStats(m_flat, "deserializing");
+    m_instCount = m_flat.instAllocInfo.getCount();
+
+    // These relationships are serialized IR invariants; stop before rebuilding pointers from
+    // inconsistent flat tables.
+    SLANG_RELEASE_ASSERT(m_flat.childCounts.getCount() == m_instCount);
+    SLANG_RELEASE_ASSERT(m_flat.sourceLocs.getCount() == m_instCount);
+
+    m_instsList.setCount(m_instCount + 1);
+    // nullptr instructions are represented as `-1`. We can save ourselves a
+    // branch by just making that index valid.
+    m_insts = &m_instsList[1];
+    m_insts[-1] = nullptr;
+
+    if (deserializeLazily)
+        _findDeferredBodies();
+
+    // Allocate everything outside of the deferred bodies.
+    Int64 instIndex = 0;
+    Int64 stringLengthIndex = 0;
+    for (const auto& body : m_deferredBodies)
+    {
+        _allocateInsts(instIndex, body.begin.instIndex, stringLengthIndex);
+        instIndex = body.end.instIndex;
+        stringLengthIndex = body.end.stringLengthIndex;
+    }
+    _allocateInsts(instIndex, m_instCount, stringLengthIndex);
+
+    Cursor cursor;
+    const auto moduleInst = _readInst(cursor, nullptr, 0);
+    SLANG_RELEASE_ASSERT(cursor.instIndex == m_instCount);
+    SLANG_RELEASE_ASSERT(cursor.operandIndex == m_flat.operandIndices.getCount());
     // Unknown future opcodes intentionally become a recoverable read failure later.
     // This reader cannot know whether those opcodes consume literal or string payloads.
-    if (!readContext._foundUnrecognizedInstructions)
+    if (!m_foundUnrecognizedInstructions)
     {
-        SLANG_RELEASE_ASSERT(litIndex == flat.literals.getCount());
-        SLANG_RELEASE_ASSERT(stringLengthIndex == flat.stringLengths.getCount());
-        SLANG_RELEASE_ASSERT(stringDataIndex == flat.stringChars.getCount());
+        SLANG_RELEASE_ASSERT(cursor.literalIndex == m_flat.literals.getCount());
+        SLANG_RELEASE_ASSERT(cursor.stringLengthIndex == m_flat.stringLengths.getCount());
+        SLANG_RELEASE_ASSERT(cursor.stringDataIndex == m_flat.stringChars.getCount());
     }
     SLANG_RELEASE_ASSERT(as<IRModuleInst>(moduleInst));
+
+    for (Index i = 0; i < m_deferredBodies.getCount(); ++i)
+        m_deferredBodyForOwner.add(m_insts[m_deferredBodies[i].ownerIndex], i);
+    m_pendingBodyCount = m_deferredBodies.getCount();
+    _releaseTableIfDone();
+
     return cast<IRModuleInst>(moduleInst);
 }
 
+static IRModuleInst* deserializeFromFlatModule(const IRReadSerializer& serializer, IRModule* module)
+{
+    IRSerialReadContext& readContext = *serializer.getContext();
+    RefPtr<FlatModuleReader> reader = new FlatModuleReader(module);
+    serialize(serializer, reader->m_flat);
+
+    const auto moduleInst = reader->read(readContext._deserializeLazily);
+    if (reader->m_foundUnrecognizedInstructions)
+        readContext._foundUnrecognizedInstructions = true;
+    else if (readContext._deserializeLazily)
+        module->_setLazyLoader(reader);
+    return moduleInst;
+}
+
 void IRSerialWriteContext::handleIRModule(IRWriteSerializer const& serializer, IRModule*& value)
 {
     SLANG_SCOPED_SERIALIZER_STRUCT(serializer);
@@ -791,7 +1177,8 @@ Result readSerializedModuleInfo(
     RIFF::Chunk const* chunk,
     Session* session,
     SerialSourceLocReader* sourceLocReader,
-    RefPtr<IRModule>& outIRModule)
+    RefPtr<IRModule>& outIRModule,
+    bool deserializeLazily)
 {
     auto dataChunk = as<RIFF::DataChunk>(chunk);
     if (!dataChunk)
@@ -814,7 +1201,8 @@ Result readSerializedModuleInfo(
         return SLANG_FAIL;
 
     IRModuleInfo info;
-    auto sharedDecodingContext = RefPtr(new IRSerialReadContext(session, sourceLocReader));
+    auto sharedDecodingContext =
+        RefPtr(new IRSerialReadContext(session, sourceLocReader, deserializeLazily));
     {
         Fossil::ReadContext readContext;
         Fossil::SerialReader reader(
@@ -837,11 +1225,17 @@ Result readSerializedModuleIR(
     RIFF::Chunk const* chunk,
     Session* session,
     SerialSourceLocReader* sourceLocReader,
-    RefPtr<IRModule>& outIRModule)
+    RefPtr<IRModule>& outIRModule,
+    bool deserializeLazily)
 {
     SLANG_PROFILE;
 
-    SLANG_RETURN_ON_FAIL(readSerializedModuleIR_(chunk, session, sourceLocReader, outIRModule));
+    SLANG_RETURN_ON_FAIL(readSerializedModuleIR_(
+        chunk,
+        session,
+        sourceLocReader,
+        outIRModule,
+        deserializeLazily));
 
     //
     // Module is finally valid (or at least as much as it was going it) and
@@ -23,11 +23,17 @@ void writeSerializedModuleIR(
     IRModule* moduleDecl,
     SerialSourceLocWriter* sourceLocWriter);
 
+/// Read the IR module serialized in `chunk`.
+///
+/// If `deserializeLazily` is true, the bodies of module-level functions, generics and
+/// witness tables are left serialized and only read in when `IRModule::materialize` is
+/// called for them (see `IRLazyModuleLoader`).
 [[nodiscard]] Result readSerializedModuleIR(
     RIFF::Chunk const* chunk,
     Session* session,
     SerialSourceLocReader* sourceLocReader,
-    RefPtr<IRModule>& outIRModule);
+    RefPtr<IRModule>& outIRModule,
+    bool deserializeLazily = false);
 
 [[nodiscard]] Result readSerializedModuleInfo(
     RIFF::Chunk const* chunk,
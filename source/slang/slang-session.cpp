@@ -2,7 +2,9 @@
 #include "slang-session.h"
 
 #include "compiler-core/slang-artifact-util.h"
+#include "core/slang-performance-profiler.h"
 #include "core/slang-shared-library.h"
+#include "core/slang-thread-pool.h"
 #include "slang-check-impl.h"
 #include "slang-compiler.h"
 #include "slang-lower-to-ir.h"
@@ -110,6 +112,13 @@ Linkage::queryInterface(SlangUUID const& uuid, void** outObject)
         return SLANG_OK;
     }
 
+    if (uuid == slang::IBatchCompileService_Experimental::getTypeGuid())
+    {
+        *outObject = static_cast<slang::IBatchCompileService_Experimental*>(this);
+        addReference();
+        return SLANG_OK;
+    }
+
     return SLANG_E_NO_INTERFACE;
 }
 
@@ -128,6 +137,43 @@ Linkage::~Linkage()
         }
         destroyTypeCheckingCache();
     }
+
+    if (m_perfTraceOutputPath.getLength())
+    {
+        auto tracer = PerformanceTracer::getTracer();
+        tracer->writeToFile(m_perfTraceOutputPath);
+        tracer->release();
+    }
+}
+
+void Linkage::beginPerfTrace()
+{
+    if (m_perfTraceOutputPath.getLength())
+        return;
+    m_perfTraceOutputPath = m_optionSet.getStringOption(CompilerOptionName::PerfTraceOutput);
+    if (m_perfTraceOutputPath.getLength())
+        PerformanceTracer::getTracer()->acquire();
+}
+
+PersistentCache* Linkage::getCompilationCache()
+{
+    std::lock_guard<std::mutex> lock(m_compilationCacheMutex);
+    if (!m_compilationCacheInitialized)
+    {
+        m_compilationCacheInitialized = true;
+
+        String directory =
+            m_optionSet.getStringOption(CompilerOptionName::CompilationCacheDirectory);
+        if (directory.getLength())
+        {
+            PersistentCache::Desc desc;
+            desc.directory = directory.getBuffer();
+            desc.maxEntryCount =
+                m_optionSet.getIntOption(CompilerOptionName::CompilationCacheMaxEntryCount);
+            m_compilationCache = new PersistentCache(desc);
+        }
+    }
+    return m_compilationCache;
 }
 
 SearchDirectoryList& Linkage::getSearchDirectories()
@@ -393,10 +439,8 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::createCompositeComponentType(
     slang::IComponentType** outCompositeComponentType,
     ISlangBlob** outDiagnostics)
 {
-    // Composite creation still mutates linkage-owned front-end state, so keep it serialized
-    // with other specialize/link/layout operations.
-    std::lock_guard<std::recursive_mutex> lock(getComponentTypeOperationMutex());
-
+    // Composing only reads the children, so unlike specialization and layout it doesn't take
+    // the operation mutex.
     if (outCompositeComponentType == nullptr)
         return SLANG_E_INVALID_ARG;
 
@@ -442,6 +486,163 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::createCompositeComponentType(
     return SLANG_OK;
 }
 
+namespace
+{ // anonymous
+
+/// The specialized and linked program for one distinct entry point and set of
+/// specialization arguments in a batch.
+struct BatchVariant
+{
+    ComPtr<slang::IComponentType> linkedProgram;
+    String diagnostics;
+    SlangResult result = SLANG_OK;
+};
+
+void _appendDiagnostics(String& ioDiagnostics, slang::IBlob* diagnostics)
+{
+    if (diagnostics)
+    {
+        ioDiagnostics.append(
+            (const char*)diagnostics->getBufferPointer(),
+            diagnostics->getBufferSize());
+    }
+}
+
+/// Items of a batch with equal keys compile the same program.
+String _getBatchVariantKey(const slang::BatchCompileItem& item)
+{
+    StringBuilder key;
+    key << UInt64(size_t(item.entryPoint));
+    for (SlangInt ii = 0; ii < item.specializationArgCount; ++ii)
+    {
+        const auto& arg = item.specializationArgs[ii];
+        key << "|" << int(arg.kind) << ":";
+        if (arg.kind == slang::SpecializationArg::Kind::Expr)
+            key << arg.expr;
+        else
+            key << UInt64(size_t(arg.type));
+    }
+    return key.produceString();
+}
+
+BatchVariant _linkBatchVariant(const slang::BatchCompileItem& item)
+{
+    BatchVariant variant;
+
+    ComPtr<slang::IComponentType> program(item.entryPoint);
+    if (item.specializationArgCount != 0)
+    {
+        ComPtr<slang::IComponentType> specializedProgram;
+        ComPtr<slang::IBlob> diagnostics;
+        variant.result = item.entryPoint->specialize(
+            item.specializationArgs,
+            item.specializationArgCount,
+            specializedProgram.writeRef(),
+            diagnostics.writeRef());
+        _appendDiagnostics(variant.diagnostics, diagnostics);
+        if (SLANG_FAILED(variant.result))
+            return variant;
+        program = specializedProgram;
+    }
+
+    ComPtr<slang::IBlob> diagnostics;
+    variant.result = program->link(variant.linkedProgram.writeRef(), diagnostics.writeRef());
+    _appendDiagnostics(variant.diagnostics, diagnostics);
+    return variant;
+}
+
+} // namespace
+
+SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::compileBatch(
+    slang::BatchCompileDesc const& desc,
+    slang::IBlob** outCodes,
+    SlangResult* outResults,
+    slang::IBlob** outDiagnostics)
+{
+    SLANG_PROFILE;
+
+    const Index itemCount = Index(desc.itemCount);
+    if (itemCount < 0 || (itemCount != 0 && (!desc.items || !outCodes || !outResults)))
+        return SLANG_E_INVALID_ARG;
+
+    // The front-end work is done once per distinct program, here on the calling
+    // thread, since specializing and linking take the linkage-wide operation mutex
+    // anyway.
+    //
+    List<BatchVariant> variants;
+    List<Index> itemVariantIndices;
+    Dictionary<String, Index> mapKeyToVariantIndex;
+    for (Index ii = 0; ii < itemCount; ++ii)
+    {
+        outCodes[ii] = nullptr;
+        if (outDiagnostics)
+            outDiagnostics[ii] = nullptr;
+
+        const auto& item = desc.items[ii];
+        if (!item.entryPoint || (item.specializationArgCount != 0 && !item.specializationArgs))
+        {
+            outResults[ii] = SLANG_E_INVALID_ARG;
+            itemVariantIndices.add(-1);
+            continue;
+        }
+
+        String key = _getBatchVariantKey(item);
+        Index variantIndex = -1;
+        if (!mapKeyToVariantIndex.tryGetValue(key, variantIndex))
+        {
+            variantIndex = variants.getCount();
+            variants.add(_linkBatchVariant(item));
+            mapKeyToVariantIndex.add(key, variantIndex);
+        }
+        itemVariantIndices.add(variantIndex);
+    }
+
+    // Code generation for linked programs can run concurrently, so every item
+    // is a task of its own.
+    //
+    Index threadCount = Index(desc.threadCount);
+    if (threadCount <= 0)
+        threadCount = ThreadPool::getHardwareThreadCount();
+    threadCount = Math::Max(Math::Min(threadCount, itemCount), Index(1));
+    RefPtr<ThreadPool> threadPool = getSessionImpl()->getCodeGenThreadPool(threadCount);
+    threadPool->parallelFor(
+        itemCount,
+        [&](Index itemIndex)
+        {
+            const Index variantIndex = itemVariantIndices[itemIndex];
+            if (variantIndex < 0)
+                return;
+
+            const auto& variant = variants[variantIndex];
+            String diagnostics = variant.diagnostics;
+            if (SLANG_FAILED(variant.result))
+            {
+                outResults[itemIndex] = variant.result;
+            }
+            else
+            {
+                ComPtr<slang::IBlob> codeGenDiagnostics;
+                outResults[itemIndex] = variant.linkedProgram->getEntryPointCode(
+                    0,
+                    desc.items[itemIndex].targetIndex,
+                    &outCodes[itemIndex],
+                    codeGenDiagnostics.writeRef());
+                _appendDiagnostics(diagnostics, codeGenDiagnostics);
+            }
+
+            if (outDiagnostics && diagnostics.getLength() != 0)
+                outDiagnostics[itemIndex] = StringBlob::moveCreate(diagnostics).detach();
+        },
+        threadCount);
+
+    for (Index ii = 0; ii < itemCount; ++ii)
+    {
+        if (SLANG_FAILED(outResults[ii]))
+            return outResults[ii];
+    }
+    return SLANG_OK;
+}
+
 SLANG_NO_THROW slang::TypeReflection* SLANG_MCALL Linkage::specializeType(
     slang::TypeReflection* inUnspecializedType,
     slang::SpecializationArg const* specializationArgs,
@@ -685,48 +886,59 @@ SLANG_NO_THROW slang::TypeReflection* SLANG_MCALL Linkage::getContainerType(
     slang::ContainerType containerType,
     ISlangBlob** outDiagnostics)
 {
+    Type* containerTypeReflection = nullptr;
+    ContainerTypeKey key = {inType, containerType};
+    {
+        // Repeated queries are answered from the cache without waiting on other front-end work.
+        std::lock_guard<std::mutex> cacheLock(m_containerTypesMutex);
+        if (m_containerTypes.tryGetValue(key, containerTypeReflection))
+            return asExternal(containerTypeReflection);
+    }
+
+    // Creating the type goes through the shared AST builder, so serialize it with the other
+    // component-type operations.
+    std::lock_guard<std::recursive_mutex> lock(getComponentTypeOperationMutex());
+
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     auto type = asInternal(inType);
 
-    Type* containerTypeReflection = nullptr;
-    ContainerTypeKey key = {inType, containerType};
-    if (!m_containerTypes.tryGetValue(key, containerTypeReflection))
+    switch (containerType)
     {
-        switch (containerType)
+    case slang::ContainerType::ConstantBuffer:
         {
-        case slang::ContainerType::ConstantBuffer:
-            {
-                SemanticsVisitor visitor(getSemanticsForReflection());
-                auto layoutType = getASTBuilder()->getDefaultLayoutType();
-                Type* cbType = visitor.getConstantBufferType(type, layoutType);
-                containerTypeReflection = cbType;
-            }
-            break;
-        case slang::ContainerType::ParameterBlock:
-            {
-                ParameterBlockType* pbType = getASTBuilder()->getParameterBlockType(type);
-                containerTypeReflection = pbType;
-            }
-            break;
-        case slang::ContainerType::StructuredBuffer:
-            {
-                HLSLStructuredBufferType* sbType = getASTBuilder()->getStructuredBufferType(type);
-                containerTypeReflection = sbType;
-            }
-            break;
-        case slang::ContainerType::UnsizedArray:
-            {
-                ArrayExpressionType* arrType = getASTBuilder()->getArrayType(type, nullptr);
-                containerTypeReflection = arrType;
-            }
-            break;
-        default:
-            containerTypeReflection = type;
-            break;
+            SemanticsVisitor visitor(getSemanticsForReflection());
+            auto layoutType = getASTBuilder()->getDefaultLayoutType();
+            Type* cbType = visitor.getConstantBufferType(type, layoutType);
+            containerTypeReflection = cbType;
+        }
+        break;
+    case slang::ContainerType::ParameterBlock:
+        {
+            ParameterBlockType* pbType = getASTBuilder()->getParameterBlockType(type);
+            containerTypeReflection = pbType;
+        }
+        break;
+    case slang::ContainerType::StructuredBuffer:
+        {
+            HLSLStructuredBufferType* sbType = getASTBuilder()->getStructuredBufferType(type);
+            containerTypeReflection = sbType;
         }
+        break;
+    case slang::ContainerType::UnsizedArray:
+        {
+            ArrayExpressionType* arrType = getASTBuilder()->getArrayType(type, nullptr);
+            containerTypeReflection = arrType;
+        }
+        break;
+    default:
+        containerTypeReflection = type;
+        break;
+    }
 
-        m_containerTypes.add(key, containerTypeReflection);
+    {
+        std::lock_guard<std::mutex> cacheLock(m_containerTypesMutex);
+        m_containerTypes[key] = containerTypeReflection;
     }
 
     SLANG_UNUSED(outDiagnostics);
@@ -1134,6 +1346,25 @@ void Linkage::loadParsedModule(
     loadedModulesList.add(loadedModule);
 }
 
+void Linkage::removeLoadedModules(HashSet<Module*> const& modules)
+{
+    mapPathToLoadedModule.removeIf([&](const auto& entry)
+                                   { return modules.contains(entry.second.get()); });
+    mapNameToLoadedModules.removeIf([&](const auto& entry)
+                                    { return modules.contains(entry.second.get()); });
+
+    List<RefPtr<LoadedModule>> remainingModules;
+    for (auto& module : loadedModulesList)
+    {
+        if (!modules.contains(module.get()))
+            remainingModules.add(module);
+    }
+    loadedModulesList = _Move(remainingModules);
+
+    // The results cached while checking may refer to declarations in the removed modules.
+    destroyTypeCheckingCache();
+}
+
 RefPtr<Module> Linkage::findOrLoadSerializedModuleForModuleLibrary(
     ISlangBlob* blobHoldingSerializedData,
     ModuleChunk const* moduleChunk,
@@ -1353,6 +1584,9 @@ RefPtr<Module> Linkage::loadSourceModuleImpl(
     DiagnosticSink* sink,
     const LoadedModuleDictionary* additionalLoadedModules)
 {
+    // Included files are lexed once for the module, and for any compile that imports it.
+    LexedSourceFileCache::CompileScope lexedSourceFileCacheScope(&m_lexedSourceFileCache);
+
     RefPtr<FrontEndCompileRequest> frontEndReq = new FrontEndCompileRequest(this, nullptr, sink);
 
     frontEndReq->additionalLoadedModules = additionalLoadedModules;
@@ -1712,6 +1946,32 @@ RefPtr<Module> Linkage::findOrImportModule(
                 continue;
             }
 
+            // A source module that was checked by an earlier session with
+            // the same options may have been kept in the compilation cache,
+            // in which case it can be loaded without checking it again.
+            //
+            PersistentCache* moduleCache = nullptr;
+            PersistentCache::Key moduleCacheKey;
+            if (type == ModuleBlobType::Source && !isInLanguageServer())
+            {
+                moduleCache = getCompilationCache();
+            }
+            if (moduleCache)
+            {
+                if (auto module = loadSourceModuleFromCache(
+                        moduleCache,
+                        moduleName,
+                        filePathInfo,
+                        fileContents,
+                        requestingLoc,
+                        sink,
+                        moduleCacheKey))
+                {
+                    module->setSourceDigest(computeSourceBlobDigest(fileContents));
+                    return module;
+                }
+            }
+
             // If we found a real file and were able to load its contents,
             // then we'll go ahead and try to load a module from it,
             // whether by compiling it or decoding the binary.
@@ -1733,6 +1993,8 @@ RefPtr<Module> Linkage::findOrImportModule(
             {
                 if (type == ModuleBlobType::Source)
                     module->setSourceDigest(computeSourceBlobDigest(fileContents));
+                if (moduleCache)
+                    writeSourceModuleToCache(moduleCache, moduleCacheKey, module);
                 return module;
             }
         }
@@ -1892,6 +2154,71 @@ bool Linkage::isBinaryModuleUpToDate(String fromPath, RIFF::ListChunk const* bas
     return digestBuilder.finalize() == existingDigest;
 }
 
+RefPtr<Module> Linkage::loadSourceModuleFromCache(
+    PersistentCache* cache,
+    Name* name,
+    const PathInfo& filePathInfo,
+    ISlangBlob* fileContentsBlob,
+    SourceLoc const& loc,
+    DiagnosticSink* sink,
+    PersistentCache::Key& outKey)
+{
+    // The key only covers the module's own source. The files it includes and the modules it
+    // imports aren't known until it has been parsed, so they are checked against the digest
+    // stored in the serialized module instead, just as for a `.slang-module` on disk.
+    DigestBuilder<SHA1> digestBuilder;
+    digestBuilder.append(toSlice("source-module"));
+    digestBuilder.append(String(getBuildTagString()));
+    m_optionSet.buildHash(digestBuilder);
+    digestBuilder.append(filePathInfo.getMostUniqueIdentity());
+    digestBuilder.append(filePathInfo.foundPath);
+    digestBuilder.append(fileContentsBlob);
+    outKey = digestBuilder.finalize();
+
+    ComPtr<ISlangBlob> moduleBlob;
+    if (SLANG_FAILED(cache->readEntry(outKey, moduleBlob.writeRef())))
+    {
+        return nullptr;
+    }
+
+    auto rootChunk = RIFF::RootChunk::getFromBlob(moduleBlob);
+    if (!rootChunk)
+    {
+        return nullptr;
+    }
+    auto moduleChunk = ModuleChunk::find(rootChunk);
+    if (!moduleChunk || !isBinaryModuleUpToDate(filePathInfo.foundPath, moduleChunk))
+    {
+        return nullptr;
+    }
+
+    return loadSerializedModule(name, filePathInfo, moduleBlob, moduleChunk, rootChunk, loc, sink);
+}
+
+void Linkage::writeSourceModuleToCache(
+    PersistentCache* cache,
+    const PersistentCache::Key& key,
+    Module* module)
+{
+    SLANG_AST_BUILDER_RAII(module->getASTBuilder());
+
+    // Source locations are kept so that diagnostics and debug info that refer into the module
+    // are the same whether it was checked or loaded from the cache.
+    SerialContainerUtil::WriteOptions writeOptions;
+    writeOptions.sourceManagerToUseWhenSerializingSourceLocs = getSourceManager();
+
+    OwnedMemoryStream memoryStream(FileAccess::Write);
+    if (SLANG_FAILED(SerialContainerUtil::write(module, writeOptions, &memoryStream)))
+    {
+        return;
+    }
+
+    // The cache is only an optimization, so failing to write it isn't an error.
+    List<uint8_t> contents;
+    memoryStream.swapContents(contents);
+    cache->writeEntry(key, ListBlob::moveCreate(contents));
+}
+
 SLANG_NO_THROW bool SLANG_MCALL
 Linkage::isBinaryModuleUpToDate(const char* modulePath, slang::IBlob* binaryModuleBlob)
 {
@@ -2235,7 +2562,12 @@ SlangResult Linkage::loadSerializedModuleContents(
     module->setModuleDecl(moduleDecl);
 
     RefPtr<IRModule> irModule;
-    SLANG_RETURN_ON_FAIL(readSerializedModuleIR(irChunk, session, sourceLocReader, irModule));
+    SLANG_RETURN_ON_FAIL(readSerializedModuleIR(
+        irChunk,
+        session,
+        sourceLocReader,
+        irModule,
+        m_optionSet.getBoolOption(CompilerOptionName::LazyIRDeserialization)));
     module->setIRModule(irModule);
 
     // The handling of file dependencies is complicated, because of
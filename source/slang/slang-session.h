@@ -16,6 +16,7 @@
 #include "compiler-core/slang-command-line-args.h"
 #include "compiler-core/slang-include-system.h"
 #include "compiler-core/slang-name.h"
+#include "core/slang-persistent-cache.h"
 #include "core/slang-riff.h"
 #include "core/slang-smart-pointer.h"
 #include "slang-ast-base.h"
@@ -23,6 +24,7 @@
 #include "slang-compiler-options.h"
 #include "slang-content-assist-info.h"
 #include "slang-global-session.h"
+#include "slang-preprocessor.h"
 
 #include <mutex>
 #include <slang.h>
@@ -88,7 +90,9 @@ struct ContainerTypeKey
 };
 
 /// A context for loading and re-using code modules.
-class Linkage : public RefObject, public slang::ISession
+class Linkage : public RefObject,
+                public slang::ISession,
+                public slang::IBatchCompileService_Experimental
 {
 public:
     SLANG_COM_INTERFACE(
@@ -185,11 +189,31 @@ public:
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL
     getDeclSourceLocation(slang::DeclReflection* decl, slang::SourceLocation* outLocation) override;
 
+    // IBatchCompileService_Experimental
+    SLANG_NO_THROW SlangResult SLANG_MCALL compileBatch(
+        slang::BatchCompileDesc const& desc,
+        slang::IBlob** outCodes,
+        SlangResult* outResults,
+        slang::IBlob** outDiagnostics = nullptr) override;
+
     // Updates the supplied builder with linkage-related information, which includes preprocessor
     // defines, the compiler version, and other compiler options. This is then merged with the hash
     // produced for the program to produce a key that can be used with the shader cache.
     void buildHash(DigestBuilder<SHA1>& builder, SlangInt targetIndex = -1);
 
+    /// Get the on-disk cache of generated target code, creating it on first use.
+    ///
+    /// Returns null unless `CompilerOptionName::CompilationCacheDirectory` was set on the
+    /// session. Code entries are keyed on the digest of `getEntryPointHash` and the options of
+    /// the program. The cache also holds serialized copies of source modules that have been
+    /// imported.
+    PersistentCache* getCompilationCache();
+
+    /// Start recording a performance trace for the lifetime of this linkage, if
+    /// `CompilerOptionName::PerfTraceOutput` is set. The trace is written when the linkage
+    /// is destroyed.
+    void beginPerfTrace();
+
     void addTarget(slang::TargetDesc const& desc);
     SlangResult addSearchPath(char const* path);
     SlangResult addPreprocessorDefine(char const* name, char const* value);
@@ -235,14 +259,17 @@ public:
 
     // Cache for container types.
     Dictionary<ContainerTypeKey, Type*> m_containerTypes;
+    // Guards `m_containerTypes` on its own so cache hits don't take the operation mutex.
+    std::mutex m_containerTypesMutex;
 
     // cache used by type checking, implemented in check.cpp
     TypeCheckingCache* getTypeCheckingCache();
     void destroyTypeCheckingCache();
 
     RefPtr<RefObject> m_typeCheckingCache = nullptr;
-    // Front-end component-type operations still share linkage-owned mutable state and can
-    // re-enter one another, so they remain serialized even when backend emission is parallelized.
+    // Specialization, layout and container type creation check and create AST nodes in the
+    // linkage's AST builder and can re-enter one another, so they are serialized by this mutex.
+    // Composing, linking and making target programs only read component types and don't take it.
     std::recursive_mutex m_componentTypeOperationMutex;
 
     // Modules that have been dynamically loaded via `import`
@@ -272,6 +299,10 @@ public:
 
     ContentAssistInfo contentAssistInfo;
 
+    // Tokens of `#include`d files, reused by later includes of the same file content in the
+    // same compile.
+    LexedSourceFileCache m_lexedSourceFileCache;
+
     /// File system implementation to use when loading files from disk.
     ///
     /// If this member is `null`, a default implementation that tries
@@ -382,8 +413,34 @@ public:
         Name* name,
         PathInfo const& pathInfo);
 
+    /// Remove `modules` from the modules loaded into this linkage, so that a later `import` of
+    /// one of them loads it again.
+    ///
+    /// The caller is responsible for also removing every module that imports one of them.
+    void removeLoadedModules(HashSet<Module*> const& modules);
+
     bool isBinaryModuleUpToDate(String fromPath, RIFF::ListChunk const* baseChunk);
 
+    /// Load the source module at `filePathInfo` from the serialized copy kept in `cache`, if
+    /// there is one and it is up to date with every file it depended on.
+    ///
+    /// Whether or not a copy was loaded, `outKey` is set to where the module is kept in `cache`.
+    RefPtr<Module> loadSourceModuleFromCache(
+        PersistentCache* cache,
+        Name* name,
+        const PathInfo& filePathInfo,
+        ISlangBlob* fileContentsBlob,
+        SourceLoc const& loc,
+        DiagnosticSink* sink,
+        PersistentCache::Key& outKey);
+
+    /// Serialize a module that was checked from source into `cache`, so a later
+    /// `loadSourceModuleFromCache` can load it without checking it again.
+    void writeSourceModuleToCache(
+        PersistentCache* cache,
+        const PersistentCache::Key& key,
+        Module* module);
+
     RefPtr<Module> findOrImportModule(
         Name* name,
         SourceLoc const& loc,
@@ -490,5 +547,14 @@ private:
     List<Type*> m_specializedTypes;
 
     RefPtr<SharedSemanticsContext> m_semanticsForReflection;
+
+    // Created lazily by `getCompilationCache`; entry-point compiles on different threads can
+    // request it concurrently.
+    RefPtr<PersistentCache> m_compilationCache;
+    bool m_compilationCacheInitialized = false;
+    std::mutex m_compilationCacheMutex;
+
+    // Set by `beginPerfTrace` when this linkage holds the performance tracer.
+    String m_perfTraceOutputPath;
 };
 } // namespace Slang
@@ -1,6 +1,10 @@
 // slang-target-program.cpp
 #include "slang-target-program.h"
 
+#include "compiler-core/slang-artifact-associated.h"
+#include "compiler-core/slang-artifact-desc-util.h"
+#include "compiler-core/slang-artifact-util.h"
+#include "core/slang-blob.h"
 #include "slang-compiler.h"
 #include "slang-rich-diagnostics.h"
 #include "slang-type-layout.h"
@@ -20,6 +24,243 @@ TargetProgram::TargetProgram(ComponentType* componentType, TargetRequest* target
     m_optionSet.inheritFrom(targetReq->getOptionSet());
 }
 
+PersistentCache* TargetProgram::_findCompilationCache(
+    Int entryPointIndex,
+    PersistentCache::Key& outKey)
+{
+    auto linkage = m_program->getLinkage();
+    auto cache = linkage->getCompilationCache();
+    if (!cache)
+        return nullptr;
+
+    // Host-callable results only exist as loaded code in this process, and dumps,
+    // separate debug info and pass statistics are side outputs of a real compile, so
+    // those are never cached.
+    auto target = m_targetReq->getTarget();
+    if (ArtifactDescUtil::makeDescForCompileTarget(asExternal(target)).kind ==
+        ArtifactKind::HostCallable)
+        return nullptr;
+    if (m_optionSet.shouldDumpIntermediates() || m_optionSet.shouldDumpIR() ||
+        m_optionSet.shouldEmitSeparateDebugInfo() ||
+        m_optionSet.getBoolOption(CompilerOptionName::ReportPassStatistics) ||
+        m_optionSet.getLineDirectiveMode() == LineDirectiveMode::SourceMap)
+        return nullptr;
+
+    Index targetIndex = -1;
+    for (Index i = 0; i < linkage->targets.getCount(); ++i)
+    {
+        if (linkage->targets[i] == m_targetReq)
+        {
+            targetIndex = i;
+            break;
+        }
+    }
+    if (targetIndex < 0)
+        return nullptr;
+
+    DigestBuilder<SHA1> builder;
+    if (entryPointIndex >= 0)
+    {
+        ComPtr<ISlangBlob> hash;
+        m_program->getEntryPointHash(entryPointIndex, targetIndex, hash.writeRef());
+        builder.append(hash);
+    }
+    else
+    {
+        linkage->buildHash(builder, targetIndex);
+        m_program->buildHash(builder);
+        // Keep whole-program results apart from a single entry point with the same hash inputs.
+        builder.append(toSlice("whole-program"));
+    }
+
+    // The options of the program itself, such as those given to `linkWithOptions`, are not
+    // part of the hashes above.
+    m_optionSet.buildHash(builder);
+
+    outKey = builder.finalize();
+    return cache;
+}
+
+/* An entry holds the diagnostics reported by the compile that produced it, preceded by their
+size as a uint32_t, followed by the code. */
+
+ComPtr<IArtifact> TargetProgram::_readCachedResult(
+    PersistentCache* cache,
+    const PersistentCache::Key& key,
+    DiagnosticSink* sink)
+{
+    ComPtr<ISlangBlob> blob;
+    if (SLANG_FAILED(cache->readEntry(key, blob.writeRef())))
+        return nullptr;
+
+    const char* cur = (const char*)blob->getBufferPointer();
+    const char* end = cur + blob->getBufferSize();
+
+    uint32_t diagnosticsSize;
+    if (size_t(end - cur) < sizeof(diagnosticsSize))
+        return nullptr;
+    ::memcpy(&diagnosticsSize, cur, sizeof(diagnosticsSize));
+    cur += sizeof(diagnosticsSize);
+    if (size_t(end - cur) < diagnosticsSize)
+        return nullptr;
+    const UnownedStringSlice diagnostics(cur, diagnosticsSize);
+    cur += diagnosticsSize;
+
+    // Only compiles without errors are cached, so these are warnings and notes.
+    if (diagnostics.getLength())
+        sink->diagnoseRaw(Severity::Warning, diagnostics);
+
+    auto artifact =
+        ArtifactUtil::createArtifactForCompileTarget(asExternal(m_targetReq->getTarget()));
+    artifact->addRepresentationUnknown(RawBlob::create(cur, size_t(end - cur)));
+    return artifact;
+}
+
+void TargetProgram::_writeCachedResult(
+    PersistentCache* cache,
+    const PersistentCache::Key& key,
+    IArtifact* artifact,
+    const StringBuilder& diagnostics)
+{
+    ComPtr<ISlangBlob> blob;
+    if (SLANG_FAILED(artifact->loadBlob(ArtifactKeep::Yes, blob.writeRef())))
+        return;
+
+    List<uint8_t> data;
+    const uint32_t diagnosticsSize = uint32_t(diagnostics.getLength());
+    data.addRange((const uint8_t*)&diagnosticsSize, sizeof(diagnosticsSize));
+    data.addRange((const uint8_t*)diagnostics.getBuffer(), diagnosticsSize);
+    data.addRange((const uint8_t*)blob->getBufferPointer(), Index(blob->getBufferSize()));
+
+    cache->writeEntry(key, ListBlob::moveCreate(data));
+}
+
+IArtifact* TargetProgram::_compileResult(
+    Int entryPointIndex,
+    DiagnosticSink* sink,
+    PersistentCache* cache,
+    const PersistentCache::Key& cacheKey)
+{
+    // Everything the compile reports goes on to `sink`, and is also kept with the cache entry so
+    // that a hit reports it too.
+    DiagnosticSink compileSink(sink->getSourceManager(), sink->getSourceLocationLexer(), sink);
+    compileSink.setSourceWarningStateTracker(sink->getSourceWarningStateTracker());
+    compileSink.setParentSink(sink);
+
+    // If we haven't yet computed a layout for this target
+    // program, we need to make sure that is done before
+    // code generation.
+    //
+    if (!getOrCreateIRModuleForLayout(&compileSink))
+    {
+        return nullptr;
+    }
+
+    IArtifact* artifact = (entryPointIndex >= 0)
+                              ? _createEntryPointResult(entryPointIndex, &compileSink)
+                              : _createWholeProgramResult(&compileSink);
+    if (cache && artifact && compileSink.getErrorCount() == 0)
+        _writeCachedResult(cache, cacheKey, artifact, compileSink.outputBuffer);
+    return artifact;
+}
+
+IArtifact* TargetProgram::_requireResultMetadata(
+    Int entryPointIndex,
+    IArtifact* artifact,
+    DiagnosticSink* sink)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_resultCacheMutex);
+        if (!m_resultsFromCache.contains(artifact))
+            return artifact;
+    }
+
+    // The diagnostics of the compile were reported when the result was taken from the cache, so
+    // only a failure is reported again.
+    DiagnosticSink compileSink(sink->getSourceManager(), sink->getSourceLocationLexer(), sink);
+    compileSink.setSourceWarningStateTracker(sink->getSourceWarningStateTracker());
+
+    if (!getOrCreateIRModuleForLayout(&compileSink))
+    {
+        sink->diagnoseRaw(Severity::Error, compileSink.outputBuffer.getUnownedSlice());
+        return nullptr;
+    }
+
+    List<Int> entryPointIndices;
+    if (entryPointIndex >= 0)
+    {
+        entryPointIndices.add(entryPointIndex);
+    }
+    else
+    {
+        for (Index i = 0; i < m_program->getEntryPointCount(); i++)
+            entryPointIndices.add(i);
+    }
+
+    CodeGenContext::Shared sharedCodeGenContext(this, entryPointIndices, &compileSink, nullptr);
+    CodeGenContext codeGenContext(&sharedCodeGenContext);
+
+    ComPtr<IArtifact> compiledArtifact;
+    if (SLANG_FAILED(codeGenContext.emitEntryPoints(compiledArtifact)))
+    {
+        sink->diagnoseRaw(Severity::Error, compileSink.outputBuffer.getUnownedSlice());
+        return nullptr;
+    }
+
+    // The published result may already be in use, so it is kept, and given the metadata.
+    std::lock_guard<std::mutex> lock(m_resultCacheMutex);
+    if (m_resultsFromCache.contains(artifact))
+    {
+        m_resultsFromCache.remove(artifact);
+        ArtifactUtil::addAssociated(
+            artifact,
+            findAssociatedRepresentation<IArtifactPostEmitMetadata>(compiledArtifact));
+    }
+    return artifact;
+}
+
+IArtifact* TargetProgram::_publishWholeProgramResult(IArtifact* artifact, bool isFromCache)
+{
+    // Two threads may finish the same whole-program compile concurrently; publish only one
+    // cached result.
+    std::lock_guard<std::mutex> lock(m_resultCacheMutex);
+    if (m_wholeProgramResult)
+        return m_wholeProgramResult;
+    m_wholeProgramResult = artifact;
+    if (isFromCache)
+        m_resultsFromCache.add(artifact);
+    return m_wholeProgramResult;
+}
+
+IArtifact* TargetProgram::_publishEntryPointResult(
+    Int entryPointIndex,
+    IArtifact* artifact,
+    bool isFromCache)
+{
+    // Parallel entry-point compiles can finish in either order, so guard the resize and
+    // cache publish together.
+    std::lock_guard<std::mutex> lock(m_resultCacheMutex);
+    if (entryPointIndex >= m_entryPointResults.getCount())
+        m_entryPointResults.setCount(entryPointIndex + 1);
+    if (m_entryPointResults[entryPointIndex])
+        return m_entryPointResults[entryPointIndex];
+    m_entryPointResults[entryPointIndex] = artifact;
+    if (isFromCache)
+        m_resultsFromCache.add(artifact);
+    return m_entryPointResults[entryPointIndex];
+}
+
+RefPtr<ProgramLinkingInfo> TargetProgram::getOrCreateLinkingInfo(ArrayView<IRModule*> modules)
+{
+    // A program is usually linked with the same modules each time. If they changed (for example
+    // because the layout module was created since the last link), start over, and leave the old
+    // cache to any links still using it.
+    std::lock_guard<std::mutex> lock(m_linkingInfoMutex);
+    if (!m_linkingInfo || !m_linkingInfo->isForModules(modules))
+        m_linkingInfo = new ProgramLinkingInfo(modules);
+    return m_linkingInfo;
+}
+
 IArtifact* TargetProgram::_createWholeProgramResult(
     DiagnosticSink* sink,
     EndToEndCompileRequest* endToEndReq)
@@ -43,15 +284,7 @@ IArtifact* TargetProgram::_createWholeProgramResult(
         return nullptr;
     }
 
-    {
-        // Two threads may finish the same whole-program compile concurrently; publish only one
-        // cached result.
-        std::lock_guard<std::mutex> lock(m_resultCacheMutex);
-        if (m_wholeProgramResult)
-            return m_wholeProgramResult;
-        m_wholeProgramResult = artifact;
-        return m_wholeProgramResult;
-    }
+    return _publishWholeProgramResult(artifact);
 }
 
 IArtifact* TargetProgram::_createEntryPointResult(
@@ -82,45 +315,46 @@ IArtifact* TargetProgram::_createEntryPointResult(
         return nullptr;
     }
 
-    {
-        // Parallel entry-point compiles can finish in either order, so guard the resize and
-        // cache publish together.
-        std::lock_guard<std::mutex> lock(m_resultCacheMutex);
-        if (entryPointIndex >= m_entryPointResults.getCount())
-            m_entryPointResults.setCount(entryPointIndex + 1);
-        if (m_entryPointResults[entryPointIndex])
-            return m_entryPointResults[entryPointIndex];
-        m_entryPointResults[entryPointIndex] = artifact;
-        return m_entryPointResults[entryPointIndex];
-    }
+    return _publishEntryPointResult(entryPointIndex, artifact);
 }
 
-IArtifact* TargetProgram::getOrCreateWholeProgramResult(DiagnosticSink* sink)
+IArtifact* TargetProgram::getOrCreateWholeProgramResult(
+    DiagnosticSink* sink,
+    bool requireMetadata)
 {
+    IArtifact* existingArtifact = nullptr;
     {
         // Fast-path the whole-program cache without racing a concurrent publisher.
         std::lock_guard<std::mutex> lock(m_resultCacheMutex);
-        if (m_wholeProgramResult)
-            return m_wholeProgramResult;
+        existingArtifact = m_wholeProgramResult;
+    }
+    if (existingArtifact)
+    {
+        return requireMetadata ? _requireResultMetadata(-1, existingArtifact, sink)
+                               : existingArtifact;
     }
 
-    // If we haven't yet computed a layout for this target
-    // program, we need to make sure that is done before
-    // code generation.
-    //
-    if (!getOrCreateIRModuleForLayout(sink))
+    // A hit in the compilation cache skips layout, linking, the IR pass pipeline and emit.
+    PersistentCache::Key cacheKey;
+    PersistentCache* cache = _findCompilationCache(-1, cacheKey);
+    if (cache && !requireMetadata)
     {
-        return nullptr;
+        if (auto cachedArtifact = _readCachedResult(cache, cacheKey, sink))
+            return _publishWholeProgramResult(cachedArtifact, true);
     }
 
-    return _createWholeProgramResult(sink);
+    return _compileResult(-1, sink, cache, cacheKey);
 }
 
-IArtifact* TargetProgram::getOrCreateEntryPointResult(Int entryPointIndex, DiagnosticSink* sink)
+IArtifact* TargetProgram::getOrCreateEntryPointResult(
+    Int entryPointIndex,
+    DiagnosticSink* sink,
+    bool requireMetadata)
 {
     if (entryPointIndex < 0)
         return nullptr;
 
+    IArtifact* existingArtifact = nullptr;
     {
         // Guard the cache probe and lazy result-array resize against concurrent entry-point
         // compiles for this target program.
@@ -128,22 +362,27 @@ IArtifact* TargetProgram::getOrCreateEntryPointResult(Int entryPointIndex, Diagn
         if (entryPointIndex >= m_entryPointResults.getCount())
             m_entryPointResults.setCount(entryPointIndex + 1);
 
-        if (IArtifact* artifact = m_entryPointResults[entryPointIndex])
-            return artifact;
+        existingArtifact = m_entryPointResults[entryPointIndex];
     }
 
     try
     {
-        // If we haven't yet computed a layout for this target
-        // program, we need to make sure that is done before
-        // code generation.
-        //
-        if (!getOrCreateIRModuleForLayout(sink))
+        if (existingArtifact)
+        {
+            return requireMetadata ? _requireResultMetadata(entryPointIndex, existingArtifact, sink)
+                                   : existingArtifact;
+        }
+
+        // A hit in the compilation cache skips layout, linking, the IR pass pipeline and emit.
+        PersistentCache::Key cacheKey;
+        PersistentCache* cache = _findCompilationCache(entryPointIndex, cacheKey);
+        if (cache && !requireMetadata)
         {
-            return nullptr;
+            if (auto cachedArtifact = _readCachedResult(cache, cacheKey, sink))
+                return _publishEntryPointResult(entryPointIndex, cachedArtifact, true);
         }
 
-        return _createEntryPointResult(entryPointIndex, sink);
+        return _compileResult(entryPointIndex, sink, cache, cacheKey);
     }
     catch (const Exception& e)
     {
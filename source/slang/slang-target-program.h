@@ -7,12 +7,14 @@
 // linked program/binary and/or its entry points.
 //
 
+#include "core/slang-persistent-cache.h"
 #include "core/slang-smart-pointer.h"
 #include "slang-hlsl-to-vulkan-layout-options.h"
 #include "slang-ir.h"
 #include "slang-linkable.h"
 #include "slang-target.h"
 
+#include <atomic>
 #include <mutex>
 
 namespace Slang
@@ -60,8 +62,15 @@ public:
     /// been requested, report any errors that arise during
     /// code generation to the given `sink`.
     ///
-    IArtifact* getOrCreateEntryPointResult(Int entryPointIndex, DiagnosticSink* sink);
-    IArtifact* getOrCreateWholeProgramResult(DiagnosticSink* sink);
+    /// A result taken from the compilation cache holds the code and nothing else. If
+    /// `requireMetadata` is set, such a result gets its post-emit metadata by compiling
+    /// the program.
+    ///
+    IArtifact* getOrCreateEntryPointResult(
+        Int entryPointIndex,
+        DiagnosticSink* sink,
+        bool requireMetadata = false);
+    IArtifact* getOrCreateWholeProgramResult(DiagnosticSink* sink, bool requireMetadata = false);
 
     IArtifact* getExistingWholeProgramResult()
     {
@@ -103,6 +112,10 @@ public:
 
     RefPtr<IRModule> getExistingIRModuleForLayout() { return m_irModuleForLayout; }
 
+    /// Get the symbol resolutions cached by earlier links of the program for this target, if
+    /// they linked the same `modules`, or start a new cache for them.
+    RefPtr<ProgramLinkingInfo> getOrCreateLinkingInfo(ArrayView<IRModule*> modules);
+
     CompilerOptionSet& getOptionSet() { return m_optionSet; }
 
     HLSLToVulkanLayoutOptions* getHLSLToVulkanLayoutOptions()
@@ -118,6 +131,48 @@ public:
 private:
     RefPtr<IRModule> createIRModuleForLayout(DiagnosticSink* sink);
 
+    /// Find the linkage's compilation cache and compute the key for an entry point's result,
+    /// or for the whole-program result if `entryPointIndex` is -1.
+    ///
+    /// Returns null if caching is disabled or results for this target can't be cached.
+    PersistentCache* _findCompilationCache(Int entryPointIndex, PersistentCache::Key& outKey);
+
+    /// Read a result from the compilation cache, reporting the diagnostics the compile that
+    /// produced it reported to `sink`.
+    ComPtr<IArtifact> _readCachedResult(
+        PersistentCache* cache,
+        const PersistentCache::Key& key,
+        DiagnosticSink* sink);
+    void _writeCachedResult(
+        PersistentCache* cache,
+        const PersistentCache::Key& key,
+        IArtifact* artifact,
+        const StringBuilder& diagnostics);
+
+    /// Compute the layout if needed, and compile an entry point, or the whole program if
+    /// `entryPointIndex` is -1. Writes the result to the compilation cache if `cache` is set.
+    IArtifact* _compileResult(
+        Int entryPointIndex,
+        DiagnosticSink* sink,
+        PersistentCache* cache,
+        const PersistentCache::Key& cacheKey);
+
+    /// If `artifact` was taken from the compilation cache, compile it again and add the
+    /// post-emit metadata of the compile to it.
+    IArtifact* _requireResultMetadata(
+        Int entryPointIndex,
+        IArtifact* artifact,
+        DiagnosticSink* sink);
+
+    /// Publish a result into the lazy result caches, returning whichever result won if
+    /// another thread published first. `isFromCache` is set for a result taken from the
+    /// compilation cache.
+    IArtifact* _publishWholeProgramResult(IArtifact* artifact, bool isFromCache = false);
+    IArtifact* _publishEntryPointResult(
+        Int entryPointIndex,
+        IArtifact* artifact,
+        bool isFromCache = false);
+
     // The program being compiled or laid out
     ComponentType* m_program;
 
@@ -137,7 +192,19 @@ private:
     ComPtr<IArtifact> m_wholeProgramResult;
     List<ComPtr<IArtifact>> m_entryPointResults;
 
+    // The results above that were taken from the compilation cache, and so have no post-emit
+    // metadata yet.
+    HashSet<IArtifact*> m_resultsFromCache;
+
     RefPtr<IRModule> m_irModuleForLayout;
+
+    // Shared by the links for each entry point, which can run on several threads.
+    std::mutex m_linkingInfoMutex;
+    RefPtr<ProgramLinkingInfo> m_linkingInfo;
+
+    // Set once `m_layout` and `m_irModuleForLayout` are both published; after that they are
+    // read-only and `getOrCreateLayout` no longer needs the linkage operation mutex.
+    std::atomic<bool> m_isLayoutComplete{false};
 };
 
 /// Given a target request returns which (if any) intermediate source language is required
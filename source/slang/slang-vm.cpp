@@ -388,6 +388,7 @@ SlangResult ByteCodeInterpreter::prepareModuleForExecution()
             memcpy(exeFunc.m_codeBuffer.getBuffer(), func.functionCode, func.header->codeSize);
 
         // Replace the instruction headers with function pointers
+        exeFunc.m_handlers.clear();
         for (auto inst : exeFunc)
         {
             VMInstHeader* instHeader = reinterpret_cast<VMInstHeader*>(inst);
@@ -401,7 +402,12 @@ SlangResult ByteCodeInterpreter::prepareModuleForExecution()
                     instStr.toString().getBuffer());
                 return SLANG_FAIL;
             }
+            exeFunc.m_handlers.add(handler);
+#if SLANG_ENABLE_VALIDATION_VM_BYTECODE
+            inst->functionPtr = validateAndExecuteInst;
+#else
             inst->functionPtr = handler;
+#endif
             for (uint32_t operandIdx = 0; operandIdx < instHeader->operandCount; operandIdx++)
             {
                 auto& operand = instHeader->getOperand(operandIdx);
@@ -791,6 +797,24 @@ static bool validateSpecialOperandSection(
     return true;
 }
 
+void ByteCodeInterpreter::validateAndExecuteInst(
+    IByteCodeRunner* runner,
+    VMExecInstHeader* inst,
+    void* userData)
+{
+    // Everything `validateCurrentInstruction` checks is fixed once the module is loaded (the
+    // sizes of the sections, and which function an instruction belongs to), so an instruction
+    // that passes once always passes. Install its handler so later runs skip validation.
+    auto ctx = static_cast<ByteCodeInterpreter*>(runner);
+    if (!ctx->validateCurrentInstruction(inst))
+        return;
+    auto instOffset = uint32_t((uint8_t*)inst - (uint8_t*)ctx->m_currentFuncCode);
+    auto instIndex = findInstIndex(*ctx->m_currentFunction, instOffset);
+    auto handler = ctx->m_currentFunction->m_handlers[instIndex];
+    inst->functionPtr = handler;
+    handler(runner, inst, userData);
+}
+
 bool ByteCodeInterpreter::validateCurrentInstruction(VMExecInstHeader* inst)
 {
     if (!m_currentFunction || !m_currentFuncCode)
@@ -1117,16 +1141,24 @@ ByteCodeInterpreter::execute(void* argumentData, size_t argumentSize)
     }
     m_returnValSize = 0;
     m_executionFailed = false;
-    while (m_currentInst)
+
+    // Handlers that transfer control (jumps, calls and returns) overwrite `m_currentInst`, so it
+    // is advanced before the handler runs. Validation happens in the handlers themselves (see
+    // `validateAndExecuteInst`), so apart from the end-of-code check this loop only dispatches.
+    auto userData = m_extInstHandlerUserData;
+    while (auto currentInst = m_currentInst)
     {
 #if SLANG_ENABLE_VALIDATION_VM_BYTECODE
-        if (!validateCurrentInstruction(m_currentInst))
+        // A function whose last instruction isn't a terminator falls through to the end of its
+        // code, which no handler ever gets to validate.
+        if ((uint8_t*)currentInst >= (uint8_t*)m_currentFunction->m_codeBuffer.end())
+        {
+            reportError("VM execution ran past the end of the function code.");
             return SLANG_FAIL;
+        }
 #endif
-        auto nextInst = m_currentInst->getNextInst();
-        auto currentInst = m_currentInst;
-        m_currentInst = nextInst;
-        currentInst->functionPtr(this, currentInst, m_extInstHandlerUserData);
+        m_currentInst = currentInst->getNextInst();
+        currentInst->functionPtr(this, currentInst, userData);
         if (m_executionFailed)
             return SLANG_FAIL;
     }
@@ -34,6 +34,12 @@ public:
     List<uint32_t> m_instOffsets;
     List<VMOp> m_opcodes;
 
+    // The handler of each instruction, in the same order as `m_instOffsets`. With validation
+    // enabled, instructions start out running `validateAndExecuteInst`, which validates them the
+    // first time they run and then installs the handler from here, so the dispatch loop doesn't
+    // validate every instruction every time it runs.
+    List<VMExtFunction> m_handlers;
+
     InstIterator begin();
     InstIterator end();
 
@@ -153,6 +159,10 @@ public:
     }
 
 #if SLANG_ENABLE_VALIDATION_VM_BYTECODE
+    static void validateAndExecuteInst(
+        IByteCodeRunner* runner,
+        VMExecInstHeader* inst,
+        void* userData);
     bool validateCurrentInstruction(VMExecInstHeader* inst);
     bool validateOperandAccess(
         const VMExecOperand& operand,
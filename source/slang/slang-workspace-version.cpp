@@ -76,6 +76,20 @@ void Workspace::closeDoc(const String& path)
     invalidate();
 }
 
+static bool _isSameMacroList(
+    List<OwnedPreprocessorMacroDefinition> const& a,
+    List<OwnedPreprocessorMacroDefinition> const& b)
+{
+    if (a.getCount() != b.getCount())
+        return false;
+    for (Index i = 0; i < a.getCount(); i++)
+    {
+        if (a[i].name != b[i].name || a[i].value != b[i].value)
+            return false;
+    }
+    return true;
+}
+
 bool Workspace::updatePredefinedMacros(List<String> macros)
 {
     List<OwnedPreprocessorMacroDefinition> newDefs;
@@ -95,25 +109,11 @@ bool Workspace::updatePredefinedMacros(List<String> macros)
         newDefs.add(def);
     }
 
-    bool changed = false;
-    if (newDefs.getCount() != predefinedMacros.getCount())
-        changed = true;
-    else
-    {
-        for (Index i = 0; i < newDefs.getCount(); i++)
-        {
-            if (newDefs[i].name != predefinedMacros[i].name ||
-                newDefs[i].value != predefinedMacros[i].value)
-            {
-                changed = true;
-                break;
-            }
-        }
-    }
+    bool changed = !_isSameMacroList(newDefs, predefinedMacros);
     if (changed)
     {
         predefinedMacros = _Move(newDefs);
-        invalidate();
+        invalidateModuleCaches();
     }
     return changed;
 }
@@ -137,7 +137,7 @@ bool Workspace::updateSearchPaths(List<String> paths)
     if (changed)
     {
         additionalSearchPaths = _Move(paths);
-        invalidate();
+        invalidateModuleCaches();
     }
     return changed;
 }
@@ -148,7 +148,7 @@ bool Workspace::updateSearchInWorkspace(bool value)
     searchInWorkspace = value;
     if (changed)
     {
-        invalidate();
+        invalidateModuleCaches();
     }
     return changed;
 }
@@ -159,7 +159,7 @@ bool Workspace::updatePredefinedLanguageVersion(SlangLanguageVersion version)
     predefinedLanguageVersion = version;
     if (changed)
     {
-        invalidate();
+        invalidateModuleCaches();
     }
     return changed;
 }
@@ -210,7 +210,67 @@ void Workspace::invalidate()
     currentVersion = nullptr;
 }
 
-void WorkspaceVersion::parseDiagnostics(String compilerOutput)
+RefPtr<WorkspaceSnapshot> Workspace::takeSnapshot()
+{
+    RefPtr<WorkspaceSnapshot> snapshot = new WorkspaceSnapshot();
+    for (const auto& [path, doc] : openedDocuments)
+        snapshot->documents[path] = doc->getText();
+    snapshot->rootDirectories = rootDirectories;
+    snapshot->additionalSearchPaths = additionalSearchPaths;
+    snapshot->workspaceSearchPaths = workspaceSearchPaths;
+    snapshot->predefinedMacros = predefinedMacros;
+    snapshot->searchInWorkspace = searchInWorkspace;
+    snapshot->workspaceFlavor = workspaceFlavor;
+    snapshot->predefinedLanguageVersion = predefinedLanguageVersion;
+    return snapshot;
+}
+
+void Workspace::applySnapshot(WorkspaceSnapshot const& snapshot)
+{
+    List<String> closedPaths;
+    for (const auto& [path, _] : openedDocuments)
+    {
+        if (!snapshot.documents.containsKey(path))
+            closedPaths.add(path);
+    }
+    for (auto& path : closedPaths)
+        closeDoc(path);
+    for (const auto& [path, text] : snapshot.documents)
+    {
+        RefPtr<DocumentVersion> doc;
+        if (!openedDocuments.tryGetValue(path, doc))
+            openDoc(path, text);
+        else if (doc->getText() != text)
+            changeDoc(doc.Ptr(), text);
+    }
+
+    // Settings that change how modules are checked drop the checked modules, the rest only need
+    // a new version.
+    rootDirectories = snapshot.rootDirectories;
+    workspaceSearchPaths = snapshot.workspaceSearchPaths;
+    workspaceFlavor = snapshot.workspaceFlavor;
+    updateSearchPaths(snapshot.additionalSearchPaths);
+    updateSearchInWorkspace(snapshot.searchInWorkspace);
+    updatePredefinedLanguageVersion(snapshot.predefinedLanguageVersion);
+    if (!_isSameMacroList(snapshot.predefinedMacros, predefinedMacros))
+    {
+        predefinedMacros = snapshot.predefinedMacros;
+        invalidateModuleCaches();
+    }
+    invalidate();
+}
+
+void Workspace::invalidateModuleCaches()
+{
+    // The modules checked so far were checked with the old settings.
+    moduleCache = nullptr;
+    completionModuleCache = nullptr;
+    invalidate();
+}
+
+void WorkspaceVersion::parseDiagnostics(
+    String compilerOutput,
+    Dictionary<String, DocumentDiagnostics>& outDiagnostics)
 {
     // ===================================================================================
     // Machine-Readable Diagnostic Format Parser
@@ -479,7 +539,7 @@ void WorkspaceVersion::parseDiagnostics(String compilerOutput)
         }
 
         // Add the diagnostic to the appropriate file's list
-        auto& diagnosticList = diagnostics.getOrAddValue(fileName, DocumentDiagnostics());
+        auto& diagnosticList = outDiagnostics.getOrAddValue(fileName, DocumentDiagnostics());
         diagnosticList.messages.add(diagnostic);
 
         if (diagnosticList.messages.getCount() >= 1000)
@@ -487,23 +547,14 @@ void WorkspaceVersion::parseDiagnostics(String compilerOutput)
     }
 }
 
-RefPtr<WorkspaceVersion> Workspace::createWorkspaceVersion()
+List<String> Workspace::getSearchPaths()
 {
-    RefPtr<WorkspaceVersion> version = new WorkspaceVersion();
-    version->workspace = this;
-    slang::SessionDesc desc = {};
-    desc.fileSystem = this;
-    desc.targetCount = 1;
-    slang::TargetDesc targetDesc = {};
-    targetDesc.profile = slangGlobalSession->findProfile("sm_6_6");
-    desc.targets = &targetDesc;
-    List<const char*> searchPathsRaw;
-    for (auto& path : additionalSearchPaths)
-        searchPathsRaw.add(path.getBuffer());
+    List<String> searchPaths;
+    searchPaths.addRange(additionalSearchPaths);
     if (searchInWorkspace)
     {
         for (auto& path : workspaceSearchPaths)
-            searchPathsRaw.add(path.getBuffer());
+            searchPaths.add(path);
     }
     else
     {
@@ -512,9 +563,23 @@ RefPtr<WorkspaceVersion> Workspace::createWorkspaceVersion()
         {
             auto dir = Path::getParentDirectory(docPath.getBuffer());
             if (set.add(dir))
-                searchPathsRaw.add(dir.getBuffer());
+                searchPaths.add(dir);
         }
     }
+    return searchPaths;
+}
+
+RefPtr<Linkage> Workspace::createLinkage(List<String> const& searchPaths)
+{
+    slang::SessionDesc desc = {};
+    desc.fileSystem = this;
+    desc.targetCount = 1;
+    slang::TargetDesc targetDesc = {};
+    targetDesc.profile = slangGlobalSession->findProfile("sm_6_6");
+    desc.targets = &targetDesc;
+    List<const char*> searchPathsRaw;
+    for (auto& path : searchPaths)
+        searchPathsRaw.add(path.getBuffer());
     desc.searchPaths = searchPathsRaw.getBuffer();
     desc.searchPathCount = searchPathsRaw.getCount();
 
@@ -548,8 +613,196 @@ RefPtr<WorkspaceVersion> Workspace::createWorkspaceVersion()
 
     ComPtr<Linkage> linkage;
     session->queryInterface(Linkage::getTypeGuid(), (void**)linkage.writeRef());
-    version->linkage = linkage.get();
-    version->linkage->contentAssistInfo.checkingMode = ContentAssistCheckingMode::General;
+    return linkage.get();
+}
+
+// Whether the contents of `file` differ from what `workspace` loads for its path now.
+static bool _isFileOutdated(Workspace* workspace, SourceFile* file)
+{
+    ComPtr<ISlangBlob> blob;
+    const auto& path = file->getPathInfo().foundPath;
+    if (path.getLength() == 0 ||
+        SLANG_FAILED(workspace->loadFile(path.getBuffer(), blob.writeRef())))
+        return true;
+    auto contents = SourceFile::decodeContentBlob(blob);
+    return file->getContent() != UnownedStringSlice(
+                                    (const char*)contents->getBufferPointer(),
+                                    contents->getBufferSize());
+}
+
+static bool _hasFailedImport(Module* module)
+{
+    auto moduleDecl = module->getModuleDecl();
+    if (!moduleDecl)
+        return false;
+    for (auto importDecl : moduleDecl->getMembersOfType<ImportDecl>())
+    {
+        if (!importDecl->importedModuleDecl)
+            return true;
+    }
+    return false;
+}
+
+static String _getCanonicalPath(SourceFile* file)
+{
+    String canonicalPath;
+    if (SLANG_FAILED(Path::getCanonical(file->getPathInfo().foundPath, canonicalPath)))
+        return file->getPathInfo().foundPath;
+    return canonicalPath;
+}
+
+static void _addDiagnostics(
+    Dictionary<String, DocumentDiagnostics>& ioDiagnostics,
+    const String& fileName,
+    const DocumentDiagnostics& fileDiagnostics)
+{
+    auto& diagnostics = ioDiagnostics.getOrAddValue(fileName, DocumentDiagnostics());
+    for (const auto& message : fileDiagnostics.messages)
+        diagnostics.messages.add(message);
+    if (fileDiagnostics.originalOutput.getLength())
+        diagnostics.originalOutput = fileDiagnostics.originalOutput;
+}
+
+template<typename T, typename Predicate>
+static void _removeIf(List<T>& list, Predicate&& predicate)
+{
+    Index count = 0;
+    for (Index i = 0; i < list.getCount(); i++)
+    {
+        if (predicate(list[i]))
+            continue;
+        if (count != i)
+            list[count] = _Move(list[i]);
+        count++;
+    }
+    list.setCount(count);
+}
+
+void WorkspaceModuleCache::removeOutdatedModules(Workspace* workspace)
+{
+    // The file system of the linkage keeps the contents of the files it has loaded.
+    linkage->getFileSystemExt()->clearCache();
+
+    // Forget the imports that failed, in case the modules they name have been created since.
+    linkage->mapNameToLoadedModules.removeIf([](const auto& entry) { return !entry.second; });
+
+    // The file and module dependencies of a module include those of the modules it imports, so
+    // checking them finds the modules that import an outdated module too.
+    auto sourceManager = linkage->getSourceManager();
+    Dictionary<SourceFile*, bool> isFileOutdated;
+    HashSet<Module*> outdatedModules;
+    for (auto& module : linkage->loadedModulesList)
+    {
+        bool isOutdated = false;
+        for (auto file : module->getFileDependencyList())
+        {
+            // The files of the builtin modules belong to the global session.
+            if (file->getSourceManager() != sourceManager)
+                continue;
+            bool* cachedResult = isFileOutdated.tryGetValue(file);
+            isOutdated = cachedResult ? *cachedResult : _isFileOutdated(workspace, file);
+            isFileOutdated[file] = isOutdated;
+            if (isOutdated)
+                break;
+        }
+        for (Index i = 0; !isOutdated && i < module->getModuleDependencyList().getCount(); i++)
+            isOutdated = _hasFailedImport(module->getModuleDependencyList()[i]);
+        if (isOutdated)
+            outdatedModules.add(module.get());
+    }
+    if (outdatedModules.getCount())
+        removeModules(outdatedModules);
+}
+
+void WorkspaceModuleCache::removeModules(HashSet<Module*> const& modules)
+{
+    // A file that a remaining module depends on is kept as it is.
+    auto sourceManager = linkage->getSourceManager();
+    HashSet<SourceFile*> remainingFiles;
+    for (auto& module : linkage->loadedModulesList)
+    {
+        if (modules.contains(module.get()))
+            continue;
+        for (auto file : module->getFileDependencyList())
+            remainingFiles.add(file);
+    }
+    HashSet<SourceFile*> removedFiles;
+    for (auto module : modules)
+    {
+        for (auto file : module->getFileDependencyList())
+        {
+            if (file->getSourceManager() == sourceManager && !remainingFiles.contains(file))
+                removedFiles.add(file);
+        }
+    }
+
+    linkage->removeLoadedModules(modules);
+    removedModuleCount += modules.getCount();
+
+    for (auto file : removedFiles)
+    {
+        sourceManager->forgetSourceFile(file);
+        diagnostics.remove(_getCanonicalPath(file));
+    }
+
+    // The preprocessor records content assist information for every module it preprocesses.
+    // Remove what it recorded while preprocessing a removed file, including the files that file
+    // included.
+    auto isRemoved = [&](SourceLoc loc)
+    {
+        auto view = sourceManager->findSourceView(loc);
+        while (view && view->getInitiatingSourceLoc().isValid())
+            view = sourceManager->findSourceView(view->getInitiatingSourceLoc());
+        return view && removedFiles.contains(view->getSourceFile());
+    };
+    auto& preprocessorInfo = linkage->contentAssistInfo.preprocessorInfo;
+    auto isRecordedForRemovedFile = [&](const auto& info) { return isRemoved(info.loc); };
+    _removeIf(preprocessorInfo.macroDefinitions, isRecordedForRemovedFile);
+    _removeIf(preprocessorInfo.macroInvocations, isRecordedForRemovedFile);
+    _removeIf(preprocessorInfo.fileIncludes, isRecordedForRemovedFile);
+}
+
+RefPtr<WorkspaceVersion> Workspace::createWorkspaceVersion(ContentAssistCheckingMode checkingMode)
+{
+    // A linkage that has removed this many modules is replaced, to release their ASTs.
+    static const Index kMaxRemovedModuleCount = 256;
+
+    auto& cache =
+        checkingMode == ContentAssistCheckingMode::Completion ? completionModuleCache : moduleCache;
+    auto searchPaths = getSearchPaths();
+    if (cache)
+    {
+        // The modules checked so far can be kept while search paths are only added after the
+        // existing ones, as imports that succeeded would still find the same files.
+        bool canReuse = cache->flavor == workspaceFlavor &&
+                        cache->removedModuleCount < kMaxRemovedModuleCount &&
+                        searchPaths.getCount() >= cache->searchPaths.getCount();
+        for (Index i = 0; canReuse && i < cache->searchPaths.getCount(); i++)
+            canReuse = searchPaths[i] == cache->searchPaths[i];
+        if (!canReuse)
+            cache = nullptr;
+    }
+    if (cache)
+    {
+        for (Index i = cache->searchPaths.getCount(); i < searchPaths.getCount(); i++)
+            cache->linkage->addSearchPath(searchPaths[i].getBuffer());
+        cache->searchPaths = searchPaths;
+        cache->removeOutdatedModules(this);
+    }
+    else
+    {
+        cache = new WorkspaceModuleCache();
+        cache->linkage = createLinkage(searchPaths);
+        cache->linkage->contentAssistInfo.checkingMode = checkingMode;
+        cache->searchPaths = searchPaths;
+    }
+
+    RefPtr<WorkspaceVersion> version = new WorkspaceVersion();
+    version->workspace = this;
+    version->moduleCache = cache;
+    version->flavor = cache->flavor;
+    version->linkage = cache->linkage;
+    version->linkage->contentAssistInfo.completionSuggestions.clear();
     return version;
 }
 
@@ -568,14 +821,12 @@ SlangResult Workspace::loadFile(const char* path, ISlangBlob** outBlob)
 WorkspaceVersion* Workspace::getCurrentVersion()
 {
     if (!currentVersion)
-        currentVersion = createWorkspaceVersion();
+        currentVersion = createWorkspaceVersion(ContentAssistCheckingMode::General);
     return currentVersion.Ptr();
 }
 WorkspaceVersion* Workspace::createVersionForCompletion()
 {
-    currentCompletionVersion = createWorkspaceVersion();
-    currentCompletionVersion->linkage->contentAssistInfo.checkingMode =
-        ContentAssistCheckingMode::Completion;
+    currentCompletionVersion = createWorkspaceVersion(ContentAssistCheckingMode::Completion);
     return currentCompletionVersion.Ptr();
 }
 
@@ -778,6 +1029,7 @@ void WorkspaceVersion::ensureWorkspaceFlavor(UnownedStringSlice path)
         // Setup linkage for vfx files.
         // TODO: consider supporting this as an external config file.
         flavor = WorkspaceFlavor::VFX;
+        moduleCache->flavor = flavor;
         linkage->m_optionSet.set(CompilerOptionName::EnableEffectAnnotations, true);
         linkage->addPreprocessorDefine("VS", "__file_decl");
         linkage->addPreprocessorDefine("CS", "__file_decl");
@@ -801,7 +1053,7 @@ void WorkspaceVersion::ensureWorkspaceFlavor(UnownedStringSlice path)
 
 Module* WorkspaceVersion::getOrLoadModule(String path)
 {
-    Module* module;
+    RefPtr<Module> module;
     if (modules.tryGetValue(path, module))
     {
         return module;
@@ -813,11 +1065,24 @@ Module* WorkspaceVersion::getOrLoadModule(String path)
     auto sourceBlob = StringBlob::create((*doc)->getText());
 
     auto moduleName = getMangledNameFromNameString(path.getUnownedSlice());
-    linkage->contentAssistInfo.primaryModuleName = linkage->getNamePool()->getName(moduleName);
+    auto moduleNameObj = linkage->getNamePool()->getName(moduleName);
+    linkage->contentAssistInfo.primaryModuleName = moduleNameObj;
     linkage->contentAssistInfo.primaryModulePath = path;
 
     ensureWorkspaceFlavor(path.getUnownedSlice());
 
+    // A module checked for a completion request only has the function at the cursor checked, so
+    // it is checked again for every request.
+    RefPtr<LoadedModule> previousModule;
+    if (linkage->contentAssistInfo.checkingMode == ContentAssistCheckingMode::Completion &&
+        linkage->mapNameToLoadedModules.tryGetValue(moduleNameObj, previousModule) &&
+        previousModule)
+    {
+        HashSet<Module*> previousModules;
+        previousModules.add(previousModule.get());
+        moduleCache->removeModules(previousModules);
+    }
+
     // Note:
     // The module at `path` may have already been loaded into the linkage previously
     // due to an `import`. However that module won't get fully checked in when the checker
@@ -826,24 +1091,51 @@ Module* WorkspaceVersion::getOrLoadModule(String path)
     // trying to reuse the existing one through `findOrImportModule`, this will result in
     // redundant parsing and storage, but it saves us from the hassle of handling
     // incremental/lazy checking on a previously loaded module.
+    //
+    // If an earlier version loaded the document, and neither it nor anything it depends on has
+    // changed since, `loadModuleFromSource` returns the module checked then.
     auto parsedModule = linkage->loadModuleFromSource(
         moduleName.getBuffer(),
         path.getBuffer(),
         sourceBlob,
         diagnosticBlob.writeRef());
-    if (parsedModule)
-    {
-        modules[path] = static_cast<Module*>(parsedModule);
-    }
+    module = static_cast<Module*>(parsedModule);
     if (diagnosticBlob)
     {
         auto diagnosticString = String((const char*)diagnosticBlob->getBufferPointer());
-        parseDiagnostics(diagnosticString);
-        auto docDiagnostic = diagnostics.tryGetValue(path);
+        Dictionary<String, DocumentDiagnostics> loadDiagnostics;
+        parseDiagnostics(diagnosticString, loadDiagnostics);
+        auto docDiagnostic = loadDiagnostics.tryGetValue(path);
         if (docDiagnostic)
             docDiagnostic->originalOutput = diagnosticString;
+        for (const auto& [fileName, fileDiagnostics] : loadDiagnostics)
+        {
+            // A file imported by an earlier document may be checked again here as the primary
+            // module, which can find more, so what was found now is always reported.
+            _addDiagnostics(moduleCache->diagnostics, fileName, fileDiagnostics);
+            _addDiagnostics(diagnostics, fileName, fileDiagnostics);
+            reportedDiagnosticFiles.add(fileName);
+        }
+    }
+    if (module)
+    {
+        modules[path] = module;
+
+        // The modules carried over from earlier versions are not checked again, so report what
+        // was reported when they were. A file shared by several documents is only reported for
+        // the first of them.
+        for (auto file : module->getFileDependencyList())
+        {
+            if (file->getSourceManager() != linkage->getSourceManager())
+                continue;
+            auto canonicalPath = _getCanonicalPath(file);
+            if (!reportedDiagnosticFiles.add(canonicalPath))
+                continue;
+            if (auto fileDiagnostics = moduleCache->diagnostics.tryGetValue(canonicalPath))
+                _addDiagnostics(diagnostics, canonicalPath, *fileDiagnostics);
+        }
     }
-    return static_cast<Module*>(parsedModule);
+    return module;
 }
 
 MacroDefinitionContentAssistInfo* WorkspaceVersion::tryGetMacroDefinition(UnownedStringSlice name)
@@ -135,17 +135,50 @@ enum class WorkspaceFlavor
     VFX,
 };
 
+// The modules checked by one linkage, carried over from one workspace version to the next so that
+// an edit only has the modules it affects parsed and checked again.
+class WorkspaceModuleCache : public RefObject
+{
+public:
+    RefPtr<Linkage> linkage;
+    WorkspaceFlavor flavor = WorkspaceFlavor::Standard;
+
+    // The search paths of `linkage`.
+    List<String> searchPaths;
+
+    // Diagnostics reported while checking the modules in `linkage`, by canonical file path.
+    Dictionary<String, DocumentDiagnostics> diagnostics;
+
+    // The number of modules removed from `linkage`. Their ASTs are still held by its AST builder,
+    // so a linkage that has removed many modules is replaced with a new one.
+    Index removedModuleCount = 0;
+
+    // Remove the modules that depend on a file whose contents differ from what `workspace` would
+    // load now, or on an `import` that failed.
+    void removeOutdatedModules(Workspace* workspace);
+
+    // Remove `modules` from `linkage`, along with the diagnostics and content assist information
+    // recorded for the files only they depend on. `modules` must include every module that
+    // imports one of them.
+    void removeModules(HashSet<Module*> const& modules);
+};
+
 class WorkspaceVersion : public RefObject
 {
 private:
-    Dictionary<String, Module*> modules;
+    Dictionary<String, RefPtr<Module>> modules;
     Dictionary<ModuleDecl*, RefPtr<ASTMarkup>> markupASTs;
     Dictionary<Name*, MacroDefinitionContentAssistInfo*> macroDefinitions;
-    void parseDiagnostics(String compilerOutput);
+    // The files whose diagnostics have been added to `diagnostics`.
+    HashSet<String> reportedDiagnosticFiles;
+    void parseDiagnostics(
+        String compilerOutput,
+        Dictionary<String, DocumentDiagnostics>& outDiagnostics);
 
 public:
     Workspace* workspace;
     WorkspaceFlavor flavor = WorkspaceFlavor::Standard;
+    RefPtr<WorkspaceModuleCache> moduleCache;
     RefPtr<Linkage> linkage;
     Dictionary<String, DocumentDiagnostics> diagnostics;
     ASTMarkup* getOrCreateMarkupAST(ModuleDecl* module);
@@ -159,12 +192,31 @@ struct OwnedPreprocessorMacroDefinition
     String name;
     String value;
 };
+// The open documents and settings of a workspace, copied so that another thread can check them
+// in a workspace of its own. See `Workspace::takeSnapshot` and `Workspace::applySnapshot`.
+struct WorkspaceSnapshot : public RefObject
+{
+    Dictionary<String, String> documents;
+    List<String> rootDirectories;
+    List<String> additionalSearchPaths;
+    OrderedHashSet<String> workspaceSearchPaths;
+    List<OwnedPreprocessorMacroDefinition> predefinedMacros;
+    bool searchInWorkspace = true;
+    WorkspaceFlavor workspaceFlavor = WorkspaceFlavor::Standard;
+    SlangLanguageVersion predefinedLanguageVersion = SLANG_LANGUAGE_VERSION_UNKNOWN;
+};
+
 class Workspace : public ComObject, public ISlangFileSystem
 {
 private:
     RefPtr<WorkspaceVersion> currentVersion;
     RefPtr<WorkspaceVersion> currentCompletionVersion;
-    RefPtr<WorkspaceVersion> createWorkspaceVersion();
+    RefPtr<WorkspaceModuleCache> moduleCache;
+    RefPtr<WorkspaceModuleCache> completionModuleCache;
+    RefPtr<WorkspaceVersion> createWorkspaceVersion(ContentAssistCheckingMode checkingMode);
+    RefPtr<Linkage> createLinkage(List<String> const& searchPaths);
+    List<String> getSearchPaths();
+    void invalidateModuleCaches();
 
 public:
     List<String> rootDirectories;
@@ -197,6 +249,13 @@ public:
 
     void init(List<URI> rootDirURI, slang::IGlobalSession* globalSession);
     void invalidate();
+
+    RefPtr<WorkspaceSnapshot> takeSnapshot();
+
+    // Make the documents and settings of this workspace match `snapshot`, keeping the checked
+    // modules that are still valid.
+    void applySnapshot(WorkspaceSnapshot const& snapshot);
+
     WorkspaceVersion* getCurrentVersion();
     WorkspaceVersion* getCurrentCompletionVersion() { return currentCompletionVersion.Ptr(); }
     WorkspaceVersion* createVersionForCompletion();
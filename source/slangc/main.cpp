@@ -1,10 +1,17 @@
 // main.cpp
 
+#include "compiler-core/slang-compile-server-protocol.h"
+#include "compiler-core/slang-json-rpc-connection.h"
 #include "core/slang-io.h"
+#include "core/slang-local-socket.h"
+#include "core/slang-platform.h"
+#include "core/slang-process.h"
 #include "core/slang-test-tool-util.h"
 #include "slang.h"
 #include "slang/slang-internal.h"
 
+#include <cstdlib>
+
 using namespace Slang;
 
 
@@ -66,16 +73,14 @@ static bool shouldEmbedPrelude(const char* const* argv, int argc)
     return false;
 }
 
-SLANG_TEST_TOOL_API SlangResult innerMain(
-    StdWriters* stdWriters,
+static SlangResult _createGlobalSession(
     slang::IGlobalSession* sharedSession,
     int argc,
-    const char* const* argv)
+    const char* const* argv,
+    ComPtr<slang::IGlobalSession>& outSession)
 {
-    StdWriters::setSingleton(stdWriters);
-
     // Assume we will used the shared session
-    ComPtr<slang::IGlobalSession> session(sharedSession);
+    outSession = sharedSession;
 
     // The sharedSession always has a pre-loaded core module, is sharedSession is not nullptr.
     // This differed test checks if the command line has an option to setup the core module.
@@ -84,9 +89,9 @@ SLANG_TEST_TOOL_API SlangResult innerMain(
     if (TestToolUtil::hasDeferredCoreModule(Index(argc - 1), argv + 1))
     {
         SLANG_RETURN_ON_FAIL(
-            slang_createGlobalSessionWithoutCoreModule(SLANG_API_VERSION, session.writeRef()));
+            slang_createGlobalSessionWithoutCoreModule(SLANG_API_VERSION, outSession.writeRef()));
     }
-    else if (!session)
+    else if (!outSession)
     {
         // Just create the global session in the regular way if there isn't one set
         SlangGlobalSessionDesc desc = {};
@@ -96,14 +101,33 @@ SLANG_TEST_TOOL_API SlangResult innerMain(
         internalDesc.isBootstrap = true;
 #endif
         SLANG_RETURN_ON_FAIL(
-            slang_createGlobalSessionImpl(&desc, &internalDesc, session.writeRef()));
+            slang_createGlobalSessionImpl(&desc, &internalDesc, outSession.writeRef()));
     }
+    return SLANG_OK;
+}
 
+static SlangResult _compileCommandLine(
+    slang::IGlobalSession* session,
+    int argc,
+    const char* const* argv,
+    bool captureStdOutput)
+{
     if (!shouldEmbedPrelude(argv, argc))
         TestToolUtil::setSessionDefaultPreludeFromExePath(argv[0], session);
 
     SlangCompileRequest* compileRequest = spCreateCompileRequest(session);
     compileRequest->addSearchPath(Path::getParentDirectory(Path::getExecutablePath()).getBuffer());
+
+    // Kernels written to the standard output have to reach whoever is collecting it, rather than
+    // the stdout of this process.
+    if (captureStdOutput)
+    {
+        spSetWriter(
+            compileRequest,
+            SLANG_WRITER_CHANNEL_STD_OUTPUT,
+            StdWriters::getSingleton()->getWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT));
+    }
+
     SlangResult res = _compile(compileRequest, argc, argv);
     // Now that we are done, clean up after ourselves
     spDestroyCompileRequest(compileRequest);
@@ -111,10 +135,298 @@ SLANG_TEST_TOOL_API SlangResult innerMain(
     return res;
 }
 
+SLANG_TEST_TOOL_API SlangResult innerMain(
+    StdWriters* stdWriters,
+    slang::IGlobalSession* sharedSession,
+    int argc,
+    const char* const* argv)
+{
+    StdWriters::setSingleton(stdWriters);
+
+    ComPtr<slang::IGlobalSession> session;
+    SLANG_RETURN_ON_FAIL(_createGlobalSession(sharedSession, argc, argv, session));
+
+    return _compileCommandLine(session, argc, argv, false);
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! Compile server !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+// `slangc -compile-server <socket>` keeps one global session alive and compiles the command lines
+// clients send it, so the core module is loaded, and downstream compilers are located and loaded,
+// once rather than for every compile. `slangc -use-compile-server <socket> <args>...` sends `args`
+// to the server, and compiles them itself if no server is listening.
+//
+// Each connection is served by a copy of the server process, forked once the connection is
+// accepted, so clients are compiled concurrently and a client that stalls only holds up its own
+// copy. Each command line gets its own compile request, and so its own linkage, and is compiled in
+// the client's working directory and environment, exactly as if it was run locally. The copy
+// starts from the server's global session, with the core module already loaded, but it locates
+// downstream compilers itself, and whatever it loads is gone when it exits. Where a process can't
+// be copied, connections are served one at a time by the server itself.
+
+static const UnownedStringSlice kCompileServerOption =
+    UnownedStringSlice::fromLiteral("-compile-server");
+static const UnownedStringSlice kUseCompileServerOption =
+    UnownedStringSlice::fromLiteral("-use-compile-server");
+
+// A client sends its command line as soon as it connects, so one that hasn't within this time
+// isn't going to.
+static const Int kCompileServerRequestTimeOutInMs = 30 * 1000;
+
+static SlangResult _initCompileServerConnection(Stream* stream, RefPtr<JSONRPCConnection>& out)
+{
+    RefPtr<BufferedReadStream> readStream(new BufferedReadStream(stream));
+    RefPtr<HTTPPacketConnection> packetConnection(new HTTPPacketConnection(readStream, stream));
+
+    out = new JSONRPCConnection;
+    return out->init(packetConnection);
+}
+
+/// Captures what a compile writes to a stdout or stderr, for the client to write to its own.
+class CaptureWriter : public StringWriter
+{
+public:
+    typedef StringWriter Parent;
+
+    SLANG_NO_THROW SlangResult SLANG_MCALL setMode(SlangWriterMode mode) SLANG_OVERRIDE
+    {
+        m_isBinary = m_isBinary || mode == SLANG_WRITER_MODE_BINARY;
+        return SLANG_OK;
+    }
+
+    bool isBinary() const { return m_isBinary; }
+
+    /// `isConsole` is if the client's writer is a console, which changes what a compile writes.
+    CaptureWriter(StringBuilder* builder, bool isConsole)
+        : Parent(builder, isConsole ? WriterFlags(WriterFlag::IsConsole) : WriterFlags(0))
+    {
+    }
+
+protected:
+    bool m_isBinary = false;
+};
+
+static SlangResult _serveCompileRequest(
+    JSONRPCConnection* connection,
+    StdWriters* serverStdWriters,
+    slang::IGlobalSession* sharedSession,
+    const char* exePath)
+{
+    SLANG_RETURN_ON_FAIL(connection->waitForResult(kCompileServerRequestTimeOutInMs));
+    if (!connection->hasMessage())
+    {
+        return SLANG_OK;
+    }
+
+    if (connection->getMessageType() != JSONRPCMessageType::Call)
+    {
+        return connection->sendError(
+            JSONRPC::ErrorCode::InvalidRequest,
+            connection->getCurrentMessageId());
+    }
+
+    JSONRPCCall call;
+    SLANG_RETURN_ON_FAIL(connection->getRPCOrSendError(&call));
+    auto id = connection->getPersistentValue(call.id);
+
+    if (call.method != CompileServerProtocol::CompileArgs::g_methodName)
+    {
+        return connection->sendError(JSONRPC::ErrorCode::MethodNotFound, id);
+    }
+
+    CompileServerProtocol::CompileArgs args;
+    SLANG_RETURN_ON_FAIL(connection->toNativeArgsOrSendError(call.params, &args, id));
+
+    // Relative paths on the command line are relative to where the client was run.
+    if (SLANG_FAILED(Path::setCurrentPath(args.currentPath)))
+    {
+        return connection->sendError(JSONRPC::ErrorCode::InvalidParams, id);
+    }
+
+    List<const char*> argv;
+    argv.add(exePath);
+    for (const auto& arg : args.args)
+    {
+        argv.add(arg.getBuffer());
+    }
+
+    // The server's own environment is put back once the compile is done.
+    List<String> serverEnvironment;
+    SLANG_RETURN_ON_FAIL(PlatformUtil::getEnvironment(serverEnvironment));
+    if (SLANG_FAILED(PlatformUtil::setEnvironment(args.environment)))
+    {
+        PlatformUtil::setEnvironment(serverEnvironment);
+        return connection->sendError(JSONRPC::ErrorCode::InvalidParams, id);
+    }
+
+    StringBuilder stdOut;
+    StringBuilder stdError;
+    RefPtr<CaptureWriter> stdOutWriter(new CaptureWriter(&stdOut, args.stdOutIsConsole));
+    RefPtr<CaptureWriter> stdErrorWriter(new CaptureWriter(&stdError, args.stdErrorIsConsole));
+
+    StdWriters stdWriters;
+    stdWriters.setWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT, stdOutWriter);
+    stdWriters.setWriter(SLANG_WRITER_CHANNEL_STD_ERROR, stdErrorWriter);
+    StdWriters::setSingleton(&stdWriters);
+
+    SlangResult res;
+    {
+        ComPtr<slang::IGlobalSession> session;
+        res = _createGlobalSession(sharedSession, int(argv.getCount()), argv.getBuffer(), session);
+        if (SLANG_SUCCEEDED(res))
+        {
+            res = _compileCommandLine(session, int(argv.getCount()), argv.getBuffer(), true);
+        }
+    }
+
+    StdWriters::setSingleton(serverStdWriters);
+    PlatformUtil::setEnvironment(serverEnvironment);
+
+    CompileServerProtocol::CompileResult result;
+    result.stdOut = CompileServerProtocol::encodeBase64(stdOut.getBuffer(), stdOut.getLength());
+    result.stdOutIsBinary = stdOutWriter->isBinary();
+    result.stdError = stdError;
+    result.result = res;
+    result.returnCode = int32_t(TestToolUtil::getReturnCode(res));
+    return connection->sendResult(&result, id);
+}
+
+static SlangResult _runCompileServer(
+    StdWriters* stdWriters,
+    const char* exePath,
+    const String& socketPath)
+{
+    RefPtr<LocalSocketListener> listener;
+    if (SLANG_FAILED(LocalSocket::listen(socketPath, listener)))
+    {
+        StdWriters::getError().print(
+            "error: unable to listen for compile requests at '%s'\n",
+            socketPath.getBuffer());
+        return SLANG_FAIL;
+    }
+
+    ComPtr<slang::IGlobalSession> session;
+    const char* const sessionArgv[] = {exePath};
+    SLANG_RETURN_ON_FAIL(_createGlobalSession(nullptr, 1, sessionArgv, session));
+
+    for (;;)
+    {
+        RefPtr<Stream> stream;
+        SLANG_RETURN_ON_FAIL(listener->accept(stream));
+
+        // The copy serves the connection and exits, leaving the server's copy of it to close.
+        bool isCopy = false;
+        const bool isForked = SLANG_SUCCEEDED(Process::forkDetached(isCopy));
+        if (isForked && !isCopy)
+        {
+            stream->close();
+            continue;
+        }
+
+        // A client that goes away, or sends something that isn't a request, only ends its own
+        // connection.
+        RefPtr<JSONRPCConnection> connection;
+        if (SLANG_SUCCEEDED(_initCompileServerConnection(stream, connection)))
+        {
+            _serveCompileRequest(connection, stdWriters, session, exePath);
+        }
+        stream->close();
+
+        // The listener and global session belong to the server, so the copy leaves without
+        // destroying them.
+        if (isCopy)
+        {
+            std::_Exit(0);
+        }
+    }
+}
+
+/// Compile the command line on the server connected to through `stream`, outputting the result
+/// and the decoded stdout of the compile. Fails if no result comes back, such as when the server
+/// exits part way through the compile, in which case nothing has been written.
+static SlangResult _compileOnServer(
+    Stream* stream,
+    int argc,
+    const char* const* argv,
+    CompileServerProtocol::CompileResult& outResult,
+    StringBuilder& outStdOut)
+{
+    RefPtr<JSONRPCConnection> connection;
+    SLANG_RETURN_ON_FAIL(_initCompileServerConnection(stream, connection));
+
+    auto stdWriters = StdWriters::getSingleton();
+
+    CompileServerProtocol::CompileArgs args;
+    args.currentPath = Path::getCurrentPath();
+    for (int i = 1; i < argc; ++i)
+    {
+        args.args.add(argv[i]);
+    }
+    SLANG_RETURN_ON_FAIL(PlatformUtil::getEnvironment(args.environment));
+    args.stdOutIsConsole = stdWriters->getWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT)->isConsole();
+    args.stdErrorIsConsole = stdWriters->getWriter(SLANG_WRITER_CHANNEL_STD_ERROR)->isConsole();
+
+    SLANG_RETURN_ON_FAIL(
+        connection->sendCall(CompileServerProtocol::CompileArgs::g_methodName, &args));
+    SLANG_RETURN_ON_FAIL(connection->waitForResult());
+    if (!connection->hasMessage() || connection->getMessageType() != JSONRPCMessageType::Result)
+    {
+        return SLANG_FAIL;
+    }
+
+    SLANG_RETURN_ON_FAIL(connection->getMessage(&outResult));
+    return CompileServerProtocol::decodeBase64(outResult.stdOut.getUnownedSlice(), outStdOut);
+}
+
 int MAIN(int argc, char** argv)
 {
     auto stdWriters = StdWriters::initDefaultSingleton();
-    SlangResult res = innerMain(stdWriters, nullptr, argc, argv);
+    SlangResult res;
+    if (argc == 3 && kCompileServerOption == argv[1])
+    {
+        res = _runCompileServer(stdWriters, argv[0], argv[2]);
+    }
+    else if (argc >= 3 && kUseCompileServerOption == argv[1])
+    {
+        // Drop the server option, leaving the command line as it would be run locally.
+        List<const char*> args;
+        args.add(argv[0]);
+        for (int i = 3; i < argc; ++i)
+        {
+            args.add(argv[i]);
+        }
+
+        RefPtr<Stream> stream;
+        CompileServerProtocol::CompileResult result;
+        StringBuilder stdOut;
+        if (SLANG_SUCCEEDED(LocalSocket::connect(argv[2], stream)) &&
+            SLANG_SUCCEEDED(_compileOnServer(
+                stream,
+                int(args.getCount()),
+                args.getBuffer(),
+                result,
+                stdOut)))
+        {
+            auto stdOutWriter = stdWriters->getWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT);
+            if (result.stdOutIsBinary)
+            {
+                stdOutWriter->setMode(SLANG_WRITER_MODE_BINARY);
+            }
+            stdOutWriter->write(stdOut.getBuffer(), stdOut.getLength());
+            StdWriters::getError().write(result.stdError.getBuffer(), result.stdError.getLength());
+            res = result.result;
+        }
+        else
+        {
+            // No server is listening, or it went away without replying, so compile locally. The
+            // server may have written some output files, which the local compile writes again.
+            res = innerMain(stdWriters, nullptr, int(args.getCount()), args.getBuffer());
+        }
+    }
+    else
+    {
+        res = innerMain(stdWriters, nullptr, argc, argv);
+    }
     slang::shutdown();
     return (int)TestToolUtil::getReturnCode(res);
 }
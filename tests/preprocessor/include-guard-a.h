@@ -0,0 +1,13 @@
+// include-guard-a.h
+
+// Used by the `include-guard.slang` and `include-guard-output.slang` tests
+
+#ifndef INCLUDE_GUARD_A
+#define INCLUDE_GUARD_A
+
+float guardedA(float x)
+{
+    return x;
+}
+
+#endif // INCLUDE_GUARD_A
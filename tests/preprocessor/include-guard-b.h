@@ -0,0 +1,10 @@
+// include-guard-b.h
+
+// Used by the `include-guard.slang` and `include-guard-output.slang` tests
+
+#ifndef INCLUDE_GUARD_B
+#define INCLUDE_GUARD_B
+
+#define GUARD_B_VALUE 1.0
+
+#endif
@@ -0,0 +1,9 @@
+// include-guard-c.h
+
+// Used by the `include-guard.slang` and `include-guard-output.slang` tests
+
+#ifndef INCLUDE_GUARD_C
+#define INCLUDE_GUARD_C
+#endif
+
+#define GUARD_C_VALUE 2.0
@@ -0,0 +1,16 @@
+// include-repeat.h
+
+// Used by the `include-repeat.slang` test. Has no include guard, an
+// identifier split by an escaped newline, and a number split by one, whose
+// token content can't be a slice of the file.
+
+#if 1\
+5 != 15
+#error "a number split by an escaped newline was not read back as 15"
+#endif
+
+float REPEAT_NAME(float x)
+{
+    return x * REPEAT_SC\
+ALE;
+}
@@ -39,6 +39,52 @@ SLANG_UNIT_TEST(builtinModuleCache)
     SLANG_CHECK(loadedModuleData == nullptr);
     SLANG_CHECK(loadedModuleSize == 0);
 
+    // A mapped cache yields the same payload, aligned for use in place. The mapping is scoped
+    // so it is released before the file is rewritten.
+    {
+        ComPtr<ISlangBlob> mappedModule;
+        SLANG_CHECK_ABORT(
+            SLANG_SUCCEEDED(BuiltinModuleCache::map(cachePath, libraryTimestamp, mappedModule)));
+        SLANG_CHECK(mappedModule->getBufferSize() == sizeof(moduleData));
+        SLANG_CHECK(memcmp(mappedModule->getBufferPointer(), moduleData, sizeof(moduleData)) == 0);
+        SLANG_CHECK((size_t(mappedModule->getBufferPointer()) & 7) == 0);
+
+        SLANG_CHECK(
+            SLANG_FAILED(BuiltinModuleCache::map(cachePath, libraryTimestamp + 1, mappedModule)));
+        SLANG_CHECK(!mappedModule);
+    }
+
+    // Writing the cache again replaces the file rather than changing it, so a process that has
+    // the old cache mapped keeps seeing the old payload. Windows doesn't allow replacing a
+    // mapped file, in which case the write fails and the old cache stays.
+    {
+        ComPtr<ISlangBlob> mappedModule;
+        SLANG_CHECK_ABORT(
+            SLANG_SUCCEEDED(BuiltinModuleCache::map(cachePath, libraryTimestamp, mappedModule)));
+
+        const uint8_t otherModuleData[] = {0x9a, 0xbc};
+        const SlangResult writeResult = BuiltinModuleCache::write(
+            cachePath,
+            libraryTimestamp,
+            otherModuleData,
+            sizeof(otherModuleData));
+        SLANG_CHECK(mappedModule->getBufferSize() == sizeof(moduleData));
+        SLANG_CHECK(memcmp(mappedModule->getBufferPointer(), moduleData, sizeof(moduleData)) == 0);
+
+        if (SLANG_SUCCEEDED(writeResult))
+        {
+            ComPtr<ISlangBlob> rewrittenModule;
+            SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+                BuiltinModuleCache::map(cachePath, libraryTimestamp, rewrittenModule)));
+            SLANG_CHECK(rewrittenModule->getBufferSize() == sizeof(otherModuleData));
+            SLANG_CHECK(
+                memcmp(
+                    rewrittenModule->getBufferPointer(),
+                    otherModuleData,
+                    sizeof(otherModuleData)) == 0);
+        }
+    }
+
     // Zero is the unavailable-timestamp sentinel, so it must never produce a cache.
     SLANG_CHECK(
         SLANG_FAILED(BuiltinModuleCache::write(cachePath, 0, moduleData, sizeof(moduleData))));
@@ -0,0 +1,237 @@
+// unit-test-compilation-cache.cpp
+
+#include "core/slang-file-system.h"
+#include "core/slang-io.h"
+#include "core/slang-process.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that `CompilerOptionName::CompilationCacheDirectory` makes `getEntryPointCode` store
+// generated code in an on-disk cache, and that a later session pointed at the same directory is
+// served from the cache instead of compiling. A hit reports the diagnostics of the compile that
+// made the entry, still gives metadata, and isn't used for a program linked with other options.
+
+namespace
+{
+
+static const char* kCacheTestSource = R"(
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void computeMain(uint tid : SV_DispatchThreadID, uniform RWStructuredBuffer<float> output)
+    {
+        output[tid] = tid * 2.0;
+    }
+    )";
+
+struct CachedProgram
+{
+    ComPtr<slang::ISession> session;
+    ComPtr<slang::IComponentType> linkedProgram;
+};
+
+static SlangResult _createCachedProgram(
+    slang::IGlobalSession* globalSession,
+    const String& cacheDirectory,
+    CachedProgram& outProgram,
+    const slang::CompilerOptionEntry* linkOptions = nullptr,
+    uint32_t linkOptionCount = 0)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::CompilerOptionEntry compilerOption = {};
+    compilerOption.name = slang::CompilerOptionName::CompilationCacheDirectory;
+    compilerOption.value.kind = slang::CompilerOptionValueKind::String;
+    compilerOption.value.stringValue0 = cacheDirectory.getBuffer();
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.compilerOptionEntries = &compilerOption;
+    sessionDesc.compilerOptionEntryCount = 1;
+
+    SLANG_RETURN_ON_FAIL(globalSession->createSession(sessionDesc, outProgram.session.writeRef()));
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = outProgram.session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        kCacheTestSource,
+        diagnosticBlob.writeRef());
+    if (!module)
+        return SLANG_FAIL;
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_RETURN_ON_FAIL(module->findEntryPointByName("computeMain", entryPoint.writeRef()));
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composite;
+    SLANG_RETURN_ON_FAIL(outProgram.session->createCompositeComponentType(
+        components,
+        2,
+        composite.writeRef(),
+        diagnosticBlob.writeRef()));
+
+    return composite->linkWithOptions(
+        outProgram.linkedProgram.writeRef(),
+        linkOptionCount,
+        linkOptions,
+        diagnosticBlob.writeRef());
+}
+
+static void _listDirectory(const String& directory, List<String>& outFileNames)
+{
+    OSFileSystem::getMutableSingleton()->enumeratePathContents(
+        directory.getBuffer(),
+        [](SlangPathType, const char* fileName, void* userData)
+        { static_cast<List<String>*>(userData)->add(fileName); },
+        &outFileNames);
+}
+
+/// Find the entry files of the cache, which are named by their keys.
+static void _findCacheEntries(const String& cacheDirectory, List<String>& outPaths)
+{
+    List<String> fileNames;
+    _listDirectory(cacheDirectory, fileNames);
+    for (const auto& fileName : fileNames)
+    {
+        if (fileName.getLength() == 40 && fileName.indexOf('.') < 0)
+            outPaths.add(cacheDirectory + "/" + fileName);
+    }
+}
+
+static bool _isSentinel(slang::IBlob* code, const char* sentinel)
+{
+    return code->getBufferSize() == strlen(sentinel) &&
+           memcmp(code->getBufferPointer(), sentinel, code->getBufferSize()) == 0;
+}
+
+static void _removeCacheDirectory(const String& cacheDirectory)
+{
+    auto fileSystem = OSFileSystem::getMutableSingleton();
+    List<String> fileNames;
+    _listDirectory(cacheDirectory, fileNames);
+    for (const auto& fileName : fileNames)
+        fileSystem->remove((cacheDirectory + "/" + fileName).getBuffer());
+    fileSystem->remove(cacheDirectory.getBuffer());
+}
+
+} // namespace
+
+SLANG_UNIT_TEST(compilationCache)
+{
+    String cacheDirectory = Path::simplify(
+        Path::getParentDirectory(Path::getExecutablePath()) + "/compilation-cache-test" +
+        String(Process::getId()));
+    _removeCacheDirectory(cacheDirectory);
+
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    // The first compile misses and populates the cache.
+    ComPtr<slang::IBlob> firstCode;
+    {
+        CachedProgram program;
+        SLANG_CHECK_ABORT(
+            SLANG_SUCCEEDED(_createCachedProgram(globalSession, cacheDirectory, program)));
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+            program.linkedProgram->getEntryPointCode(0, 0, firstCode.writeRef(), nullptr)));
+        SLANG_CHECK(firstCode->getBufferSize() != 0);
+    }
+
+    // The entry holds the diagnostics of the compile, preceded by their size, and then the code.
+    List<String> entryPaths;
+    _findCacheEntries(cacheDirectory, entryPaths);
+    SLANG_CHECK_ABORT(entryPaths.getCount() == 1);
+    {
+        List<uint8_t> entry;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::readAllBytes(entryPaths[0], entry)));
+
+        uint32_t diagnosticsSize = 0;
+        SLANG_CHECK_ABORT(entry.getCount() >= Index(sizeof(diagnosticsSize)));
+        memcpy(&diagnosticsSize, entry.getBuffer(), sizeof(diagnosticsSize));
+        const size_t codeOffset = sizeof(diagnosticsSize) + diagnosticsSize;
+        SLANG_CHECK_ABORT(size_t(entry.getCount()) >= codeOffset);
+        SLANG_CHECK(
+            size_t(entry.getCount()) - codeOffset == firstCode->getBufferSize() &&
+            memcmp(
+                entry.getBuffer() + codeOffset,
+                firstCode->getBufferPointer(),
+                firstCode->getBufferSize()) == 0);
+
+        // Replace the entry with a sentinel so a hit is distinguishable from a recompile.
+        const char diagnostics[] = "cached-warning";
+        const char sentinel[] = "cached-sentinel";
+        List<uint8_t> sentinelEntry;
+        diagnosticsSize = uint32_t(strlen(diagnostics));
+        sentinelEntry.addRange((const uint8_t*)&diagnosticsSize, sizeof(diagnosticsSize));
+        sentinelEntry.addRange((const uint8_t*)diagnostics, diagnosticsSize);
+        sentinelEntry.addRange((const uint8_t*)sentinel, Index(strlen(sentinel)));
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllBytes(
+            entryPaths[0],
+            sentinelEntry.getBuffer(),
+            size_t(sentinelEntry.getCount()))));
+    }
+
+    // A fresh session with identical inputs is served from the cache, and reports the
+    // diagnostics kept with the entry.
+    {
+        CachedProgram program;
+        SLANG_CHECK_ABORT(
+            SLANG_SUCCEEDED(_createCachedProgram(globalSession, cacheDirectory, program)));
+        ComPtr<slang::IBlob> code;
+        ComPtr<slang::IBlob> diagnostics;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(program.linkedProgram->getEntryPointCode(
+            0,
+            0,
+            code.writeRef(),
+            diagnostics.writeRef())));
+        SLANG_CHECK(_isSentinel(code, "cached-sentinel"));
+        SLANG_CHECK(
+            diagnostics && UnownedStringSlice(
+                               (const char*)diagnostics->getBufferPointer(),
+                               diagnostics->getBufferSize())
+                               .indexOf(toSlice("cached-warning")) >= 0);
+
+        // The entry has no metadata, so asking for it compiles the entry point, and the code
+        // already handed out stays the same.
+        ComPtr<slang::IMetadata> metadata;
+        SLANG_CHECK(SLANG_SUCCEEDED(
+            program.linkedProgram->getEntryPointMetadata(0, 0, metadata.writeRef(), nullptr)));
+        SLANG_CHECK(metadata != nullptr);
+
+        ComPtr<slang::IBlob> codeAfterMetadata;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(program.linkedProgram->getEntryPointCode(
+            0,
+            0,
+            codeAfterMetadata.writeRef(),
+            nullptr)));
+        SLANG_CHECK(_isSentinel(codeAfterMetadata, "cached-sentinel"));
+    }
+
+    // Options given to `linkWithOptions` are part of the key, so a program linked with other
+    // options isn't served the same entry.
+    {
+        slang::CompilerOptionEntry linkOption = {};
+        linkOption.name = slang::CompilerOptionName::Optimization;
+        linkOption.value.kind = slang::CompilerOptionValueKind::Int;
+        linkOption.value.intValue0 = SLANG_OPTIMIZATION_LEVEL_MAXIMAL;
+
+        CachedProgram program;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+            _createCachedProgram(globalSession, cacheDirectory, program, &linkOption, 1)));
+        ComPtr<slang::IBlob> code;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+            program.linkedProgram->getEntryPointCode(0, 0, code.writeRef(), nullptr)));
+        SLANG_CHECK(!_isSentinel(code, "cached-sentinel"));
+
+        entryPaths.clear();
+        _findCacheEntries(cacheDirectory, entryPaths);
+        SLANG_CHECK(entryPaths.getCount() == 2);
+    }
+
+    _removeCacheDirectory(cacheDirectory);
+}
@@ -0,0 +1,225 @@
+// unit-test-compile-server.cpp
+
+#include "core/slang-io.h"
+#include "core/slang-local-socket.h"
+#include "core/slang-platform.h"
+#include "core/slang-process-util.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <thread>
+
+using namespace Slang;
+
+// Test `slangc -use-compile-server` end to end: a command line compiled on a `slangc
+// -compile-server` process writes the same binary output as a local compile, isn't held up by
+// another client that stalls, is compiled in the client's environment, and is compiled locally
+// when the server goes away before replying.
+
+namespace
+{
+
+static const char kCompileServerSource[] = R"(
+    RWStructuredBuffer<int> outputBuffer;
+
+    [numthreads(4, 1, 1)]
+    void main(uint3 tid : SV_DispatchThreadID)
+    {
+        outputBuffer[tid.x] = int(tid.x) * 3;
+    }
+    )";
+
+static bool _contains(const String& text, const char* expected)
+{
+    return text.getUnownedSlice().indexOf(UnownedStringSlice(expected)) >= 0;
+}
+
+static void _initSlangc(UnitTestContext* context, CommandLine& outCmdLine)
+{
+    ExecutableLocation slangcLocation(context->executableDirectory, "slangc");
+    outCmdLine.setExecutableLocation(slangcLocation);
+}
+
+/// Run slangc on `sourcePath` for `target`, through the server at `socketPath` if it isn't empty.
+static SlangResult _runSlangc(
+    UnitTestContext* context,
+    const String& socketPath,
+    const String& sourcePath,
+    const char* target,
+    ExecuteResult& outResult)
+{
+    CommandLine cmdLine;
+    _initSlangc(context, cmdLine);
+    if (socketPath.getLength())
+    {
+        cmdLine.addArg("-use-compile-server");
+        cmdLine.addArg(socketPath);
+    }
+    cmdLine.addArg(sourcePath);
+    cmdLine.addArg("-target");
+    cmdLine.addArg(target);
+    cmdLine.addArg("-entry");
+    cmdLine.addArg("main");
+    cmdLine.addArg("-stage");
+    cmdLine.addArg("compute");
+    return ProcessUtil::execute(cmdLine, outResult);
+}
+
+/// Get a path for a socket that nothing is listening at.
+static SlangResult _getSocketPath(String& outPath)
+{
+    SLANG_RETURN_ON_FAIL(File::generateTemporary(toSlice("slang-compile-server"), outPath));
+    File::remove(outPath);
+    return SLANG_OK;
+}
+
+/// Set the environment variable `name` of this process, and so of the processes it starts, to
+/// `value`, or remove it if `value` is null.
+static SlangResult _setEnvironmentVariable(const char* name, const char* value)
+{
+    List<String> environment;
+    SLANG_RETURN_ON_FAIL(PlatformUtil::getEnvironment(environment));
+
+    const String prefix = String(name) + "=";
+    List<String> newEnvironment;
+    for (const auto& entry : environment)
+    {
+        if (!entry.startsWith(prefix))
+            newEnvironment.add(entry);
+    }
+    if (value)
+        newEnvironment.add(prefix + value);
+    return PlatformUtil::setEnvironment(newEnvironment);
+}
+
+} // namespace
+
+SLANG_UNIT_TEST(compileServer)
+{
+    // Compile servers listen on local sockets, which aren't available everywhere.
+    {
+        String probePath;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_getSocketPath(probePath)));
+        RefPtr<LocalSocketListener> probe;
+        if (SLANG_FAILED(LocalSocket::listen(probePath, probe)))
+        {
+            SLANG_IGNORE_TEST;
+        }
+    }
+
+    String tempPath;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(File::generateTemporary(toSlice("slang-compile-server"), tempPath)));
+    const String sourcePath = tempPath + ".slang";
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(sourcePath, kCompileServerSource)));
+
+    // The kernel as a local compile writes it, which through a pipe is the raw SPIR-V.
+    ExecuteResult localResult;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        _runSlangc(unitTestContext, String(), sourcePath, "spirv", localResult)));
+    SLANG_CHECK_ABORT(localResult.resultCode == 0);
+    SLANG_CHECK_ABORT(localResult.standardOutput.getLength() > 4);
+
+    String socketPath;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_getSocketPath(socketPath)));
+
+    CommandLine serverCmdLine;
+    _initSlangc(unitTestContext, serverCmdLine);
+    serverCmdLine.addArg("-compile-server");
+    serverCmdLine.addArg(socketPath);
+    RefPtr<Process> server;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(Process::create(serverCmdLine, 0, server)));
+
+    // Wait for the server to start listening.
+    bool isListening = false;
+    for (int i = 0; i < 600 && !isListening && !server->isTerminated(); ++i)
+    {
+        RefPtr<Stream> stream;
+        isListening = SLANG_SUCCEEDED(LocalSocket::connect(socketPath, stream));
+        if (isListening)
+            stream->close();
+        else
+            Process::sleepCurrentThread(100);
+    }
+    SLANG_CHECK(isListening);
+
+    if (isListening)
+    {
+        // A client that connects and never sends its command line doesn't hold up the others.
+        // Served one at a time, the compile below would wait behind it forever.
+        RefPtr<Stream> stalledStream;
+        SLANG_CHECK(SLANG_SUCCEEDED(LocalSocket::connect(socketPath, stalledStream)));
+
+        // Binary output comes back byte for byte.
+        ExecuteResult serverResult;
+        SLANG_CHECK(SLANG_SUCCEEDED(
+            _runSlangc(unitTestContext, socketPath, sourcePath, "spirv", serverResult)));
+        SLANG_CHECK(serverResult.resultCode == 0);
+        SLANG_CHECK(serverResult.standardOutput == localResult.standardOutput);
+
+        if (stalledStream)
+            stalledStream->close();
+
+        // The server compiles in the client's environment, which it didn't start with, and doesn't
+        // keep it for the next client.
+        const char* const variableName = "SLANG_USE_SPV_SOURCE_LANGUAGE_UNKNOWN";
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_setEnvironmentVariable(variableName, "1")));
+        ExecuteResult unknownResult;
+        const SlangResult unknownRes =
+            _runSlangc(unitTestContext, socketPath, sourcePath, "spirv-asm", unknownResult);
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_setEnvironmentVariable(variableName, nullptr)));
+        SLANG_CHECK(SLANG_SUCCEEDED(unknownRes));
+        SLANG_CHECK(_contains(unknownResult.standardOutput, "OpSource Unknown"));
+
+        ExecuteResult slangResult;
+        SLANG_CHECK(SLANG_SUCCEEDED(
+            _runSlangc(unitTestContext, socketPath, sourcePath, "spirv-asm", slangResult)));
+        SLANG_CHECK(_contains(slangResult.standardOutput, "OpSource Slang"));
+    }
+
+    server->kill(0);
+    server->waitForTermination();
+    File::remove(socketPath);
+
+    // A server that goes away after reading the command line, without replying.
+    {
+        String crashingSocketPath;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_getSocketPath(crashingSocketPath)));
+        RefPtr<LocalSocketListener> listener;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(LocalSocket::listen(crashingSocketPath, listener)));
+
+        std::thread crashingServer(
+            [&]()
+            {
+                RefPtr<Stream> stream;
+                if (SLANG_FAILED(listener->accept(stream)))
+                    return;
+
+                // Reads don't block, so poll until some of the request has arrived.
+                char buffer[256];
+                for (int i = 0; i < 600; ++i)
+                {
+                    size_t readCount = 0;
+                    if (SLANG_FAILED(stream->read(buffer, sizeof(buffer), readCount)) ||
+                        readCount != 0)
+                        break;
+                    Process::sleepCurrentThread(100);
+                }
+                stream->close();
+            });
+
+        ExecuteResult fallbackResult;
+        SLANG_CHECK(SLANG_SUCCEEDED(_runSlangc(
+            unitTestContext,
+            crashingSocketPath,
+            sourcePath,
+            "spirv",
+            fallbackResult)));
+        crashingServer.join();
+
+        SLANG_CHECK(fallbackResult.resultCode == 0);
+        SLANG_CHECK(fallbackResult.standardOutput == localResult.standardOutput);
+    }
+
+    File::remove(sourcePath);
+    File::remove(tempPath);
+}
@@ -0,0 +1,207 @@
+// unit-test-cpu-parallel-dispatch.cpp
+
+#include "core/slang-list.h"
+#include "core/slang-shared-library.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <stdint.h>
+#include <string.h>
+
+using namespace Slang;
+
+// Test that `_slang_rt_dispatch_compute` in `slang-rt` runs every group of a dispatch exactly
+// once when it splits the dispatch across threads, and that the exported function of a CPU
+// compute entry point gives the same results when it is called on parts of a dispatch from
+// several threads at once. The kernel keeps intermediate values in a global, which must not be
+// shared between the threads.
+
+namespace
+{
+
+// The CPU representation of a `RWStructuredBuffer`, as declared in `prelude/slang-cpp-types.h`.
+struct CpuStructuredBufferView
+{
+    void* data = nullptr;
+    size_t count = 0;
+};
+
+typedef void (*CpuComputeFunc)(void* varyingInput, void* entryPointParams, void* globalParams);
+
+typedef void(SLANG_MCALL* DispatchComputeFunc)(
+    CpuComputeFunc computeFunc,
+    const uint32_t* startGroupID,
+    const uint32_t* endGroupID,
+    void* entryPointParams,
+    void* globalParams);
+
+static const char* const kParallelDispatchSource = R"(
+    static const uint kWidth = 128;
+    static const uint kHeight = 10;
+
+    RWStructuredBuffer<uint> outputBuffer;
+    static uint gScratch;
+
+    uint mix(uint x)
+    {
+        gScratch = x * 2654435761u;
+        for (uint i = 0; i < 64; i++)
+            gScratch = (gScratch ^ (gScratch >> 13)) * 1103515245u + i;
+        return gScratch;
+    }
+
+    [shader("compute")]
+    [numthreads(4, 2, 1)]
+    void computeMain(uint3 tid : SV_DispatchThreadID)
+    {
+        uint index = (tid.z * kHeight + tid.y) * kWidth + tid.x;
+        outputBuffer[index] = mix(index) | 1;
+    }
+    )";
+
+static const uint32_t kGroupSize[3] = {4, 2, 1};
+static const uint32_t kGroupCount[3] = {32, 5, 2};
+static const uint32_t kWidth = kGroupSize[0] * kGroupCount[0];
+static const uint32_t kHeight = kGroupSize[1] * kGroupCount[1];
+static const uint32_t kDepth = kGroupSize[2] * kGroupCount[2];
+
+static uint32_t _mix(uint32_t x)
+{
+    uint32_t scratch = x * 2654435761u;
+    for (uint32_t i = 0; i < 64; i++)
+        scratch = (scratch ^ (scratch >> 13)) * 1103515245u + i;
+    return scratch;
+}
+
+// Check that the groups from `start` up to `end` wrote their values, and nothing else was
+// written.
+static bool _checkOutput(const List<uint32_t>& output, const uint32_t* start, const uint32_t* end)
+{
+    for (uint32_t z = 0; z < kDepth; ++z)
+    {
+        for (uint32_t y = 0; y < kHeight; ++y)
+        {
+            for (uint32_t x = 0; x < kWidth; ++x)
+            {
+                const uint32_t groupID[3] = {
+                    x / kGroupSize[0],
+                    y / kGroupSize[1],
+                    z / kGroupSize[2]};
+                bool isInRange = true;
+                for (int i = 0; i < 3; ++i)
+                    isInRange = isInRange && groupID[i] >= start[i] && groupID[i] < end[i];
+
+                const uint32_t index = (z * kHeight + y) * kWidth + x;
+                const uint32_t expected = isInRange ? (_mix(index) | 1) : 0;
+                if (output[index] != expected)
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+SLANG_UNIT_TEST(cpuParallelDispatch)
+{
+    ComPtr<ISlangSharedLibrary> runtimeLibrary;
+    if (SLANG_FAILED(DefaultSharedLibraryLoader::getSingleton()->loadSharedLibrary(
+            "slang-rt",
+            runtimeLibrary.writeRef())))
+    {
+        SLANG_IGNORE_TEST;
+    }
+    auto dispatchCompute =
+        (DispatchComputeFunc)runtimeLibrary->findFuncByName("_slang_rt_dispatch_compute");
+    SLANG_CHECK_ABORT(dispatchCompute != nullptr);
+
+    auto globalSession = unitTestContext->slangGlobalSession;
+    const SlangPassThrough hostCompilers[] = {
+        SLANG_PASS_THROUGH_LLVM,
+        SLANG_PASS_THROUGH_VISUAL_STUDIO,
+        SLANG_PASS_THROUGH_GCC,
+        SLANG_PASS_THROUGH_CLANG,
+    };
+    bool hasHostCompiler = false;
+    for (auto compiler : hostCompilers)
+        hasHostCompiler = hasHostCompiler ||
+                          SLANG_SUCCEEDED(globalSession->checkPassThroughSupport(compiler));
+    if (!hasHostCompiler)
+    {
+        SLANG_IGNORE_TEST;
+    }
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_SHADER_HOST_CALLABLE;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    ComPtr<slang::IBlob> diagnostics;
+    ComPtr<slang::IModule> module(session->loadModuleFromSourceString(
+        "cpuParallelDispatch",
+        "cpuParallelDispatch.slang",
+        kParallelDispatchSource,
+        diagnostics.writeRef()));
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(module->findEntryPointByName("computeMain", entryPoint.writeRef())));
+
+    slang::IComponentType* components[] = {module, entryPoint};
+    ComPtr<slang::IComponentType> program;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(session->createCompositeComponentType(
+        components,
+        SLANG_COUNT_OF(components),
+        program.writeRef(),
+        diagnostics.writeRef())));
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(program->link(linkedProgram.writeRef(), diagnostics.writeRef())));
+
+    ComPtr<ISlangSharedLibrary> kernelLibrary;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(linkedProgram->getEntryPointHostCallable(
+        0,
+        0,
+        kernelLibrary.writeRef(),
+        diagnostics.writeRef())));
+
+    auto computeFunc = (CpuComputeFunc)kernelLibrary->findFuncByName("computeMain");
+    SLANG_CHECK_ABORT(computeFunc != nullptr);
+
+    List<uint32_t> output;
+    output.setCount(kWidth * kHeight * kDepth);
+
+    CpuStructuredBufferView outputView;
+    outputView.data = output.getBuffer();
+    outputView.count = size_t(output.getCount());
+
+    // The whole grid, then a part of it that doesn't start at the origin.
+    const uint32_t ranges[][2][3] = {
+        {{0, 0, 0}, {kGroupCount[0], kGroupCount[1], kGroupCount[2]}},
+        {{3, 1, 1}, {20, 4, 2}},
+    };
+    for (const auto& range : ranges)
+    {
+        memset(output.getBuffer(), 0, output.getCount() * sizeof(uint32_t));
+        dispatchCompute(computeFunc, range[0], range[1], nullptr, &outputView);
+        SLANG_CHECK(_checkOutput(output, range[0], range[1]));
+    }
+
+    // An empty range runs nothing.
+    const uint32_t emptyStart[3] = {4, 0, 0};
+    const uint32_t emptyEnd[3] = {4, kGroupCount[1], kGroupCount[2]};
+    memset(output.getBuffer(), 0, output.getCount() * sizeof(uint32_t));
+    dispatchCompute(computeFunc, emptyStart, emptyEnd, nullptr, &outputView);
+    SLANG_CHECK(_checkOutput(output, emptyStart, emptyEnd));
+}
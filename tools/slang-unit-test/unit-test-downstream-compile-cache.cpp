@@ -0,0 +1,286 @@
+// unit-test-downstream-compile-cache.cpp
+
+#include "compiler-core/slang-artifact-representation-impl.h"
+#include "compiler-core/slang-artifact-util.h"
+#include "compiler-core/slang-downstream-compile-cache.h"
+#include "compiler-core/slang-slice-allocator.h"
+#include "core/slang-blob.h"
+#include "core/slang-file-system.h"
+#include "core/slang-io.h"
+#include "core/slang-process.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that the key `DownstreamCompileCacheUtil` makes for a command line compile changes with the
+// compiler, the options, the source and the headers it includes, that no key is made when the
+// included headers can't be known, and that an entry gives back the product and compiler output it
+// was written with.
+
+namespace
+{
+
+static const char* kCompileCacheSource = "#include \"compile-cache-test.h\"\n"
+                                         "#include <stdint.h>\n"
+                                         "int main() { return kValue; }\n";
+
+static ComPtr<IArtifact> _createSource(const char* text)
+{
+    auto artifact = ArtifactUtil::createArtifact(
+        ArtifactDesc::make(ArtifactKind::Source, ArtifactPayload::Cpp));
+    artifact->addRepresentationUnknown(StringBlob::create(UnownedStringSlice(text)));
+    return artifact;
+}
+
+static void _removeDirectory(const String& directory)
+{
+    auto fileSystem = OSFileSystem::getMutableSingleton();
+    List<String> fileNames;
+    fileSystem->enumeratePathContents(
+        directory.getBuffer(),
+        [](SlangPathType, const char* fileName, void* userData)
+        { static_cast<List<String>*>(userData)->add(fileName); },
+        &fileNames);
+    for (const auto& fileName : fileNames)
+        fileSystem->remove((directory + "/" + fileName).getBuffer());
+    fileSystem->remove(directory.getBuffer());
+}
+
+} // namespace
+
+SLANG_UNIT_TEST(downstreamCompileCache)
+{
+    typedef DownstreamCompileCacheUtil::Key Key;
+
+    String directory = Path::simplify(
+        Path::getParentDirectory(Path::getExecutablePath()) + "/downstream-compile-cache-test" +
+        String(Process::getId()));
+    _removeDirectory(directory);
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(Path::createDirectory(directory)));
+
+    const String headerPath = Path::combine(directory, "compile-cache-test.h");
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(headerPath, "const int kValue = 1;\n")));
+
+    DownstreamCompilerDesc desc(SLANG_PASS_THROUGH_GCC, SemanticVersion(11, 4, 0));
+    CommandLine cmdLine;
+    cmdLine.setExecutableLocation(ExecutableLocation(ExecutableLocation::Type::Name, "g++"));
+
+    ComPtr<IArtifact> source = _createSource(kCompileCacheSource);
+    IArtifact* sourceArtifacts[] = {source};
+    TerminatedCharSlice includePaths[] = {SliceUtil::asTerminatedCharSlice(directory)};
+
+    DownstreamCompileOptions options;
+    options.targetType = SLANG_SHADER_SHARED_LIBRARY;
+    options.sourceArtifacts = makeSlice(sourceArtifacts, 1);
+    options.includePaths = makeSlice(includePaths, 1);
+
+    SLANG_CHECK(DownstreamCompileCacheUtil::canCache(options));
+
+    Key key;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(DownstreamCompileCacheUtil::calcKey(desc, cmdLine, options, key)));
+
+    // The same compile has the same key.
+    {
+        Key sameKey;
+        DownstreamCompileCacheUtil::calcKey(desc, cmdLine, options, sameKey);
+        SLANG_CHECK(sameKey == key);
+    }
+
+    // A different compiler version
+    {
+        DownstreamCompilerDesc otherDesc(SLANG_PASS_THROUGH_GCC, SemanticVersion(12, 1, 0));
+        Key otherKey;
+        DownstreamCompileCacheUtil::calcKey(otherDesc, cmdLine, options, otherKey);
+        SLANG_CHECK(otherKey != key);
+    }
+
+    // A different option
+    {
+        DownstreamCompileOptions otherOptions = options;
+        otherOptions.optimizationLevel = DownstreamCompileOptions::OptimizationLevel::Maximal;
+        Key otherKey;
+        DownstreamCompileCacheUtil::calcKey(desc, cmdLine, otherOptions, otherKey);
+        SLANG_CHECK(otherKey != key);
+    }
+
+    // Different source
+    {
+        ComPtr<IArtifact> otherSource = _createSource("int main() { return 0; }\n");
+        IArtifact* otherSourceArtifacts[] = {otherSource};
+        DownstreamCompileOptions otherOptions = options;
+        otherOptions.sourceArtifacts = makeSlice(otherSourceArtifacts, 1);
+        Key otherKey;
+        DownstreamCompileCacheUtil::calcKey(desc, cmdLine, otherOptions, otherKey);
+        SLANG_CHECK(otherKey != key);
+    }
+
+    // A change to an included header
+    {
+        File::writeAllText(headerPath, "const int kValue = 2;\n");
+        Key otherKey;
+        DownstreamCompileCacheUtil::calcKey(desc, cmdLine, options, otherKey);
+        SLANG_CHECK(otherKey != key);
+    }
+
+    // The headers a prelude includes, which name its precompiled header, are found the same way.
+    {
+        const auto prelude = toSlice("#include \"compile-cache-test.h\"\n");
+        DigestBuilder<SHA1> builder;
+        SLANG_CHECK(SLANG_SUCCEEDED(DownstreamCompileCacheUtil::appendIncludes(
+            builder,
+            prelude,
+            String(),
+            cmdLine,
+            options)));
+        const Key includesKey = builder.finalize();
+
+        File::writeAllText(headerPath, "const int kValue = 3;\n");
+        DigestBuilder<SHA1> otherBuilder;
+        SLANG_CHECK(SLANG_SUCCEEDED(DownstreamCompileCacheUtil::appendIncludes(
+            otherBuilder,
+            prelude,
+            String(),
+            cmdLine,
+            options)));
+        SLANG_CHECK(otherBuilder.finalize() != includesKey);
+
+        // A quoted header that isn't found, such as `"TargetConditionals.h"`, is taken to be a
+        // system header, and only its name is part of the key.
+        DigestBuilder<SHA1> systemBuilder;
+        SLANG_CHECK(SLANG_SUCCEEDED(DownstreamCompileCacheUtil::appendIncludes(
+            systemBuilder,
+            toSlice("#include \"TargetConditionals.h\"\n"),
+            String(),
+            cmdLine,
+            options)));
+        DigestBuilder<SHA1> missingBuilder;
+        SLANG_CHECK(SLANG_SUCCEEDED(DownstreamCompileCacheUtil::appendIncludes(
+            missingBuilder,
+            toSlice("#include \"compile-cache-missing.h\"\n"),
+            String(),
+            cmdLine,
+            options)));
+        SLANG_CHECK(missingBuilder.finalize() != systemBuilder.finalize());
+    }
+
+    // A quoted header next to the source file, which isn't on the include paths, is found. A source
+    // that is only in memory has no directory for it to be found in, so it is keyed by name only.
+    const String sourceDirectory = directory + "-source";
+    _removeDirectory(sourceDirectory);
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(Path::createDirectory(sourceDirectory)));
+    {
+        const char* const localSource = "#include \"compile-cache-local.h\"\n"
+                                        "int f() { return kLocal; }\n";
+        const String localHeaderPath = Path::combine(sourceDirectory, "compile-cache-local.h");
+        const String localSourcePath = Path::combine(sourceDirectory, "compile-cache-local.cpp");
+        SLANG_CHECK_ABORT(
+            SLANG_SUCCEEDED(File::writeAllText(localHeaderPath, "const int kLocal = 1;\n")));
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(localSourcePath, localSource)));
+
+        ComPtr<IArtifact> fileSource = _createSource(localSource);
+        fileSource->addRepresentation(OSFileArtifactRepresentation::create(
+            IOSFileArtifactRepresentation::Kind::Reference,
+            localSourcePath.getUnownedSlice(),
+            nullptr));
+        IArtifact* fileSourceArtifacts[] = {fileSource};
+        DownstreamCompileOptions fileOptions = options;
+        fileOptions.sourceArtifacts = makeSlice(fileSourceArtifacts, 1);
+
+        Key localKey;
+        SLANG_CHECK(SLANG_SUCCEEDED(
+            DownstreamCompileCacheUtil::calcKey(desc, cmdLine, fileOptions, localKey)));
+        File::writeAllText(localHeaderPath, "const int kLocal = 2;\n");
+        Key otherKey;
+        SLANG_CHECK(SLANG_SUCCEEDED(
+            DownstreamCompileCacheUtil::calcKey(desc, cmdLine, fileOptions, otherKey)));
+        SLANG_CHECK(otherKey != localKey);
+
+        ComPtr<IArtifact> memorySource = _createSource(localSource);
+        IArtifact* memorySourceArtifacts[] = {memorySource};
+        DownstreamCompileOptions memoryOptions = options;
+        memoryOptions.sourceArtifacts = makeSlice(memorySourceArtifacts, 1);
+        Key memoryKey;
+        SLANG_CHECK(SLANG_SUCCEEDED(
+            DownstreamCompileCacheUtil::calcKey(desc, cmdLine, memoryOptions, memoryKey)));
+        File::writeAllText(localHeaderPath, "const int kLocal = 3;\n");
+        SLANG_CHECK(SLANG_SUCCEEDED(
+            DownstreamCompileCacheUtil::calcKey(desc, cmdLine, memoryOptions, otherKey)));
+        SLANG_CHECK(otherKey == memoryKey);
+    }
+    _removeDirectory(sourceDirectory);
+
+    // An `#include` of a macro can only be used when nothing defines the macro.
+    {
+        ComPtr<IArtifact> macroSource = _createSource("#ifdef USER_CONFIG\n"
+                                                      "#include USER_CONFIG\n"
+                                                      "#endif\n"
+                                                      "int main() { return 0; }\n");
+        IArtifact* macroSourceArtifacts[] = {macroSource};
+        DownstreamCompileOptions macroOptions = options;
+        macroOptions.sourceArtifacts = makeSlice(macroSourceArtifacts, 1);
+        Key macroKey;
+        SLANG_CHECK(SLANG_SUCCEEDED(
+            DownstreamCompileCacheUtil::calcKey(desc, cmdLine, macroOptions, macroKey)));
+
+        DownstreamCompileOptions::Define define;
+        define.nameWithSig = TerminatedCharSlice("USER_CONFIG");
+        define.value = TerminatedCharSlice("\"user-config.h\"");
+        macroOptions.defines = makeSlice(&define, 1);
+        SLANG_CHECK(SLANG_FAILED(
+            DownstreamCompileCacheUtil::calcKey(desc, cmdLine, macroOptions, macroKey)));
+
+        ComPtr<IArtifact> definingSource = _createSource("#define USER_CONFIG \"user-config.h\"\n"
+                                                         "#include USER_CONFIG\n");
+        IArtifact* definingSourceArtifacts[] = {definingSource};
+        DownstreamCompileOptions definingOptions = options;
+        definingOptions.sourceArtifacts = makeSlice(definingSourceArtifacts, 1);
+        SLANG_CHECK(SLANG_FAILED(
+            DownstreamCompileCacheUtil::calcKey(desc, cmdLine, definingOptions, macroKey)));
+    }
+
+    // Products written to a given path, and executables, are not cached.
+    {
+        DownstreamCompileOptions otherOptions = options;
+        otherOptions.modulePath = SliceUtil::asTerminatedCharSlice(headerPath);
+        SLANG_CHECK(!DownstreamCompileCacheUtil::canCache(otherOptions));
+
+        otherOptions = options;
+        otherOptions.targetType = SLANG_HOST_EXECUTABLE;
+        SLANG_CHECK(!DownstreamCompileCacheUtil::canCache(otherOptions));
+    }
+
+    // An entry gives back what was written.
+    {
+        PersistentCache::Desc cacheDesc;
+        cacheDesc.directory = directory.getBuffer();
+        RefPtr<PersistentCache> cache = new PersistentCache(cacheDesc);
+
+        ExecuteResult exeRes;
+        exeRes.init();
+        exeRes.standardError = "a.cpp:1:1: warning: unused variable\n";
+
+        const char productData[] = "\x7f"
+                                   "ELF product";
+        ComPtr<ISlangBlob> product = RawBlob::create(productData, sizeof(productData));
+
+        ExecuteResult readExeRes;
+        ComPtr<ISlangBlob> readProduct;
+        SLANG_CHECK(SLANG_FAILED(
+            DownstreamCompileCacheUtil::readEntry(cache, key, readExeRes, readProduct)));
+
+        SLANG_CHECK_ABORT(
+            SLANG_SUCCEEDED(DownstreamCompileCacheUtil::writeEntry(cache, key, exeRes, product)));
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+            DownstreamCompileCacheUtil::readEntry(cache, key, readExeRes, readProduct)));
+
+        SLANG_CHECK(readExeRes.resultCode == 0);
+        SLANG_CHECK(readExeRes.standardOutput.getLength() == 0);
+        SLANG_CHECK(readExeRes.standardError == exeRes.standardError);
+        SLANG_CHECK(
+            readProduct->getBufferSize() == sizeof(productData) &&
+            memcmp(readProduct->getBufferPointer(), productData, sizeof(productData)) == 0);
+    }
+
+    _removeDirectory(directory);
+}
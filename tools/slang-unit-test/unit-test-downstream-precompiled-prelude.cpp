@@ -0,0 +1,345 @@
+// unit-test-downstream-precompiled-prelude.cpp
+
+#include "compiler-core/slang-precompiled-prelude-util.h"
+#include "core/slang-file-system.h"
+#include "core/slang-io.h"
+#include "core/slang-list.h"
+#include "core/slang-process.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <stdint.h>
+
+using namespace Slang;
+
+// Test that with `CompilerOptionName::DownstreamPrecompiledHeaderDirectory` set, gcc and clang
+// compile host callable code against a precompiled header for the C++ prelude, that the code
+// still runs correctly, that compiles of different kernels with the same arguments share one
+// precompiled header, and that a compile taken from the compile cache doesn't make one. Also test
+// that a bounded precompiled header directory keeps the most recently used headers.
+
+namespace
+{
+
+// The CPU representation of a `RWStructuredBuffer`, as declared in `prelude/slang-cpp-types.h`.
+struct CpuStructuredBufferView
+{
+    void* data = nullptr;
+    size_t count = 0;
+};
+
+// `ComputeVaryingInput` as declared in `prelude/slang-cpp-types.h`.
+struct CpuComputeVaryingInput
+{
+    uint32_t startGroupID[3];
+    uint32_t endGroupID[3];
+};
+
+typedef void (*CpuComputeFunc)(void* varyingInput, void* entryPointParams, void* globalParams);
+
+static const char* const kPrecompiledPreludeSources[] = {
+    R"(
+    RWStructuredBuffer<uint> outputBuffer;
+
+    [shader("compute")]
+    [numthreads(8, 1, 1)]
+    void computeMain(uint3 tid : SV_DispatchThreadID)
+    {
+        outputBuffer[tid.x] = tid.x * 3 + 1;
+    }
+    )",
+    R"(
+    RWStructuredBuffer<uint> outputBuffer;
+
+    [shader("compute")]
+    [numthreads(8, 1, 1)]
+    void computeMain(uint3 tid : SV_DispatchThreadID)
+    {
+        outputBuffer[tid.x] = tid.x * 3 + 1 + (tid.x & 1);
+    }
+    )",
+};
+
+static void _listDirectory(const String& directory, List<String>& outFileNames)
+{
+    OSFileSystem::getMutableSingleton()->enumeratePathContents(
+        directory.getBuffer(),
+        [](SlangPathType, const char* fileName, void* userData)
+        { static_cast<List<String>*>(userData)->add(fileName); },
+        &outFileNames);
+}
+
+static void _removeDirectory(const String& directory)
+{
+    List<String> fileNames;
+    _listDirectory(directory, fileNames);
+    auto fileSystem = OSFileSystem::getMutableSingleton();
+    for (const auto& fileName : fileNames)
+        fileSystem->remove((directory + "/" + fileName).getBuffer());
+    fileSystem->remove(directory.getBuffer());
+}
+
+/// Compile and run `source`, with its precompiled header in `directory`, and with the compile
+/// cache in `cacheDirectory` if it isn't empty.
+static SlangResult _runKernel(
+    slang::IGlobalSession* globalSession,
+    const String& directory,
+    const String& cacheDirectory,
+    const char* source,
+    List<uint32_t>& outOutput)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_SHADER_HOST_CALLABLE;
+
+    slang::CompilerOptionEntry compilerOptions[2] = {};
+    compilerOptions[0].name = slang::CompilerOptionName::DownstreamPrecompiledHeaderDirectory;
+    compilerOptions[0].value.kind = slang::CompilerOptionValueKind::String;
+    compilerOptions[0].value.stringValue0 = directory.getBuffer();
+    compilerOptions[1].name = slang::CompilerOptionName::CompilationCacheDirectory;
+    compilerOptions[1].value.kind = slang::CompilerOptionValueKind::String;
+    compilerOptions[1].value.stringValue0 = cacheDirectory.getBuffer();
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.compilerOptionEntries = compilerOptions;
+    sessionDesc.compilerOptionEntryCount = cacheDirectory.getLength() ? 2 : 1;
+
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(globalSession->createSession(sessionDesc, session.writeRef()));
+
+    ComPtr<slang::IBlob> diagnostics;
+    ComPtr<slang::IModule> module(session->loadModuleFromSourceString(
+        "precompiledPrelude",
+        "precompiledPrelude.slang",
+        source,
+        diagnostics.writeRef()));
+    if (!module)
+        return SLANG_FAIL;
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_RETURN_ON_FAIL(module->findEntryPointByName("computeMain", entryPoint.writeRef()));
+
+    slang::IComponentType* components[] = {module, entryPoint};
+    ComPtr<slang::IComponentType> program;
+    SLANG_RETURN_ON_FAIL(session->createCompositeComponentType(
+        components,
+        SLANG_COUNT_OF(components),
+        program.writeRef(),
+        diagnostics.writeRef()));
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    SLANG_RETURN_ON_FAIL(program->link(linkedProgram.writeRef(), diagnostics.writeRef()));
+
+    ComPtr<ISlangSharedLibrary> kernelLibrary;
+    SLANG_RETURN_ON_FAIL(linkedProgram->getEntryPointHostCallable(
+        0,
+        0,
+        kernelLibrary.writeRef(),
+        diagnostics.writeRef()));
+
+    auto computeFunc = (CpuComputeFunc)kernelLibrary->findFuncByName("computeMain");
+    if (!computeFunc)
+        return SLANG_FAIL;
+
+    outOutput.setCount(16);
+    for (auto& value : outOutput)
+        value = 0;
+
+    CpuStructuredBufferView outputView;
+    outputView.data = outOutput.getBuffer();
+    outputView.count = size_t(outOutput.getCount());
+
+    CpuComputeVaryingInput varyingInput = {{0, 0, 0}, {2, 1, 1}};
+    computeFunc(&varyingInput, nullptr, &outputView);
+    return SLANG_OK;
+}
+
+} // namespace
+
+SLANG_UNIT_TEST(downstreamPrecompiledPrelude)
+{
+    // Only gcc and clang are used with a precompiled prelude, so they are pinned for host
+    // callable code on a private global session.
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    const SlangPassThrough cppCompilers[] = {
+        SLANG_PASS_THROUGH_GCC,
+        SLANG_PASS_THROUGH_CLANG,
+    };
+    SlangPassThrough cppCompiler = SLANG_PASS_THROUGH_NONE;
+    for (auto candidate : cppCompilers)
+    {
+        if (SLANG_SUCCEEDED(globalSession->checkPassThroughSupport(candidate)))
+        {
+            cppCompiler = candidate;
+            break;
+        }
+    }
+    if (cppCompiler == SLANG_PASS_THROUGH_NONE)
+    {
+        SLANG_IGNORE_TEST;
+    }
+    globalSession->setDefaultDownstreamCompiler(SLANG_SOURCE_LANGUAGE_CPP, cppCompiler);
+    globalSession->setDownstreamCompilerForTransition(
+        SLANG_CPP_SOURCE,
+        SLANG_SHADER_HOST_CALLABLE,
+        cppCompiler);
+
+    String directory = Path::simplify(
+        Path::getParentDirectory(Path::getExecutablePath()) + "/precompiled-prelude-test" +
+        String(Process::getId()));
+    _removeDirectory(directory);
+
+    for (Index i = 0; i < SLANG_COUNT_OF(kPrecompiledPreludeSources); ++i)
+    {
+        List<uint32_t> output;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_runKernel(
+            globalSession,
+            directory,
+            String(),
+            kPrecompiledPreludeSources[i],
+            output)));
+
+        for (uint32_t x = 0; x < 16; ++x)
+        {
+            const uint32_t expected = x * 3 + 1 + ((i == 1) ? (x & 1) : 0);
+            SLANG_CHECK(output[x] == expected);
+        }
+    }
+
+    // Both kernels were compiled against the same precompiled header, and nothing but the lock file
+    // is left in the directory.
+    List<String> fileNames;
+    _listDirectory(directory, fileNames);
+    Index headerCount = 0;
+    Index precompiledHeaderCount = 0;
+    for (const auto& fileName : fileNames)
+    {
+        if (fileName.endsWith(".h"))
+            ++headerCount;
+        else if (fileName.endsWith(".h.gch") || fileName.endsWith(".h.pch"))
+            ++precompiledHeaderCount;
+    }
+    SLANG_CHECK(headerCount == 1);
+    SLANG_CHECK(precompiledHeaderCount == 1);
+    SLANG_CHECK(fileNames.getCount() == 3);
+
+    _removeDirectory(directory);
+
+    // A compile that is in the compile cache is taken from it without making the precompiled
+    // header again.
+    const String cacheDirectory = directory + "-cache";
+    _removeDirectory(cacheDirectory);
+    for (int run = 0; run < 2; ++run)
+    {
+        List<uint32_t> output;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_runKernel(
+            globalSession,
+            directory,
+            cacheDirectory,
+            kPrecompiledPreludeSources[0],
+            output)));
+        for (uint32_t x = 0; x < 16; ++x)
+            SLANG_CHECK(output[x] == x * 3 + 1);
+
+        fileNames.clear();
+        _listDirectory(directory, fileNames);
+        if (run == 0)
+        {
+            SLANG_CHECK(fileNames.getCount() == 3);
+            _removeDirectory(directory);
+        }
+        else
+        {
+            SLANG_CHECK(fileNames.getCount() == 0);
+        }
+    }
+
+    _removeDirectory(directory);
+    _removeDirectory(cacheDirectory);
+}
+
+SLANG_UNIT_TEST(downstreamPrecompiledPreludeTrim)
+{
+    String directory = Path::simplify(
+        Path::getParentDirectory(Path::getExecutablePath()) + "/precompiled-prelude-trim-test" +
+        String(Process::getId()));
+    _removeDirectory(directory);
+    SLANG_CHECK_ABORT(Path::createDirectory(directory));
+
+    String headerNames[4];
+    for (int i = 0; i < 4; ++i)
+        headerNames[i] = PrecompiledPreludeUtil::getHeaderName(SHA1::compute(&i, sizeof(i)));
+    auto addEntry = [&](int i)
+    {
+        File::writeAllText(Path::combine(directory, headerNames[i]), "// prelude\n");
+        File::writeAllText(Path::combine(directory, headerNames[i] + ".gch"), "pch");
+    };
+    auto hasEntry = [&](int i)
+    {
+        return File::exists(Path::combine(directory, headerNames[i])) &&
+               File::exists(Path::combine(directory, headerNames[i] + ".gch"));
+    };
+    auto hasNoFilesOf = [&](int i)
+    {
+        List<String> fileNames;
+        _listDirectory(directory, fileNames);
+        for (const auto& fileName : fileNames)
+        {
+            if (fileName.startsWith(headerNames[i]))
+                return false;
+        }
+        return true;
+    };
+
+    // Headers 0, 1 and 2 are used in turn, and then 0 again, so 1 is the least recently used.
+    for (int i = 0; i < 3; ++i)
+    {
+        addEntry(i);
+        SLANG_CHECK(
+            SLANG_SUCCEEDED(PrecompiledPreludeUtil::trimDirectory(directory, headerNames[i], 3)));
+    }
+    SLANG_CHECK(
+        SLANG_SUCCEEDED(PrecompiledPreludeUtil::trimDirectory(directory, headerNames[0], 3)));
+    SLANG_CHECK(hasEntry(0) && hasEntry(1) && hasEntry(2));
+
+    // A fourth header pushes out header 1, along with a directory of files made from it.
+    const String subDirectory = Path::combine(directory, headerNames[1] + ".pch-dir");
+    SLANG_CHECK(Path::createDirectory(subDirectory));
+    File::writeAllText(Path::combine(subDirectory, "nvrtc.pch"), "pch");
+    addEntry(3);
+    SLANG_CHECK(
+        SLANG_SUCCEEDED(PrecompiledPreludeUtil::trimDirectory(directory, headerNames[3], 3)));
+    SLANG_CHECK(hasNoFilesOf(1));
+    SLANG_CHECK(hasEntry(0) && hasEntry(2) && hasEntry(3));
+
+    // Files are only removed when no other compile holds the directory.
+    DownstreamCompileOptions options;
+    options.precompiledHeaderDirectory = TerminatedCharSlice(directory.getBuffer());
+    options.precompiledHeaderMaxEntryCount = 1;
+    {
+        PrecompiledPreludeLock firstLock;
+        PrecompiledPreludeLock secondLock;
+        SLANG_CHECK(SLANG_SUCCEEDED(firstLock.lock(options)));
+        SLANG_CHECK(SLANG_SUCCEEDED(secondLock.lock(options)));
+
+        firstLock.setHeaderName(headerNames[2]);
+        firstLock.unlock();
+        SLANG_CHECK(hasEntry(0) && hasEntry(2) && hasEntry(3));
+
+        secondLock.setHeaderName(headerNames[0]);
+        secondLock.unlock();
+        SLANG_CHECK(hasEntry(0));
+        SLANG_CHECK(hasNoFilesOf(2) && hasNoFilesOf(3));
+    }
+
+    List<String> fileNames;
+    _listDirectory(directory, fileNames);
+    for (const auto& fileName : fileNames)
+        Path::removeNonEmpty(Path::combine(directory, fileName));
+    Path::remove(directory);
+}
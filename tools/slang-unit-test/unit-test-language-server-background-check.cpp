@@ -0,0 +1,159 @@
+// unit-test-language-server-background-check.cpp
+
+#include "compiler-core/slang-json-rpc-connection.h"
+#include "compiler-core/slang-language-server-protocol.h"
+#include "core/slang-http.h"
+#include "core/slang-io.h"
+#include "core/slang-process.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that `slangd` with periodic diagnostic updates on, which checks documents on a background
+// thread, publishes the diagnostics of an opened document and publishes them again after an edit,
+// while still answering requests.
+
+namespace
+{
+
+static const char kBackgroundCheckSource[] = "int f()\n"
+                                             "{\n"
+                                             "    return missingValue;\n"
+                                             "}\n";
+
+static SlangResult _startLanguageServer(
+    UnitTestContext* context,
+    RefPtr<JSONRPCConnection>& outConnection)
+{
+    CommandLine cmdLine;
+    cmdLine.setExecutableLocation(ExecutableLocation(context->executableDirectory, "slangd"));
+    RefPtr<Process> process;
+    SLANG_RETURN_ON_FAIL(Process::create(cmdLine, 0, process));
+
+    RefPtr<BufferedReadStream> readStream(
+        new BufferedReadStream(process->getStream(StdStreamType::Out)));
+    RefPtr<HTTPPacketConnection> connection =
+        new HTTPPacketConnection(readStream, process->getStream(StdStreamType::In));
+    outConnection = new JSONRPCConnection();
+    return outConnection->init(connection, JSONRPCConnection::CallStyle::Object, process);
+}
+
+/// Read messages until the response to the call with `id` arrives, collecting the diagnostics
+/// published for `uri` on the way. A negative `id` waits for diagnostics instead, and stops at the
+/// first set published for `uri`.
+static SlangResult _waitFor(
+    JSONRPCConnection* connection,
+    int id,
+    const String& uri,
+    List<LanguageServerProtocol::Diagnostic>& outDiagnostics)
+{
+    // The timeout only bounds a failing run.
+    for (int i = 0; i < 600; ++i)
+    {
+        SLANG_RETURN_ON_FAIL(connection->waitForResult(100));
+        if (!connection->hasMessage())
+            continue;
+
+        const auto messageType = connection->getMessageType();
+        if (messageType == JSONRPCMessageType::Call)
+        {
+            JSONRPCCall call;
+            SLANG_RETURN_ON_FAIL(connection->getRPC(&call));
+            if (call.method != "textDocument/publishDiagnostics")
+                continue;
+            LanguageServerProtocol::PublishDiagnosticsParams params;
+            SLANG_RETURN_ON_FAIL(connection->getMessage(&params));
+            if (params.uri != uri)
+                continue;
+            outDiagnostics = params.diagnostics;
+            if (id < 0)
+                return SLANG_OK;
+        }
+        else if (id >= 0 && messageType == JSONRPCMessageType::Result)
+        {
+            JSONResultResponse response;
+            SLANG_RETURN_ON_FAIL(connection->getRPC(&response));
+            if (connection->getContainer()->asInteger(response.id) == id)
+                return SLANG_OK;
+        }
+    }
+    return SLANG_E_TIME_OUT;
+}
+
+} // namespace
+
+SLANG_UNIT_TEST(languageServerBackgroundCheck)
+{
+    String tempPath;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(File::generateTemporary(toSlice("slang-background-check"), tempPath)));
+    const String sourcePath = tempPath + ".slang";
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(sourcePath, kBackgroundCheckSource)));
+    String canonicalPath;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(Path::getCanonical(sourcePath, canonicalPath)));
+    const String uri = URI::fromLocalFilePath(canonicalPath.getUnownedSlice()).uri;
+
+    RefPtr<JSONRPCConnection> connection;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_startLanguageServer(unitTestContext, connection)));
+
+    List<LanguageServerProtocol::Diagnostic> diagnostics;
+
+    LanguageServerProtocol::InitializeParams initParams;
+    LanguageServerProtocol::WorkspaceFolder workspaceFolder;
+    workspaceFolder.name = "test";
+    workspaceFolder.uri =
+        URI::fromLocalFilePath(Path::getParentDirectory(canonicalPath).getUnownedSlice()).uri;
+    initParams.workspaceFolders.add(workspaceFolder);
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(connection->sendCall(
+        LanguageServerProtocol::InitializeParams::methodName,
+        &initParams,
+        JSONValue::makeInt(0))));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_waitFor(connection, 0, uri, diagnostics)));
+
+    LanguageServerProtocol::DidOpenTextDocumentParams openParams;
+    openParams.textDocument.uri = uri;
+    openParams.textDocument.text = kBackgroundCheckSource;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(connection->sendCall(
+        LanguageServerProtocol::DidOpenTextDocumentParams::methodName,
+        &openParams)));
+
+    // Requests are answered by the server thread, whether or not the check has finished.
+    LanguageServerProtocol::HoverParams hoverParams;
+    hoverParams.textDocument.uri = uri;
+    hoverParams.position.line = 0;
+    hoverParams.position.character = 4;
+    SLANG_CHECK(SLANG_SUCCEEDED(connection->sendCall(
+        LanguageServerProtocol::HoverParams::methodName,
+        &hoverParams,
+        JSONValue::makeInt(1))));
+    SLANG_CHECK(SLANG_SUCCEEDED(_waitFor(connection, 1, uri, diagnostics)));
+
+    // The undefined identifier is reported, unless it already was while waiting for the hover.
+    if (diagnostics.getCount() == 0)
+        SLANG_CHECK(SLANG_SUCCEEDED(_waitFor(connection, -1, uri, diagnostics)));
+    SLANG_CHECK(diagnostics.getCount() != 0);
+
+    // Replace `missingValue` with `0`, which leaves nothing to report.
+    LanguageServerProtocol::DidChangeTextDocumentParams changeParams;
+    changeParams.textDocument.uri = uri;
+    changeParams.textDocument.version = 1;
+    LanguageServerProtocol::TextDocumentContentChangeEvent change;
+    change.range.start.line = 2;
+    change.range.start.character = 11;
+    change.range.end.line = 2;
+    change.range.end.character = 23;
+    change.text = "0";
+    changeParams.contentChanges.add(change);
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(connection->sendCall(
+        LanguageServerProtocol::DidChangeTextDocumentParams::methodName,
+        &changeParams)));
+
+    diagnostics.clear();
+    diagnostics.add(LanguageServerProtocol::Diagnostic());
+    SLANG_CHECK(SLANG_SUCCEEDED(_waitFor(connection, -1, uri, diagnostics)));
+    SLANG_CHECK(diagnostics.getCount() == 0);
+
+    connection->disconnect();
+    File::remove(sourcePath);
+    File::remove(tempPath);
+}
@@ -0,0 +1,282 @@
+// unit-test-lazy-ir-deserialization.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "slang/slang-compiler-api.h"
+#include "slang/slang-ir.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that a precompiled module loaded with `CompilerOptionName::LazyIRDeserialization`
+// links to the same code as one loaded eagerly, when the program pulls in functions,
+// generics and witness tables from it, and that it can still be serialized again. Also test
+// that linking only reads in the bodies the program references.
+
+namespace
+{
+
+static const char* kLibrarySource = R"(
+    module lazyLib;
+
+    public interface IScale
+    {
+        float scale(float x);
+    }
+
+    public struct Doubler : IScale
+    {
+        public float scale(float x) { return x * 2.0; }
+    }
+
+    public struct Halver : IScale
+    {
+        public float scale(float x) { return x * 0.5; }
+    }
+
+    public float applyScale<T : IScale>(T s, float x)
+    {
+        return s.scale(x) + 1.0;
+    }
+
+    public float used(float x)
+    {
+        return applyScale(Doubler(), x) + unusedHelper(x) * 0.0;
+    }
+
+    float unusedHelper(float x)
+    {
+        float sum = 0;
+        for (int i = 0; i < 8; i++)
+            sum += x * i;
+        return sum;
+    }
+
+    public float unused(float x)
+    {
+        return applyScale(Halver(), x) * unusedHelper(x);
+    }
+    )";
+
+static const char* kProgramSource = R"(
+    import lazyLib;
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void computeMain(uint tid : SV_DispatchThreadID, uniform RWStructuredBuffer<float> output)
+    {
+        output[tid] = used(output[tid]);
+    }
+    )";
+
+static const char* kLeafLibrarySource = R"(
+    module lazyLeaf;
+
+    public float used(float x)
+    {
+        return x + 1.0;
+    }
+
+    public float unused(float x)
+    {
+        return x * 3.0;
+    }
+    )";
+
+static const char* kLeafProgramSource = R"(
+    import lazyLeaf;
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void computeMain(uint tid : SV_DispatchThreadID, uniform RWStructuredBuffer<float> output)
+    {
+        output[tid] = used(output[tid]);
+    }
+    )";
+
+static SlangResult _createSession(
+    slang::IGlobalSession* globalSession,
+    bool deserializeLazily,
+    ComPtr<slang::ISession>& outSession)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::CompilerOptionEntry compilerOption = {};
+    compilerOption.name = slang::CompilerOptionName::LazyIRDeserialization;
+    compilerOption.value.kind = slang::CompilerOptionValueKind::Int;
+    compilerOption.value.intValue0 = deserializeLazily ? 1 : 0;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.compilerOptionEntries = &compilerOption;
+    sessionDesc.compilerOptionEntryCount = 1;
+
+    return globalSession->createSession(sessionDesc, outSession.writeRef());
+}
+
+static SlangResult _serializeLibrary(
+    slang::IGlobalSession* globalSession,
+    const char* name,
+    const char* source,
+    ComPtr<ISlangBlob>& outLibraryBlob)
+{
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(_createSession(globalSession, false, session));
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto module = session->loadModuleFromSourceString(
+        name,
+        (String(name) + ".slang").getBuffer(),
+        source,
+        diagnostics.writeRef());
+    if (!module)
+        return SLANG_FAIL;
+    return module->serialize(outLibraryBlob.writeRef());
+}
+
+// Load the serialized library into a fresh session, compile the program against it and
+// return the generated code, along with the library serialized again from that session.
+static SlangResult _compileAgainstLibrary(
+    slang::IGlobalSession* globalSession,
+    ISlangBlob* libraryBlob,
+    bool deserializeLazily,
+    ComPtr<slang::IBlob>& outCode,
+    ComPtr<ISlangBlob>& outReserializedLibrary)
+{
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(_createSession(globalSession, deserializeLazily, session));
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto library = session->loadModuleFromIRBlob(
+        "lazyLib",
+        "lazyLib.slang-module",
+        libraryBlob,
+        diagnostics.writeRef());
+    if (!library)
+        return SLANG_FAIL;
+
+    auto module = session->loadModuleFromSourceString(
+        "lazyProgram",
+        "lazyProgram.slang",
+        kProgramSource,
+        diagnostics.writeRef());
+    if (!module)
+        return SLANG_FAIL;
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_RETURN_ON_FAIL(module->findEntryPointByName("computeMain", entryPoint.writeRef()));
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composite;
+    SLANG_RETURN_ON_FAIL(session->createCompositeComponentType(
+        components,
+        2,
+        composite.writeRef(),
+        diagnostics.writeRef()));
+    ComPtr<slang::IComponentType> linkedProgram;
+    SLANG_RETURN_ON_FAIL(composite->link(linkedProgram.writeRef(), diagnostics.writeRef()));
+    SLANG_RETURN_ON_FAIL(
+        linkedProgram->getEntryPointCode(0, 0, outCode.writeRef(), diagnostics.writeRef()));
+
+    // Serializing reads in whatever the link did not need.
+    return library->serialize(outReserializedLibrary.writeRef());
+}
+
+static bool _isSameCode(slang::IBlob* a, slang::IBlob* b)
+{
+    return a && b && a->getBufferSize() == b->getBufferSize() &&
+           memcmp(a->getBufferPointer(), b->getBufferPointer(), a->getBufferSize()) == 0;
+}
+
+} // namespace
+
+SLANG_UNIT_TEST(lazyIRDeserialization)
+{
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    ComPtr<ISlangBlob> libraryBlob;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        _serializeLibrary(globalSession, "lazyLib", kLibrarySource, libraryBlob)));
+
+    ComPtr<slang::IBlob> eagerCode;
+    ComPtr<ISlangBlob> eagerLibrary;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        _compileAgainstLibrary(globalSession, libraryBlob, false, eagerCode, eagerLibrary)));
+
+    ComPtr<slang::IBlob> lazyCode;
+    ComPtr<ISlangBlob> lazyLibrary;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        _compileAgainstLibrary(globalSession, libraryBlob, true, lazyCode, lazyLibrary)));
+    SLANG_CHECK(_isSameCode(eagerCode, lazyCode));
+
+    // A library serialized back out of a lazily loaded module holds the bodies that were
+    // never linked, so it compiles to the same code again.
+    ComPtr<slang::IBlob> reloadedCode;
+    ComPtr<ISlangBlob> reloadedLibrary;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        _compileAgainstLibrary(globalSession, lazyLibrary, false, reloadedCode, reloadedLibrary)));
+    SLANG_CHECK(_isSameCode(eagerCode, reloadedCode));
+}
+
+SLANG_UNIT_TEST(lazyIRDeserializationSkipsUnreferencedBodies)
+{
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    ComPtr<ISlangBlob> libraryBlob;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        _serializeLibrary(globalSession, "lazyLeaf", kLeafLibrarySource, libraryBlob)));
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_createSession(globalSession, true, session)));
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto library = session->loadModuleFromIRBlob(
+        "lazyLeaf",
+        "lazyLeaf.slang-module",
+        libraryBlob,
+        diagnostics.writeRef());
+    SLANG_CHECK_ABORT(library != nullptr);
+
+    auto lazyLoader = asInternal(library)->getIRModule()->getLazyLoader();
+    SLANG_CHECK_ABORT(lazyLoader != nullptr);
+
+    // Nothing has asked for the bodies of `used` or `unused` yet.
+    const Index deferredCount = lazyLoader->getUnmaterializedCount();
+    SLANG_CHECK_ABORT(deferredCount >= 2);
+
+    auto module = session->loadModuleFromSourceString(
+        "lazyLeafProgram",
+        "lazyLeafProgram.slang",
+        kLeafProgramSource,
+        diagnostics.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(module->findEntryPointByName("computeMain", entryPoint.writeRef())));
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composite;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(session->createCompositeComponentType(
+        components,
+        2,
+        composite.writeRef(),
+        diagnostics.writeRef())));
+    ComPtr<slang::IComponentType> linkedProgram;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(composite->link(linkedProgram.writeRef(), diagnostics.writeRef())));
+    ComPtr<slang::IBlob> code;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        linkedProgram->getEntryPointCode(0, 0, code.writeRef(), diagnostics.writeRef())));
+
+    // Linking read in the body of `used` only, so `unused` is still left in the table.
+    SLANG_CHECK(lazyLoader->getUnmaterializedCount() == deferredCount - 1);
+
+    // Serializing the library again reads in everything that is left.
+    ComPtr<ISlangBlob> reserializedLibrary;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(library->serialize(reserializedLibrary.writeRef())));
+    SLANG_CHECK(lazyLoader->getUnmaterializedCount() == 0);
+}
@@ -0,0 +1,126 @@
+// unit-test-lexer-scan.cpp
+
+#include "compiler-core/slang-diagnostic-sink.h"
+#include "compiler-core/slang-lexer.h"
+#include "compiler-core/slang-name.h"
+#include "compiler-core/slang-source-loc.h"
+#include "core/slang-memory-arena.h"
+#include "platform/performance-counter.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that the lexer's bulk scanning of comments, horizontal space and identifiers finds the
+// same tokens as stepping through them one code point at a time would, including where a token
+// has escaped newlines or UTF-8 in it, or runs across several 16-byte blocks. Then time lexing
+// a larger source made of the same text.
+
+namespace
+{
+
+struct ExpectedToken
+{
+    TokenType type;
+    const char* content;
+};
+
+static const char kLexerScanSource[] =
+    "// line comment that runs well past sixteen bytes, caf\xC3\xA9 \\ backslash\n"
+    "// continued \\\n still the same comment\n"
+    "/* block ** comment\n   spanning lines, with *stars* and\ttabs */\n"
+    "    \t\t            \t    aVeryLongIdentifierName_0123456789_thatCrossesSeveralBlocks"
+    "      \\\n      split\\\nIdentifier na\xC3\xAFve_identifier_with_unicode\n";
+
+static const ExpectedToken kLexerScanTokens[] = {
+    {TokenType::LineComment,
+     "// line comment that runs well past sixteen bytes, caf\xC3\xA9 \\ backslash"},
+    {TokenType::NewLine, "\n"},
+    {TokenType::LineComment, "// continued  still the same comment"},
+    {TokenType::NewLine, "\n"},
+    {TokenType::BlockComment, "/* block ** comment\n   spanning lines, with *stars* and\ttabs */"},
+    {TokenType::NewLine, "\n"},
+    {TokenType::WhiteSpace, "    \t\t            \t    "},
+    {TokenType::Identifier, "aVeryLongIdentifierName_0123456789_thatCrossesSeveralBlocks"},
+    {TokenType::WhiteSpace, "            "},
+    {TokenType::Identifier, "splitIdentifier"},
+    {TokenType::WhiteSpace, " "},
+    {TokenType::Identifier, "na\xC3\xAFve_identifier_with_unicode"},
+    {TokenType::NewLine, "\n"},
+    {TokenType::LineComment, "// tail"},
+};
+
+struct LexerScanContext
+{
+    LexerScanContext() { memoryArena.init(1 << 16); }
+
+    SourceView* createSourceView(const String& text)
+    {
+        auto sourceFile = sourceManager.createSourceFileWithString(PathInfo::makeUnknown(), text);
+        return sourceManager.createSourceView(sourceFile, nullptr, SourceLoc());
+    }
+
+    SourceManager sourceManager;
+    NamePool namePool;
+    MemoryArena memoryArena;
+};
+
+} // namespace
+
+SLANG_UNIT_TEST(lexerScan)
+{
+    LexerScanContext context;
+    context.sourceManager.initialize(nullptr, nullptr);
+    DiagnosticSink sink(&context.sourceManager, nullptr);
+
+    // The same text with the last comment running into the end of the input, which is too close
+    // to scan a whole block of.
+    const String text = String(kLexerScanSource) + "// tail";
+
+    {
+        Lexer lexer;
+        lexer.initialize(
+            context.createSourceView(text),
+            &sink,
+            &context.namePool,
+            &context.memoryArena);
+
+        Index tokenCount = 0;
+        for (;;)
+        {
+            Token token = lexer.lexToken();
+            if (token.type == TokenType::EndOfFile)
+                break;
+            SLANG_CHECK_ABORT(tokenCount < SLANG_COUNT_OF(kLexerScanTokens));
+            const auto& expected = kLexerScanTokens[tokenCount++];
+            SLANG_CHECK(token.type == expected.type);
+            SLANG_CHECK(token.getContent() == UnownedStringSlice(expected.content));
+        }
+        SLANG_CHECK(tokenCount == SLANG_COUNT_OF(kLexerScanTokens));
+        SLANG_CHECK(sink.getErrorCount() == 0);
+    }
+
+    // Lex many copies of the text, as a stand-in for a large generated source.
+    const Index kRepeatCount = 4096;
+    StringBuilder largeText;
+    for (Index i = 0; i < kRepeatCount; ++i)
+        largeText << kLexerScanSource;
+
+    {
+        Lexer lexer;
+        lexer.initialize(
+            context.createSourceView(largeText.produceString()),
+            &sink,
+            &context.namePool,
+            &context.memoryArena);
+
+        auto start = platform::PerformanceCounter::now();
+        Index tokenCount = 0;
+        while (lexer.lexToken().type != TokenType::EndOfFile)
+            tokenCount++;
+        auto time = platform::PerformanceCounter::getElapsedTimeInSeconds(start);
+        getTestReporter()->addExecutionTime(time);
+
+        SLANG_CHECK(tokenCount == (SLANG_COUNT_OF(kLexerScanTokens) - 1) * kRepeatCount);
+        SLANG_CHECK(sink.getErrorCount() == 0);
+    }
+}
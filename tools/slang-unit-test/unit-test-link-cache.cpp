@@ -0,0 +1,135 @@
+// unit-test-link-cache.cpp
+
+#include "core/slang-basic.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that the symbol resolutions `linkIR` shares between the links of one program for one
+// target don't change the code generated for an entry point, whichever entry point is linked
+// first. The entry points call a function that has a definition for each of several targets, so
+// the links also share the choice of the best definition.
+
+namespace
+{
+
+static const char* kLinkCacheSource = R"(
+    RWStructuredBuffer<float> gOutput;
+
+    __specialized_for_target(hlsl)
+    float pick(float x) { return x * 2.5; }
+
+    __specialized_for_target(glsl)
+    float pick(float x) { return x * 7.25; }
+
+    float scaled(float x) { return pick(x) + 1.0; }
+
+    [shader("compute")]
+    [numthreads(1, 1, 1)]
+    void first() { gOutput[0] = scaled(gOutput[0]); }
+
+    [shader("compute")]
+    [numthreads(1, 1, 1)]
+    void second() { gOutput[1] = scaled(gOutput[1]) * scaled(gOutput[2]); }
+
+    [shader("compute")]
+    [numthreads(1, 1, 1)]
+    void third() { gOutput[3] = pick(gOutput[3]); }
+    )";
+
+static const char* kLinkCacheEntryPointNames[] = {"first", "second", "third"};
+static const int kLinkCacheEntryPointCount = SLANG_COUNT_OF(kLinkCacheEntryPointNames);
+
+// Link all the entry points into one program, and get the code for each of them in the order
+// given by `entryPointOrder`.
+static SlangResult _compile(
+    slang::IGlobalSession* globalSession,
+    const int* entryPointOrder,
+    ComPtr<slang::IBlob>* outCode)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(globalSession->createSession(sessionDesc, session.writeRef()));
+
+    ComPtr<slang::IBlob> diagnostics;
+    ComPtr<slang::IModule> module(session->loadModuleFromSourceString(
+        "linkCache",
+        "linkCache.slang",
+        kLinkCacheSource,
+        diagnostics.writeRef()));
+    if (!module)
+        return SLANG_FAIL;
+
+    List<ComPtr<slang::IEntryPoint>> entryPoints;
+    List<slang::IComponentType*> componentTypes;
+    componentTypes.add(module);
+    for (auto name : kLinkCacheEntryPointNames)
+    {
+        ComPtr<slang::IEntryPoint> entryPoint;
+        SLANG_RETURN_ON_FAIL(module->findEntryPointByName(name, entryPoint.writeRef()));
+        componentTypes.add(entryPoint);
+        entryPoints.add(entryPoint);
+    }
+
+    ComPtr<slang::IComponentType> program;
+    SLANG_RETURN_ON_FAIL(session->createCompositeComponentType(
+        componentTypes.getBuffer(),
+        componentTypes.getCount(),
+        program.writeRef(),
+        diagnostics.writeRef()));
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    SLANG_RETURN_ON_FAIL(program->link(linkedProgram.writeRef(), diagnostics.writeRef()));
+
+    for (int i = 0; i < kLinkCacheEntryPointCount; ++i)
+    {
+        const int entryPointIndex = entryPointOrder[i];
+        SLANG_RETURN_ON_FAIL(linkedProgram->getEntryPointCode(
+            entryPointIndex,
+            0,
+            outCode[entryPointIndex].writeRef(),
+            diagnostics.writeRef()));
+    }
+    return SLANG_OK;
+}
+
+static bool _isSameCode(slang::IBlob* a, slang::IBlob* b)
+{
+    return a->getBufferSize() == b->getBufferSize() &&
+           memcmp(a->getBufferPointer(), b->getBufferPointer(), a->getBufferSize()) == 0;
+}
+
+} // namespace
+
+SLANG_UNIT_TEST(linkCache)
+{
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    const int forwardOrder[] = {0, 1, 2};
+    ComPtr<slang::IBlob> forwardCode[kLinkCacheEntryPointCount];
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compile(globalSession, forwardOrder, forwardCode)));
+
+    const int reverseOrder[] = {2, 1, 0};
+    ComPtr<slang::IBlob> reverseCode[kLinkCacheEntryPointCount];
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compile(globalSession, reverseOrder, reverseCode)));
+
+    for (int i = 0; i < kLinkCacheEntryPointCount; ++i)
+        SLANG_CHECK(_isSameCode(forwardCode[i], reverseCode[i]));
+
+    // Every entry point uses the HLSL definition of `pick`.
+    for (auto& code : forwardCode)
+    {
+        UnownedStringSlice text((const char*)code->getBufferPointer(), code->getBufferSize());
+        SLANG_CHECK(text.indexOf(toSlice("2.5")) >= 0);
+        SLANG_CHECK(text.indexOf(toSlice("7.25")) < 0);
+    }
+}
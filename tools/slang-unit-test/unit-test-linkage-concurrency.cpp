@@ -0,0 +1,163 @@
+// unit-test-linkage-concurrency.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "slang/slang-session.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace Slang;
+
+// Test that composing and linking component types proceed while another thread is in the middle of
+// a specialization or layout, which hold the linkage's component type operation mutex, and that
+// specialization still waits for it.
+
+namespace
+{
+
+struct ThreadDone
+{
+    void set()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isDone = true;
+        condition.notify_all();
+    }
+
+    bool waitFor(std::chrono::seconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        return condition.wait_for(lock, timeout, [&]() { return isDone; });
+    }
+
+    bool get()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return isDone;
+    }
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool isDone = false;
+};
+
+} // namespace
+
+SLANG_UNIT_TEST(linkageConcurrentComposeAndLink)
+{
+    const char* source = R"(
+        RWStructuredBuffer<int> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(x, 1, 1)]
+        void computeMain<int x>(uint3 tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid.x] = x;
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnostics;
+    ComPtr<slang::IModule> module(
+        session->loadModuleFromSourceString("m", "m.slang", source, diagnostics.writeRef()));
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(module->findAndCheckEntryPoint(
+        "computeMain",
+        SLANG_STAGE_COMPUTE,
+        entryPoint.writeRef(),
+        diagnostics.writeRef())));
+
+    slang::SpecializationArg arg = slang::SpecializationArg::fromExpr("4");
+    ComPtr<slang::IComponentType> specializedEntryPoint;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        entryPoint->specialize(&arg, 1, specializedEntryPoint.writeRef(), diagnostics.writeRef())));
+
+    ComPtr<Linkage> linkage;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        session->queryInterface(Linkage::getTypeGuid(), (void**)linkage.writeRef())));
+
+    SlangResult composeResult = SLANG_FAIL;
+    SlangResult linkResult = SLANG_FAIL;
+    ComPtr<slang::IComponentType> linkedProgram;
+    ThreadDone linkDone;
+
+    SlangResult specializeResult = SLANG_FAIL;
+    ComPtr<slang::IComponentType> otherSpecializedEntryPoint;
+    ThreadDone specializeDone;
+
+    std::thread linkThread;
+    std::thread specializeThread;
+    {
+        // Stands in for a specialization or layout running on another thread.
+        std::lock_guard<std::recursive_mutex> lock(linkage->getComponentTypeOperationMutex());
+
+        linkThread = std::thread(
+            [&]()
+            {
+                ComPtr<slang::IBlob> threadDiagnostics;
+                slang::IComponentType* componentTypes[] = {module, specializedEntryPoint};
+                ComPtr<slang::IComponentType> composedProgram;
+                composeResult = session->createCompositeComponentType(
+                    componentTypes,
+                    SLANG_COUNT_OF(componentTypes),
+                    composedProgram.writeRef(),
+                    threadDiagnostics.writeRef());
+                if (SLANG_SUCCEEDED(composeResult))
+                {
+                    linkResult = composedProgram->link(
+                        linkedProgram.writeRef(),
+                        threadDiagnostics.writeRef());
+                }
+                linkDone.set();
+            });
+
+        specializeThread = std::thread(
+            [&]()
+            {
+                ComPtr<slang::IBlob> threadDiagnostics;
+                slang::SpecializationArg otherArg = slang::SpecializationArg::fromExpr("8");
+                specializeResult = entryPoint->specialize(
+                    &otherArg,
+                    1,
+                    otherSpecializedEntryPoint.writeRef(),
+                    threadDiagnostics.writeRef());
+                specializeDone.set();
+            });
+
+        // The timeout only bounds a failing run; a passing run finishes as soon as the link does.
+        SLANG_CHECK(linkDone.waitFor(std::chrono::seconds(60)));
+        SLANG_CHECK(!specializeDone.get());
+    }
+
+    linkThread.join();
+    specializeThread.join();
+
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(composeResult));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(linkResult));
+    SLANG_CHECK(SLANG_SUCCEEDED(specializeResult));
+
+    // The program linked while the mutex was held is complete.
+    ComPtr<slang::IBlob> code;
+    SLANG_CHECK(SLANG_SUCCEEDED(
+        linkedProgram->getEntryPointCode(0, 0, code.writeRef(), diagnostics.writeRef())));
+    SLANG_CHECK(code && code->getBufferSize() != 0);
+}
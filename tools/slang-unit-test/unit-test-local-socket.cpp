@@ -0,0 +1,76 @@
+// unit-test-local-socket.cpp
+
+#include "core/slang-http.h"
+#include "core/slang-io.h"
+#include "core/slang-local-socket.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+static RefPtr<HTTPPacketConnection> _createPacketConnection(Stream* stream)
+{
+    RefPtr<BufferedReadStream> readStream(new BufferedReadStream(stream));
+    return new HTTPPacketConnection(readStream, stream);
+}
+
+static bool _isContent(HTTPPacketConnection* connection, const UnownedStringSlice& expected)
+{
+    if (!connection->hasContent())
+    {
+        return false;
+    }
+    auto content = connection->getContent();
+    return UnownedStringSlice((const char*)content.begin(), content.getCount()) == expected;
+}
+
+SLANG_UNIT_TEST(localSocket)
+{
+    // Listening replaces whatever file is left at the path, which is what happens to the socket of
+    // a server that was killed.
+    String socketPath;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(File::generateTemporary(toSlice("slang-local-socket"), socketPath)));
+
+    RefPtr<LocalSocketListener> listener;
+    const SlangResult listenResult = LocalSocket::listen(socketPath, listener);
+    if (listenResult == SLANG_E_NOT_AVAILABLE)
+    {
+        File::remove(socketPath);
+        SLANG_IGNORE_TEST
+    }
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(listenResult));
+
+    RefPtr<Stream> clientStream;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(LocalSocket::connect(socketPath, clientStream)));
+    RefPtr<Stream> serverStream;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(listener->accept(serverStream)));
+
+    auto client = _createPacketConnection(clientStream);
+    auto server = _createPacketConnection(serverStream);
+
+    SLANG_CHECK(SLANG_SUCCEEDED(client->write("ping", 4)));
+    SLANG_CHECK(SLANG_SUCCEEDED(server->waitForResult()));
+    SLANG_CHECK(_isContent(server, toSlice("ping")));
+    server->consumeContent();
+
+    SLANG_CHECK(SLANG_SUCCEEDED(server->write("pong", 4)));
+    SLANG_CHECK(SLANG_SUCCEEDED(client->waitForResult()));
+    SLANG_CHECK(_isContent(client, toSlice("pong")));
+    client->consumeContent();
+
+    // The other end sees the connection close, and writing to it fails rather than ending the
+    // process.
+    clientStream->close();
+    server->waitForResult();
+    SLANG_CHECK(server->getReadState() == HTTPPacketConnection::ReadState::Closed);
+    SLANG_CHECK(SLANG_FAILED(server->write("late", 4)));
+
+    // A path that is still being listened on can't be taken over.
+    RefPtr<LocalSocketListener> otherListener;
+    SLANG_CHECK(SLANG_FAILED(LocalSocket::listen(socketPath, otherListener)));
+
+    // Destroying the listener removes the socket, so nothing can connect to it.
+    listener.setNull();
+    SLANG_CHECK(!File::exists(socketPath));
+    SLANG_CHECK(SLANG_FAILED(LocalSocket::connect(socketPath, clientStream)));
+}
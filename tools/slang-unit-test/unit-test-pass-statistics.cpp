@@ -0,0 +1,145 @@
+// unit-test-pass-statistics.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that `CompilerOptionName::ReportPassStatistics` makes the target metadata report one
+// entry per IR pass run, and that the metadata is empty without the option. Direct SPIR-V output
+// also reports the memory used by the emitter.
+
+static const char* kPassStatisticsSource = R"(
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void computeMain(uint tid : SV_DispatchThreadID, uniform RWStructuredBuffer<float> output)
+    {
+        float sum = 0;
+        for (int i = 0; i < 4; i++)
+            sum += output[tid + i];
+        output[tid] = sum;
+    }
+    )";
+
+static ComPtr<slang::IPassStatisticsMetadata> _compileAndGetPassStatistics(
+    slang::IGlobalSession* globalSession,
+    bool reportPassStatistics,
+    SlangCompileTarget format = SLANG_HLSL)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = format;
+    targetDesc.profile =
+        globalSession->findProfile(format == SLANG_SPIRV ? "spirv_1_5" : "sm_5_0");
+
+    slang::CompilerOptionEntry compilerOption = {};
+    compilerOption.name = slang::CompilerOptionName::ReportPassStatistics;
+    compilerOption.value.kind = slang::CompilerOptionValueKind::Int;
+    compilerOption.value.intValue0 = reportPassStatistics ? 1 : 0;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.compilerOptionEntries = &compilerOption;
+    sessionDesc.compilerOptionEntryCount = 1;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK(SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+    if (!session)
+        return nullptr;
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto module = session->loadModuleFromSourceString(
+        "passStatistics",
+        "passStatistics.slang",
+        kPassStatisticsSource,
+        diagnostics.writeRef());
+    SLANG_CHECK(module != nullptr);
+    if (!module)
+        return nullptr;
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_CHECK(
+        SLANG_SUCCEEDED(module->findEntryPointByName("computeMain", entryPoint.writeRef())));
+    if (!entryPoint)
+        return nullptr;
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composite;
+    ComPtr<slang::IComponentType> linkedProgram;
+    SLANG_CHECK(SLANG_SUCCEEDED(session->createCompositeComponentType(
+        components,
+        2,
+        composite.writeRef(),
+        diagnostics.writeRef())));
+    SLANG_CHECK(
+        SLANG_SUCCEEDED(composite->link(linkedProgram.writeRef(), diagnostics.writeRef())));
+    if (!linkedProgram)
+        return nullptr;
+
+    ComPtr<slang::IMetadata> metadata;
+    SLANG_CHECK(SLANG_SUCCEEDED(linkedProgram->getEntryPointMetadata(
+        0,
+        0,
+        metadata.writeRef(),
+        diagnostics.writeRef())));
+    if (!metadata)
+        return nullptr;
+
+    ComPtr<slang::IPassStatisticsMetadata> statistics(
+        (slang::IPassStatisticsMetadata*)metadata->castAs(
+            slang::IPassStatisticsMetadata::getTypeGuid()));
+    return statistics;
+}
+
+SLANG_UNIT_TEST(passStatistics)
+{
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    {
+        auto statistics = _compileAndGetPassStatistics(globalSession, false);
+        SLANG_CHECK_ABORT(statistics);
+        SLANG_CHECK(statistics->getPassStatisticsCount() == 0);
+    }
+
+    auto statistics = _compileAndGetPassStatistics(globalSession, true);
+    SLANG_CHECK_ABORT(statistics);
+
+    const SlangUInt passCount = statistics->getPassStatisticsCount();
+    SLANG_CHECK(passCount > 0);
+
+    bool anyPassCreatedInsts = false;
+    for (SlangUInt i = 0; i < passCount; ++i)
+    {
+        slang::PassStatistics pass;
+        SLANG_CHECK(SLANG_SUCCEEDED(statistics->getPassStatisticsByIndex(i, &pass)));
+        SLANG_CHECK(pass.passName != nullptr);
+        SLANG_CHECK(pass.instCountBefore != 0 && pass.instCountAfter != 0);
+
+        // The counts must be consistent with the instructions the pass created and removed,
+        // since every instruction in the module was allocated in it.
+        SLANG_CHECK(pass.instCountAfter <= pass.instCountBefore + pass.instsCreated);
+        anyPassCreatedInsts = anyPassCreatedInsts || pass.instsCreated != 0;
+    }
+    SLANG_CHECK(anyPassCreatedInsts);
+
+    slang::PassStatistics outOfRange;
+    SLANG_CHECK(SLANG_FAILED(statistics->getPassStatisticsByIndex(passCount, &outOfRange)));
+}
+
+SLANG_UNIT_TEST(passStatisticsSPIRVEmitter)
+{
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    auto statistics = _compileAndGetPassStatistics(globalSession, true, SLANG_SPIRV);
+    SLANG_CHECK_ABORT(statistics);
+
+    const SlangUInt passCount = statistics->getPassStatisticsCount();
+    SLANG_CHECK_ABORT(passCount > 0);
+
+    // The emitter runs after every IR pass, and its memory includes at least the output.
+    slang::PassStatistics emitter;
+    SLANG_CHECK(SLANG_SUCCEEDED(statistics->getPassStatisticsByIndex(passCount - 1, &emitter)));
+    SLANG_CHECK(UnownedStringSlice(emitter.passName) == toSlice("emitSPIRV"));
+    SLANG_CHECK(emitter.bytesAllocated > 5 * sizeof(uint32_t));
+}
@@ -0,0 +1,50 @@
+// unit-test-perf-trace.cpp
+
+#include "core/slang-performance-profiler.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that `PerformanceTracer` records profiled sections as Chrome Trace Event "complete"
+// events tagged with the enclosing trace context, and records nothing when not acquired.
+
+SLANG_UNIT_TEST(perfTrace)
+{
+    auto tracer = PerformanceTracer::getTracer();
+
+    {
+        PerformanceTraceContextRAII moduleContext("module", "untraced");
+        SLANG_PROFILE_SECTION(untracedSection);
+    }
+
+    tracer->acquire();
+    SLANG_CHECK(tracer->isEnabled());
+    {
+        PerformanceTraceContextRAII moduleContext("module", "outer");
+        SLANG_PROFILE_SECTION(outerSection);
+        {
+            PerformanceTraceContextRAII entryPointContext("entryPoint", "main\"quoted\"");
+            PerformanceTraceContextRAII innerModuleContext("module", "inner");
+            SLANG_PROFILE_SECTION(innerSection);
+        }
+    }
+
+    StringBuilder json;
+    tracer->writeJSON(json);
+    tracer->release();
+    SLANG_CHECK(!tracer->isEnabled());
+
+    auto text = json.getUnownedSlice();
+    SLANG_CHECK(text.indexOf(UnownedStringSlice("\"traceEvents\"")) >= 0);
+    SLANG_CHECK(text.indexOf(UnownedStringSlice("\"ph\":\"X\"")) >= 0);
+    SLANG_CHECK(text.indexOf(UnownedStringSlice("untracedSection")) < 0);
+    SLANG_CHECK(
+        text.indexOf(UnownedStringSlice(
+            "\"name\":\"outerSection\",\"cat\":\"slang\",\"ph\":\"X\",\"pid\":1")) >= 0);
+    SLANG_CHECK(text.indexOf(UnownedStringSlice("\"args\":{\"module\":\"outer\"}")) >= 0);
+
+    // The innermost context for a key wins, and values are JSON-escaped.
+    SLANG_CHECK(
+        text.indexOf(UnownedStringSlice(
+            "\"args\":{\"module\":\"inner\",\"entryPoint\":\"main\\\"quoted\\\"\"}")) >= 0);
+}
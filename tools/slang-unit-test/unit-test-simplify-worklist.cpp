@@ -0,0 +1,135 @@
+// unit-test-simplify-worklist.cpp
+
+#include "core/slang-io.h"
+#include "core/slang-process-util.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that the IR simplification passes, which after their first round only revisit functions
+// that may have changed, generate the same code as when they revisit every function in every
+// round with `-simplify-revisit-all-functions`, and that they revisit fewer functions.
+
+namespace
+{
+
+static const char kSimplifyWorklistSource[] = R"(
+    static const int kScale = 3;
+
+    int scaled(int x) { return x * kScale; }
+    int offset(int x) { return x + kScale - 1; }
+    int square(int x) { return x * x; }
+    int clampToByte(int x) { return min(max(x, 0), 255); }
+
+    int sumTo(int n)
+    {
+        int sum = 0;
+        for (int i = 0; i < n; i++)
+            sum += scaled(i);
+        return sum;
+    }
+
+    float blend(float a, float b, bool useA)
+    {
+        float result = b;
+        if (useA)
+            result = a;
+        return result * (kScale - 2);
+    }
+
+    int pick(int x)
+    {
+        switch (x & 3)
+        {
+        case 0: return scaled(x);
+        case 1: return sumTo(4) + offset(x);
+        case 2: return clampToByte(square(x));
+        default: return x - kScale;
+        }
+    }
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void computeMain(uint tid : SV_DispatchThreadID, uniform RWStructuredBuffer<float> output)
+    {
+        int value = pick(int(tid)) + sumTo(int(tid)) + square(offset(int(tid)));
+        output[tid] = blend(float(value), output[tid], (tid & 1) == 0);
+    }
+    )";
+
+static SlangResult _compile(
+    UnitTestContext* context,
+    const String& sourcePath,
+    bool revisitAllFunctions,
+    ExecuteResult& outResult)
+{
+    CommandLine cmdLine;
+    ExecutableLocation slangcLocation(context->executableDirectory, "slangc");
+    cmdLine.setExecutableLocation(slangcLocation);
+    cmdLine.addArg(sourcePath);
+    cmdLine.addArg("-target");
+    cmdLine.addArg("hlsl");
+    cmdLine.addArg("-entry");
+    cmdLine.addArg("computeMain");
+    cmdLine.addArg("-stage");
+    cmdLine.addArg("compute");
+    cmdLine.addArg("-report-perf-benchmark");
+    if (revisitAllFunctions)
+        cmdLine.addArg("-simplify-revisit-all-functions");
+    return ProcessUtil::execute(cmdLine, outResult);
+}
+
+/// Get how many times the function-local simplification passes were run on a function, from the
+/// output of `-report-perf-benchmark`. Returns -1 if it isn't there.
+static Index _getSimplifiedFuncCount(const String& benchmark)
+{
+    const UnownedStringSlice name = toSlice("_simplifyFuncToFixedPoint");
+    const auto text = benchmark.getUnownedSlice();
+    const Index nameIndex = text.indexOf(name);
+    if (nameIndex < 0)
+        return -1;
+
+    // The name is followed by whitespace and then the invocation count.
+    const char* cursor = text.begin() + nameIndex + name.getLength();
+    while (cursor < text.end() && (*cursor == ' ' || *cursor == '\t'))
+        cursor++;
+    if (cursor == text.end() || *cursor < '0' || *cursor > '9')
+        return -1;
+
+    Index count = 0;
+    for (; cursor < text.end() && *cursor >= '0' && *cursor <= '9'; cursor++)
+        count = count * 10 + (*cursor - '0');
+    return count;
+}
+
+} // namespace
+
+SLANG_UNIT_TEST(simplifyWorklist)
+{
+    String tempPath;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(File::generateTemporary(toSlice("slang-simplify-worklist"), tempPath)));
+    const String sourcePath = tempPath + ".slang";
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(sourcePath, kSimplifyWorklistSource)));
+
+    ExecuteResult worklistResult;
+    SLANG_CHECK(SLANG_SUCCEEDED(_compile(unitTestContext, sourcePath, false, worklistResult)));
+
+    ExecuteResult revisitAllResult;
+    SLANG_CHECK(SLANG_SUCCEEDED(_compile(unitTestContext, sourcePath, true, revisitAllResult)));
+
+    File::remove(sourcePath);
+    File::remove(tempPath);
+
+    SLANG_CHECK_ABORT(worklistResult.resultCode == 0);
+    SLANG_CHECK_ABORT(revisitAllResult.resultCode == 0);
+
+    // Skipping functions at a fixed point doesn't change the generated code.
+    SLANG_CHECK(worklistResult.standardOutput.getLength() != 0);
+    SLANG_CHECK(worklistResult.standardOutput == revisitAllResult.standardOutput);
+
+    const Index worklistCount = _getSimplifiedFuncCount(worklistResult.standardError);
+    const Index revisitAllCount = _getSimplifiedFuncCount(revisitAllResult.standardError);
+    SLANG_CHECK(worklistCount > 0);
+    SLANG_CHECK(worklistCount < revisitAllCount);
+}
@@ -1383,6 +1383,20 @@ SLANG_UNIT_TEST(slangVMAllowsNopWithUnusedOperand)
     SLANG_CHECK(runner->execute(nullptr, 0) == SLANG_OK);
 }
 
+SLANG_UNIT_TEST(slangVMRejectsRunningPastFunctionEnd)
+{
+    List<uint8_t> constants;
+    appendVMTestMainString(constants);
+
+    // Without a trailing `Ret` or `Jump`, execution would continue past the only instruction.
+    List<VMOperand> noOperands;
+    List<uint8_t> instCode;
+    appendVMTestInst(instCode, VMOp::Nop, 0, noOperands.getArrayView());
+
+    auto blob = createVMTestBlob(instCode, 8, 0, constants);
+    expectVMExecuteFails(blob);
+}
+
 SLANG_UNIT_TEST(slangVMAllowsVoidRetWithUnusedOperand)
 {
     List<uint8_t> constants;
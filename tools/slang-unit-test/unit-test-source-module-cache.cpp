@@ -0,0 +1,156 @@
+// unit-test-source-module-cache.cpp
+
+#include "core/slang-file-system.h"
+#include "core/slang-io.h"
+#include "core/slang-process.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that with `CompilerOptionName::CompilationCacheDirectory` set, an imported source module is
+// kept in the cache and loaded from it by later sessions, and that changing a file it includes
+// makes the next session check it from source again.
+//
+// The module has a `#warning`, which is only reported when the module is checked from source.
+
+namespace
+{
+
+static const char* kCachedUtilSource = R"(
+    #include "cached-util-value.h"
+    #warning checking cachedUtil
+    public float utilValue() { return UTIL_VALUE; }
+    )";
+
+static const char* kImportingSource = R"(
+    import cachedUtil;
+
+    [shader("compute")]
+    [numthreads(1, 1, 1)]
+    void computeMain(uniform RWStructuredBuffer<float> output)
+    {
+        output[0] = utilValue();
+    }
+    )";
+
+struct ImportResult
+{
+    bool succeeded = false;
+    bool checkedFromSource = false;
+    bool hasExtraFunction = false;
+};
+
+static ImportResult _importCachedUtil(
+    slang::IGlobalSession* globalSession,
+    const String& cacheDirectory,
+    const String& moduleDirectory)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::CompilerOptionEntry compilerOption = {};
+    compilerOption.name = slang::CompilerOptionName::CompilationCacheDirectory;
+    compilerOption.value.kind = slang::CompilerOptionValueKind::String;
+    compilerOption.value.stringValue0 = cacheDirectory.getBuffer();
+
+    const char* searchPaths[] = {moduleDirectory.getBuffer()};
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.compilerOptionEntries = &compilerOption;
+    sessionDesc.compilerOptionEntryCount = 1;
+    sessionDesc.searchPaths = searchPaths;
+    sessionDesc.searchPathCount = 1;
+
+    ImportResult result;
+
+    ComPtr<slang::ISession> session;
+    if (SLANG_FAILED(globalSession->createSession(sessionDesc, session.writeRef())))
+        return result;
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto module = session->loadModuleFromSourceString(
+        "importing",
+        "importing.slang",
+        kImportingSource,
+        diagnostics.writeRef());
+    if (!module)
+        return result;
+
+    ComPtr<slang::IBlob> utilDiagnostics;
+    auto utilModule = session->loadModule("cachedUtil", utilDiagnostics.writeRef());
+    if (!utilModule)
+        return result;
+
+    result.succeeded = true;
+    if (diagnostics)
+    {
+        UnownedStringSlice diagnosticText(
+            (const char*)diagnostics->getBufferPointer(),
+            diagnostics->getBufferSize());
+        result.checkedFromSource = diagnosticText.indexOf(toSlice("checking cachedUtil")) >= 0;
+    }
+    result.hasExtraFunction = utilModule->getLayout()->findFunctionByName("utilExtra") != nullptr;
+    return result;
+}
+
+static void _removeDirectory(const String& directory)
+{
+    auto fileSystem = OSFileSystem::getMutableSingleton();
+    List<String> fileNames;
+    fileSystem->enumeratePathContents(
+        directory.getBuffer(),
+        [](SlangPathType, const char* fileName, void* userData)
+        { static_cast<List<String>*>(userData)->add(fileName); },
+        &fileNames);
+    for (const auto& fileName : fileNames)
+        fileSystem->remove((directory + "/" + fileName).getBuffer());
+    fileSystem->remove(directory.getBuffer());
+}
+
+} // namespace
+
+SLANG_UNIT_TEST(sourceModuleCache)
+{
+    const String testDirectory = Path::simplify(
+        Path::getParentDirectory(Path::getExecutablePath()) + "/source-module-cache-test" +
+        String(Process::getId()));
+    const String cacheDirectory = testDirectory + "-cache";
+    _removeDirectory(testDirectory);
+    _removeDirectory(cacheDirectory);
+
+    SLANG_CHECK_ABORT(Path::createDirectory(testDirectory));
+    const String headerPath = Path::combine(testDirectory, "cached-util-value.h");
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        File::writeAllText(Path::combine(testDirectory, "cachedUtil.slang"), kCachedUtilSource)));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(headerPath, "#define UTIL_VALUE 2.0\n")));
+
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    // The first session checks the module and populates the cache.
+    auto first = _importCachedUtil(globalSession, cacheDirectory, testDirectory);
+    SLANG_CHECK(first.succeeded);
+    SLANG_CHECK(first.checkedFromSource);
+
+    // A later session with the same files loads it from the cache.
+    auto second = _importCachedUtil(globalSession, cacheDirectory, testDirectory);
+    SLANG_CHECK(second.succeeded);
+    SLANG_CHECK(!second.checkedFromSource);
+    SLANG_CHECK(!second.hasExtraFunction);
+
+    // Changing only the included file still invalidates the cached module.
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(
+        headerPath,
+        "#define UTIL_VALUE 3.0\npublic float utilExtra() { return 1.0; }\n")));
+    auto third = _importCachedUtil(globalSession, cacheDirectory, testDirectory);
+    SLANG_CHECK(third.succeeded);
+    SLANG_CHECK(third.checkedFromSource);
+    SLANG_CHECK(third.hasExtraFunction);
+
+    _removeDirectory(testDirectory);
+    _removeDirectory(cacheDirectory);
+}
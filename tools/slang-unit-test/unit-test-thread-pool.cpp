@@ -0,0 +1,105 @@
+// unit-test-thread-pool.cpp
+
+#include "core/slang-thread-pool.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+using namespace Slang;
+
+// Test that `ThreadPool::parallelFor` runs every iteration once, and that loops started on the
+// same pool from several threads at once take turns rather than sharing the workers.
+
+SLANG_UNIT_TEST(threadPoolParallelFor)
+{
+    static const Index kIterationCount = 1000;
+    static const int kCallerCount = 4;
+    static const int kLoopsPerCaller = 20;
+
+    RefPtr<ThreadPool> threadPool = new ThreadPool(4);
+
+    std::atomic<int> activeLoopCount{0};
+    std::atomic<bool> overlapped{false};
+    std::atomic<bool> miscounted{false};
+
+    std::thread callers[kCallerCount];
+    for (auto& caller : callers)
+    {
+        caller = std::thread(
+            [&]()
+            {
+                for (int loop = 0; loop < kLoopsPerCaller; ++loop)
+                {
+                    std::atomic<int> visitCounts[kIterationCount];
+                    for (auto& visitCount : visitCounts)
+                        visitCount = 0;
+
+                    // The loop is active from when its first iteration starts until its last
+                    // iteration finishes.
+                    std::atomic<Index> startedCount{0};
+                    std::atomic<Index> finishedCount{0};
+
+                    threadPool->parallelFor(
+                        kIterationCount,
+                        [&](Index index)
+                        {
+                            if (startedCount.fetch_add(1) == 0 &&
+                                activeLoopCount.fetch_add(1) != 0)
+                                overlapped = true;
+                            visitCounts[index]++;
+                            if (finishedCount.fetch_add(1) == kIterationCount - 1)
+                                activeLoopCount.fetch_sub(1);
+                        });
+
+                    for (auto& visitCount : visitCounts)
+                    {
+                        if (visitCount != 1)
+                            miscounted = true;
+                    }
+                }
+            });
+    }
+
+    for (auto& caller : callers)
+        caller.join();
+
+    SLANG_CHECK(!overlapped);
+    SLANG_CHECK(!miscounted);
+}
+
+// Test that a loop given a `maxThreadCount` runs on no more threads than that, so a pool shared
+// by compiles can serve one that asked for fewer threads than the pool has.
+
+SLANG_UNIT_TEST(threadPoolMaxThreadCount)
+{
+    static const Index kIterationCount = 64;
+
+    RefPtr<ThreadPool> threadPool = new ThreadPool(4);
+
+    for (Index maxThreadCount = 1; maxThreadCount <= 4; ++maxThreadCount)
+    {
+        std::mutex mutex;
+        List<std::thread::id> threadIds;
+        std::atomic<Index> visitedCount{0};
+
+        threadPool->parallelFor(
+            kIterationCount,
+            [&](Index)
+            {
+                // Hold each iteration a little so that every thread allowed in gets a turn.
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                visitedCount++;
+
+                std::lock_guard<std::mutex> lock(mutex);
+                if (threadIds.indexOf(std::this_thread::get_id()) < 0)
+                    threadIds.add(std::this_thread::get_id());
+            },
+            maxThreadCount);
+
+        SLANG_CHECK(visitedCount == kIterationCount);
+        SLANG_CHECK(threadIds.getCount() <= maxThreadCount);
+    }
+}